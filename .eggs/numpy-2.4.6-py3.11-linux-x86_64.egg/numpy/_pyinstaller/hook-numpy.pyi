@@ -0,0 +1,6 @@
+from typing import Final
+
+binaries: Final[list[tuple[str, str]]] = ...
+
+hiddenimports: Final[list[str]] = ...
+excludedimports: Final[list[str]] = ...
@@ -0,0 +1,5 @@
+      REAL*8 FUNCTION FUNCFORTRANNAME(A,B)
+      REAL*8 A, B
+      FUNCFORTRANNAME = A + B
+      RETURN
+      END FUNCTION
@@ -0,0 +1,4 @@
+      SUBROUTINE SUBROUT(A,B,C)
+      REAL*8 A, B, C
+      C = A + B
+      END SUBROUTINE
@@ -0,0 +1,17 @@
+from io import StringIO
+from typing import assert_type
+
+import numpy as np
+import numpy.lib.array_utils as array_utils
+import numpy.typing as npt
+
+AR: npt.NDArray[np.float64]
+AR_DICT: dict[str, npt.NDArray[np.float64]]
+FILE: StringIO
+
+def func(a: int) -> bool: ...
+
+assert_type(array_utils.byte_bounds(AR), tuple[int, int])
+assert_type(array_utils.byte_bounds(np.float64()), tuple[int, int])
+
+assert_type(np.info(1, output=FILE), None)
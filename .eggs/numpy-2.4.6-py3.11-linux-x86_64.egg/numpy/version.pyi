@@ -0,0 +1,9 @@
+from typing import Final, LiteralString
+
+version: Final[LiteralString] = ...
+__version__: Final[LiteralString] = ...
+full_version: Final[LiteralString] = ...
+
+git_revision: Final[LiteralString] = ...
+release: Final[bool] = ...
+short_version: Final[LiteralString] = ...
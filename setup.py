@@ -66,7 +66,19 @@ elif is_windows:
 
 include_dirs.append('src/pyvcam')
 sources.append('src/pyvcam/pvcmodule.cpp')
-# depends.append('src/pyvcam/some_header.h')
+depends.append('src/pyvcam/acq_buffer.h')
+depends.append('src/pyvcam/bitpack.h')
+depends.append('src/pyvcam/dlpack.h')
+depends.append('src/pyvcam/frame_handler.h')
+depends.append('src/pyvcam/frame_ring.h')
+depends.append('src/pyvcam/frame_slots.h')
+depends.append('src/pyvcam/io_uring_writer.h')
+depends.append('src/pyvcam/param_cache.h')
+depends.append('src/pyvcam/particles.h')
+depends.append('src/pyvcam/recompose.h')
+depends.append('src/pyvcam/stream_file.h')
+depends.append('src/pyvcam/stream_writer.h')
+depends.append('src/pyvcam/task_thread.h')
 
 ext_modules = [
     Extension(
@@ -1 +1,3 @@
 __version__ = '2.3.2'
+
+from pyvcam.stream_file import StreamFile  # noqa: E402,F401
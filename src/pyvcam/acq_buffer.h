@@ -0,0 +1,388 @@
+#ifndef PYVCAM_ACQ_BUFFER_H
+#define PYVCAM_ACQ_BUFFER_H
+
+// System
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <new>
+
+#ifdef _WIN32
+    #include <Windows.h>
+    #include <malloc.h> // _aligned_malloc
+#else
+    #include <stdlib.h> // aligned_alloc
+    #include <sys/mman.h> // mmap, madvise, mlock
+#endif
+
+// Local constants
+
+static constexpr size_t ALIGNMENT_BOUNDARY = 4096;
+
+// Local types
+
+enum class AcqBufferHugePages
+{
+    None,        // Regular 4KiB pages
+    Transparent, // 2MiB aligned mapping advised for transparent huge pages
+    Explicit2M,  // Pages from the 2MiB hugetlbfs pool
+    Explicit1G,  // Pages from the 1GiB hugetlbfs pool
+};
+
+enum class AcqBufferPrefault
+{
+    None,     // Pages are faulted in by PVCAM during the first lap
+    Populate, // Faulted in by the kernel at allocation via MAP_POPULATE
+    Touch,    // Faulted in by writing to every page after allocation
+};
+
+/**
+ * How the acquisition buffer memory is allocated. Unsupported options fall
+ * back to the nearest supported ones, the effective policy is stored in the
+ * buffer.
+ */
+struct AcqBufferPolicy
+{
+    AcqBufferHugePages hugePages{ AcqBufferHugePages::None };
+    AcqBufferPrefault prefault{ AcqBufferPrefault::None };
+    bool lock{ false }; // Keep the pages resident with mlock
+
+    bool operator==(const AcqBufferPolicy& other) const
+    {
+        return hugePages == other.hugePages && prefault == other.prefault
+            && lock == other.lock;
+    }
+    bool operator!=(const AcqBufferPolicy& other) const
+    {
+        return !(*this == other);
+    }
+};
+
+struct AcqBuffer
+{
+    AcqBuffer(size_t size, const AcqBufferPolicy& policy = AcqBufferPolicy(),
+            size_t minCapacity = 0)
+        : size(size), requested(policy)
+    {
+        // Always align frameBuffer on a page boundary.
+        // This is required for non-buffered streaming to disk.
+        // The allocation has one more page after the last whole page of data,
+        // because the last write of each buffer lap is padded up to it.
+        paddedSize = PaddedSize(size);
+        capacity = (std::max)(paddedSize, minCapacity);
+
+#ifndef _WIN32
+        if (policy != AcqBufferPolicy())
+        {
+            Map(policy);
+        }
+        else
+#endif
+        {
+#ifdef _WIN32
+            data = _aligned_malloc(capacity, ALIGNMENT_BOUNDARY);
+#else
+            data = aligned_alloc(ALIGNMENT_BOUNDARY, capacity);
+#endif
+            if (!data)
+                throw std::bad_alloc();
+            if (policy.prefault != AcqBufferPrefault::None)
+            {
+                Touch(); // Windows has no MAP_POPULATE equivalent for heap memory
+                effective.prefault = AcqBufferPrefault::Touch;
+            }
+#ifdef _WIN32
+            if (policy.lock)
+            {
+                // Limited by the process working set size
+                effective.lock = ::VirtualLock(data, capacity) != FALSE;
+            }
+#endif
+        }
+    }
+
+    AcqBuffer(const AcqBuffer&) = delete;
+    AcqBuffer& operator=(const AcqBuffer&) = delete;
+
+    ~AcqBuffer()
+    {
+#ifdef _WIN32
+        if (effective.lock)
+            ::VirtualUnlock(data, capacity);
+        _aligned_free(data);
+#else
+        if (mappedSize != 0)
+            munmap(data, mappedSize); // Unlocks the pages too
+        else
+            free(data);
+#endif
+    }
+
+    /** Returns bytes needed for given data size incl. one page for lap padding. */
+    static size_t PaddedSize(size_t size)
+    {
+        return (size / ALIGNMENT_BOUNDARY + 1) * ALIGNMENT_BOUNDARY;
+    }
+
+    /** Prepares the buffer for data of another size, it must fit the capacity. */
+    void Resize(size_t newSize)
+    {
+        size = newSize;
+        paddedSize = PaddedSize(newSize);
+    }
+
+    void* data{ NULL };
+    size_t size;
+    size_t paddedSize; // Bytes used by data incl. lap padding, multiple of ALIGNMENT_BOUNDARY
+    size_t capacity; // Allocated bytes, multiple of ALIGNMENT_BOUNDARY
+    AcqBufferPolicy requested;
+    AcqBufferPolicy effective{};
+
+private:
+    /** Writes to every page so none of them faults during acquisition. */
+    void Touch()
+    {
+        volatile uint8_t* bytes = static_cast<uint8_t*>(data);
+        for (size_t offset = 0; offset < capacity; offset += ALIGNMENT_BOUNDARY)
+            bytes[offset] = 0;
+    }
+
+#ifndef _WIN32
+    void Map(const AcqBufferPolicy& policy)
+    {
+        constexpr size_t size2M = (size_t)1 << 21;
+        constexpr size_t size1G = (size_t)1 << 30;
+        const int populate =
+            (policy.prefault == AcqBufferPrefault::Populate) ? MAP_POPULATE : 0;
+
+        // Explicit huge pages need a pool reserved by the administrator,
+        // fall back to transparent ones if the pool is too small
+        AcqBufferHugePages hugePages = policy.hugePages;
+#ifdef MAP_HUGETLB
+        if (hugePages == AcqBufferHugePages::Explicit2M
+                || hugePages == AcqBufferHugePages::Explicit1G)
+        {
+            const bool is1G = hugePages == AcqBufferHugePages::Explicit1G;
+            const size_t pageSize = (is1G) ? size1G : size2M;
+            const int pageShift = (is1G) ? 30 : 21;
+            const size_t bytes = (capacity + pageSize - 1) / pageSize * pageSize;
+            void* addr = mmap(NULL, bytes, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | (pageShift << MAP_HUGE_SHIFT)
+                    | populate, -1, 0);
+            if (addr != MAP_FAILED)
+            {
+                mappedSize = bytes;
+                data = addr;
+            }
+            else
+            {
+                hugePages = AcqBufferHugePages::Transparent;
+            }
+        }
+#else
+        if (hugePages != AcqBufferHugePages::None)
+            hugePages = AcqBufferHugePages::Transparent;
+#endif
+
+        if (mappedSize == 0)
+        {
+            // The transparent huge pages are used only for 2MiB aligned ranges
+            const size_t align =
+                (hugePages == AcqBufferHugePages::Transparent) ? size2M : ALIGNMENT_BOUNDARY;
+            const size_t bytes = (capacity + align - 1) / align * align;
+            const size_t slack = align - ALIGNMENT_BOUNDARY;
+            // Populate only after the advice, otherwise small pages would be used
+            void* addr = mmap(NULL, bytes + slack, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS
+                    | ((hugePages == AcqBufferHugePages::Transparent) ? 0 : populate), -1, 0);
+            if (addr == MAP_FAILED)
+                throw std::bad_alloc();
+            uint8_t* base = static_cast<uint8_t*>(addr);
+            uint8_t* aligned = reinterpret_cast<uint8_t*>(
+                    ((uintptr_t)base + align - 1) / align * align);
+            if (aligned > base)
+                munmap(base, aligned - base);
+            const size_t tail = (base + bytes + slack) - (aligned + bytes);
+            if (tail > 0)
+                munmap(aligned + bytes, tail);
+            mappedSize = bytes;
+            data = aligned;
+
+#ifdef MADV_HUGEPAGE
+            if (hugePages == AcqBufferHugePages::Transparent
+                    && madvise(data, mappedSize, MADV_HUGEPAGE) != 0)
+                hugePages = AcqBufferHugePages::None;
+#else
+            hugePages = AcqBufferHugePages::None;
+#endif
+            if (hugePages == AcqBufferHugePages::Transparent
+                    && policy.prefault == AcqBufferPrefault::Populate)
+            {
+#ifdef MADV_POPULATE_WRITE
+                if (madvise(data, mappedSize, MADV_POPULATE_WRITE) != 0)
+                    Touch();
+#else
+                Touch();
+#endif
+            }
+        }
+        effective.hugePages = hugePages;
+
+        if (policy.prefault == AcqBufferPrefault::Touch)
+            Touch();
+        effective.prefault = policy.prefault;
+
+        // Locking faults in all pages too, it fails if RLIMIT_MEMLOCK is too low
+        if (policy.lock)
+            effective.lock = mlock(data, mappedSize) == 0;
+    }
+
+    size_t mappedSize{ 0 }; // Non-zero if data was mapped by mmap
+#endif
+};
+
+/**
+ * Process-wide cache of acquisition buffers not used anymore.
+ *
+ * Buffers are handed out as shared_ptr that returns the buffer to the pool
+ * instead of freeing it once the last owner, the camera or a NumPy capsule,
+ * drops it. Buffers are allocated with capacity rounded up to a size class,
+ * so a buffer fits also requests slightly smaller or larger than the first
+ * one. Idle buffers over the limit are freed, the least recently used first.
+ */
+class AcqBufferPool
+{
+public:
+    struct Stats
+    {
+        uint64_t hits{ 0 }; // Requests served from the pool
+        uint64_t misses{ 0 }; // Requests that had to allocate
+        size_t residentBytes{ 0 }; // Capacity of idle buffers kept by the pool
+        size_t idleBuffers{ 0 };
+        size_t limitBytes{ 0 };
+    };
+
+    /** The pool is never destroyed, capsules may release buffers at interpreter exit. */
+    static AcqBufferPool& Instance()
+    {
+        static AcqBufferPool* pool = new AcqBufferPool();
+        return *pool;
+    }
+
+    /**
+     * Rounds the size up to one of eight classes between two powers of two,
+     * so at most 1/8 of the capacity is never used.
+     */
+    static size_t SizeClass(size_t bytes)
+    {
+        size_t step = ALIGNMENT_BOUNDARY;
+        while (step * 16 <= bytes)
+            step <<= 1;
+        return (bytes + step - 1) / step * step;
+    }
+
+    /** Returns a buffer for given data size and policy, throws std::bad_alloc. */
+    std::shared_ptr<AcqBuffer> Acquire(size_t size, const AcqBufferPolicy& policy)
+    {
+        const size_t capacity = SizeClass(AcqBuffer::PaddedSize(size));
+
+        AcqBuffer* buffer = NULL;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (auto it = m_idle.begin(); it != m_idle.end(); ++it)
+            {
+                if ((*it)->capacity == capacity && (*it)->requested == policy)
+                {
+                    buffer = it->release();
+                    m_residentBytes -= capacity;
+                    m_idle.erase(it);
+                    break;
+                }
+            }
+            if (buffer)
+                m_hits++;
+            else
+                m_misses++;
+        }
+
+        if (buffer)
+        {
+            buffer->Resize(size);
+        }
+        else
+        {
+            try
+            {
+                buffer = new AcqBuffer(size, policy, capacity);
+            }
+            catch (const std::bad_alloc& /*ex*/)
+            {
+                // Give the memory of idle buffers back and try once more
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    FreeIdle(0);
+                }
+                buffer = new AcqBuffer(size, policy, capacity);
+            }
+        }
+
+        return std::shared_ptr<AcqBuffer>(buffer, [this](AcqBuffer* b) { Release(b); });
+    }
+
+    /** Frees idle buffers over the new limit, zero disables the pool. */
+    void SetLimit(size_t limitBytes)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_limitBytes = limitBytes;
+        FreeIdle(limitBytes);
+    }
+
+    Stats GetStats() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Stats stats;
+        stats.hits = m_hits;
+        stats.misses = m_misses;
+        stats.residentBytes = m_residentBytes;
+        stats.idleBuffers = m_idle.size();
+        stats.limitBytes = m_limitBytes;
+        return stats;
+    }
+
+private:
+    AcqBufferPool() = default;
+
+    void Release(AcqBuffer* buffer)
+    {
+        std::unique_ptr<AcqBuffer> owner(buffer);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (owner->capacity > m_limitBytes)
+            return; // Never fits, freed right away
+        FreeIdle(m_limitBytes - owner->capacity);
+        m_residentBytes += owner->capacity;
+        m_idle.push_front(std::move(owner));
+    }
+
+    /** Frees the least recently used idle buffers until the rest fits, expects the lock. */
+    void FreeIdle(size_t maxResidentBytes)
+    {
+        while (!m_idle.empty() && m_residentBytes > maxResidentBytes)
+        {
+            m_residentBytes -= m_idle.back()->capacity;
+            m_idle.pop_back();
+        }
+    }
+
+    mutable std::mutex m_mutex{};
+    std::list<std::unique_ptr<AcqBuffer>> m_idle{}; // The most recently released first
+    size_t m_residentBytes{ 0 };
+    size_t m_limitBytes{ (size_t)1 << 30 };
+    uint64_t m_hits{ 0 };
+    uint64_t m_misses{ 0 };
+};
+
+#endif // PYVCAM_ACQ_BUFFER_H
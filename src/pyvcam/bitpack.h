@@ -0,0 +1,346 @@
+#ifndef PYVCAM_BITPACK_H
+#define PYVCAM_BITPACK_H
+
+// System
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    #define PYVCAM_BITPACK_X86
+    #include <immintrin.h>
+    #ifdef _MSC_VER
+        #include <intrin.h> // __cpuid, __cpuidex
+        #define PYVCAM_BITPACK_TARGET(isa)
+    #else
+        #define PYVCAM_BITPACK_TARGET(isa) __attribute__((target(isa)))
+    #endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    #define PYVCAM_BITPACK_NEON
+    #include <arm_neon.h>
+#endif
+
+// Unpacking of pixel data compressed with PL_IMAGE_COMPRESSION_BITPACK* modes.
+//
+// The value of each bit-packing mode equals the number of bits per pixel.
+// Pixels are packed back to back into a little-endian bit stream without any
+// padding between lines, i.e. pixel n occupies bits n*N to n*N+N-1 starting
+// with the least significant bit of byte 0. Modes up to 15 bits are unpacked
+// to uint16, 17 and 18 bits to uint32.
+//
+// The SIMD kernels process 8 pixels, thus N bytes, at a time. Each 32-bit
+// lane gathers the 4 bytes its pixel starts in with a byte shuffle, shifts
+// the pixel down and masks it. The kernel for the best instruction set
+// supported by the CPU is selected at run time, x86 without AVX2 or SSE4.1
+// and other architectures without NEON use the scalar reference.
+
+enum class BitUnpackIsa
+{
+    Scalar,
+    Sse41,
+    Avx2,
+    Neon,
+};
+
+/** Returns true if the compression is one of the supported bit-packing modes. */
+static inline bool BitPackIsSupported(unsigned bits)
+{
+    return (bits >= 9 && bits <= 15) || bits == 17 || bits == 18;
+}
+
+/** Returns the number of bytes the given count of packed pixels occupies. */
+static inline size_t BitPackPackedBytes(size_t count, unsigned bits)
+{
+    return (count * bits + 7) / 8;
+}
+
+/** Returns the size of unpacked pixels in bytes, 2 or 4. */
+static inline size_t BitPackUnpackedPixelBytes(unsigned bits)
+{
+    return (bits <= 16) ? sizeof(uint16_t) : sizeof(uint32_t);
+}
+
+/** Reference implementation, never reads past the packed pixels. */
+template<typename T>
+static inline void BitUnpackScalar(const uint8_t* src, size_t count, unsigned bits, T* dst)
+{
+    const uint32_t mask = (1u << bits) - 1;
+    uint64_t acc = 0;
+    unsigned accBits = 0;
+    for (size_t n = 0; n < count; n++)
+    {
+        while (accBits < bits)
+        {
+            acc |= (uint64_t)*src++ << accBits;
+            accBits += 8;
+        }
+        dst[n] = (T)(acc & mask);
+        acc >>= bits;
+        accBits -= bits;
+    }
+}
+
+/**
+ * Positions of 8 packed pixels. The pixels 0-3 are gathered from 16 bytes
+ * loaded at the start of the group, the pixels 4-7 from 16 bytes loaded at
+ * halfOffset. Every lane takes 4 bytes, the pixel then starts at bit shift.
+ */
+struct BitPackLayout
+{
+    uint8_t shuffle[32];
+    int32_t shift[8];
+    uint32_t mask;
+    size_t halfOffset;
+    size_t readBytes; // Bytes read by one group of 8 pixels
+
+    explicit BitPackLayout(unsigned bits)
+    {
+        mask = (1u << bits) - 1;
+        halfOffset = 4 * bits / 8;
+        readBytes = halfOffset + 16;
+        for (unsigned i = 0; i < 8; i++)
+        {
+            const size_t base = (i < 4) ? 0 : halfOffset;
+            const size_t byte = i * bits / 8 - base;
+            for (unsigned b = 0; b < 4; b++)
+                shuffle[4 * i + b] = (uint8_t)(byte + b);
+            shift[i] = (int32_t)(i * bits % 8);
+        }
+    }
+};
+
+#ifdef PYVCAM_BITPACK_X86
+
+PYVCAM_BITPACK_TARGET("avx2")
+static inline __m256i BitUnpackGroupAvx2(const uint8_t* src, const BitPackLayout& layout,
+        __m256i shuffle, __m256i shift, __m256i mask)
+{
+    const __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src));
+    const __m128i hi = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(src + layout.halfOffset));
+    __m256i v = _mm256_inserti128_si256(_mm256_castsi128_si256(lo), hi, 1);
+    v = _mm256_shuffle_epi8(v, shuffle);
+    v = _mm256_srlv_epi32(v, shift);
+    return _mm256_and_si256(v, mask);
+}
+
+/** Unpacks 16 pixels per iteration, returns the number of pixels done. */
+template<typename T>
+PYVCAM_BITPACK_TARGET("avx2")
+static size_t BitUnpackAvx2(const uint8_t* src, size_t count, unsigned bits, T* dst)
+{
+    const BitPackLayout layout(bits);
+    const __m256i shuffle = _mm256_loadu_si256(
+            reinterpret_cast<const __m256i*>(layout.shuffle));
+    const __m256i shift = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(layout.shift));
+    const __m256i mask = _mm256_set1_epi32((int)layout.mask);
+    const size_t packedBytes = BitPackPackedBytes(count, bits);
+
+    size_t n = 0;
+    size_t pos = 0;
+    while (n + 16 <= count && pos + bits + layout.readBytes <= packedBytes)
+    {
+        const __m256i a = BitUnpackGroupAvx2(src + pos, layout, shuffle, shift, mask);
+        const __m256i b = BitUnpackGroupAvx2(src + pos + bits, layout, shuffle, shift, mask);
+        if (sizeof(T) == sizeof(uint16_t))
+        {
+            // Packing works within 128-bit lanes, restore the order of 64-bit parts
+            const __m256i ab = _mm256_permute4x64_epi64(_mm256_packus_epi32(a, b), 0xD8);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + n), ab);
+        }
+        else
+        {
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + n), a);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + n + 8), b);
+        }
+        n += 16;
+        pos += 2 * bits;
+    }
+    return n;
+}
+
+/** Unpacks 8 pixels per iteration, returns the number of pixels done. */
+template<typename T>
+PYVCAM_BITPACK_TARGET("sse4.1")
+static size_t BitUnpackSse41(const uint8_t* src, size_t count, unsigned bits, T* dst)
+{
+    const BitPackLayout layout(bits);
+    const __m128i shuffleLo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(layout.shuffle));
+    const __m128i shuffleHi = _mm_loadu_si128(
+            reinterpret_cast<const __m128i*>(layout.shuffle + 16));
+    // There is no per-lane shift, (v << (7 - shift)) >> 7 is done via multiplication
+    const __m128i mulLo = _mm_setr_epi32(1 << (7 - layout.shift[0]), 1 << (7 - layout.shift[1]),
+            1 << (7 - layout.shift[2]), 1 << (7 - layout.shift[3]));
+    const __m128i mulHi = _mm_setr_epi32(1 << (7 - layout.shift[4]), 1 << (7 - layout.shift[5]),
+            1 << (7 - layout.shift[6]), 1 << (7 - layout.shift[7]));
+    const __m128i mask = _mm_set1_epi32((int)layout.mask);
+    const size_t packedBytes = BitPackPackedBytes(count, bits);
+
+    size_t n = 0;
+    size_t pos = 0;
+    while (n + 8 <= count && pos + layout.readBytes <= packedBytes)
+    {
+        __m128i a = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + pos));
+        __m128i b = _mm_loadu_si128(
+                reinterpret_cast<const __m128i*>(src + pos + layout.halfOffset));
+        a = _mm_and_si128(_mm_srli_epi32(_mm_mullo_epi32(
+                        _mm_shuffle_epi8(a, shuffleLo), mulLo), 7), mask);
+        b = _mm_and_si128(_mm_srli_epi32(_mm_mullo_epi32(
+                        _mm_shuffle_epi8(b, shuffleHi), mulHi), 7), mask);
+        if (sizeof(T) == sizeof(uint16_t))
+        {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + n), _mm_packus_epi32(a, b));
+        }
+        else
+        {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + n), a);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + n + 4), b);
+        }
+        n += 8;
+        pos += bits;
+    }
+    return n;
+}
+
+static inline BitUnpackIsa BitUnpackDetectIsa()
+{
+#ifdef _MSC_VER
+    int info[4];
+    __cpuid(info, 0);
+    const int maxLeaf = info[0];
+    __cpuid(info, 1);
+    const bool sse41 = (info[2] & (1 << 19)) != 0;
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx2 = false;
+    if (maxLeaf >= 7 && osxsave && (_xgetbv(0) & 0x6) == 0x6)
+    {
+        __cpuidex(info, 7, 0);
+        avx2 = (info[1] & (1 << 5)) != 0;
+    }
+#else
+    __builtin_cpu_init();
+    const bool sse41 = __builtin_cpu_supports("sse4.1");
+    const bool avx2 = __builtin_cpu_supports("avx2");
+#endif
+    if (avx2)
+        return BitUnpackIsa::Avx2;
+    if (sse41)
+        return BitUnpackIsa::Sse41;
+    return BitUnpackIsa::Scalar;
+}
+
+#endif // PYVCAM_BITPACK_X86
+
+#ifdef PYVCAM_BITPACK_NEON
+
+/** Unpacks 8 pixels per iteration, returns the number of pixels done. */
+template<typename T>
+static size_t BitUnpackNeon(const uint8_t* src, size_t count, unsigned bits, T* dst)
+{
+    const BitPackLayout layout(bits);
+    const uint8x16_t shuffleLo = vld1q_u8(layout.shuffle);
+    const uint8x16_t shuffleHi = vld1q_u8(layout.shuffle + 16);
+    // Negative shift counts shift to the right
+    const int32x4_t shiftLo = vnegq_s32(vld1q_s32(layout.shift));
+    const int32x4_t shiftHi = vnegq_s32(vld1q_s32(layout.shift + 4));
+    const uint32x4_t mask = vdupq_n_u32(layout.mask);
+    const size_t packedBytes = BitPackPackedBytes(count, bits);
+
+    size_t n = 0;
+    size_t pos = 0;
+    while (n + 8 <= count && pos + layout.readBytes <= packedBytes)
+    {
+        const uint8x16_t lo = vld1q_u8(src + pos);
+        const uint8x16_t hi = vld1q_u8(src + pos + layout.halfOffset);
+        uint32x4_t a = vreinterpretq_u32_u8(vqtbl1q_u8(lo, shuffleLo));
+        uint32x4_t b = vreinterpretq_u32_u8(vqtbl1q_u8(hi, shuffleHi));
+        a = vandq_u32(vshlq_u32(a, shiftLo), mask);
+        b = vandq_u32(vshlq_u32(b, shiftHi), mask);
+        if (sizeof(T) == sizeof(uint16_t))
+        {
+            vst1q_u16(reinterpret_cast<uint16_t*>(dst + n),
+                    vcombine_u16(vmovn_u32(a), vmovn_u32(b)));
+        }
+        else
+        {
+            vst1q_u32(reinterpret_cast<uint32_t*>(dst + n), a);
+            vst1q_u32(reinterpret_cast<uint32_t*>(dst + n + 4), b);
+        }
+        n += 8;
+        pos += bits;
+    }
+    return n;
+}
+
+#endif // PYVCAM_BITPACK_NEON
+
+/** Returns the instruction set used by BitUnpack, detected once. */
+static inline BitUnpackIsa BitUnpackGetIsa()
+{
+#if defined(PYVCAM_BITPACK_X86)
+    static const BitUnpackIsa isa = BitUnpackDetectIsa();
+    return isa;
+#elif defined(PYVCAM_BITPACK_NEON)
+    return BitUnpackIsa::Neon;
+#else
+    return BitUnpackIsa::Scalar;
+#endif
+}
+
+/**
+ * Unpacks count pixels with given bits each using the given instruction set,
+ * the caller ensures it is supported. T must be uint16_t for up to 16 bits,
+ * uint32_t otherwise.
+ */
+template<typename T>
+static inline void BitUnpackWithIsa(BitUnpackIsa isa, const uint8_t* src, size_t count,
+        unsigned bits, T* dst)
+{
+    static_assert(sizeof(T) == sizeof(uint16_t) || sizeof(T) == sizeof(uint32_t),
+            "Unsupported pixel type");
+    size_t done = 0;
+    switch (isa)
+    {
+#ifdef PYVCAM_BITPACK_X86
+    case BitUnpackIsa::Avx2:
+        done = BitUnpackAvx2(src, count, bits, dst);
+        break;
+    case BitUnpackIsa::Sse41:
+        done = BitUnpackSse41(src, count, bits, dst);
+        break;
+#endif
+#ifdef PYVCAM_BITPACK_NEON
+    case BitUnpackIsa::Neon:
+        done = BitUnpackNeon(src, count, bits, dst);
+        break;
+#endif
+    default:
+        break;
+    }
+    // Kernels stop at a multiple of 8 pixels, the tail starts on a byte boundary
+    BitUnpackScalar(src + done * bits / 8, count - done, bits, dst + done);
+}
+
+/**
+ * Unpacks count pixels from src that holds BitPackPackedBytes(count, bits)
+ * bytes into dst with BitPackUnpackedPixelBytes(bits) bytes per pixel.
+ * Returns false if the number of bits is not supported.
+ */
+static inline bool BitUnpack(const void* src, size_t count, unsigned bits, void* dst)
+{
+    if (!BitPackIsSupported(bits))
+        return false;
+    const BitUnpackIsa isa = BitUnpackGetIsa();
+    if (bits <= 16)
+    {
+        BitUnpackWithIsa(isa, static_cast<const uint8_t*>(src), count, bits,
+                static_cast<uint16_t*>(dst));
+    }
+    else
+    {
+        BitUnpackWithIsa(isa, static_cast<const uint8_t*>(src), count, bits,
+                static_cast<uint32_t*>(dst));
+    }
+    return true;
+}
+
+#endif // PYVCAM_BITPACK_H
@@ -1,5 +1,7 @@
+from contextlib import contextmanager
 from copy import deepcopy
 import functools
+import json
 import os
 import time
 from typing import Dict, List, Optional, Tuple
@@ -110,6 +112,13 @@ class Camera:
 
     WAIT_FOREVER = -1
 
+    # Directory with capabilities learned on open, stored per serial number and
+    # firmware version so reopening the camera doesn't walk all the tables again.
+    # Disabled by default, a driver or PVCAM update isn't detected and the cached
+    # tables must be deleted by hand then.
+    CAPABILITIES_CACHE_DIR: Optional[str] = os.environ.get('PYVCAM_CACHE_DIR')
+    CAPABILITIES_CACHE_VERSION = 1
+
     def __init__(self, name):
         """NOTE: CALL Camera.detect_camera() to get a camera object."""
 
@@ -137,6 +146,9 @@ class Camera:
             Camera.RegionOfInterest(s1=0, s2=0, sbin=1, p1=0, p2=0, pbin=1)
         self.__rois: List[Camera.RegionOfInterest] = []
 
+        # Recomposition of all ROIs into one full-sensor frame, None if disabled
+        self.__recompose: Optional[dict] = None
+
         # Binning factors if the camera doesn't support arbitrary binning
         self.__limited_binnings: Optional[List[Tuple[int, int]]] = None
 
@@ -165,6 +177,9 @@ class Camera:
 
         self.__dtype = np.dtype('u2')  # uns16 by default
 
+        # Parameters collected by batch_params, None if no batch is active
+        self.__param_batch: Optional[dict] = None
+
     def __repr__(self):
         return self.__name
 
@@ -297,79 +312,50 @@ class Camera:
         self.__prog_scan_dirs = Camera.ReversibleEnumDict(
             'prog_scan_dirs', self, const.PARAM_SCAN_DIRECTION)
 
-        # Learn ports, speeds and gains
-        self.__port_speed_gain_table = {}
-        for port_name, port_value in self.read_enum(const.PARAM_READOUT_PORT).items():
-            self.readout_port = port_value
-
-            self.__port_speed_gain_table[port_name] = {
-                'port_value': port_value,
-            }
-
-            num_speeds = self.get_param(const.PARAM_SPDTAB_INDEX, const.ATTR_COUNT)
-            for speed_index in range(num_speeds):
-                self.speed = speed_index
-
-                speed_name = self.speed_name
-
-                gain_min = self.get_param(const.PARAM_GAIN_INDEX, const.ATTR_MIN)
-                gain_max = self.get_param(const.PARAM_GAIN_INDEX, const.ATTR_MAX)
-                gain_increment = self.get_param(const.PARAM_GAIN_INDEX, const.ATTR_INCREMENT)
-
-                num_gains = int((gain_max - gain_min) / gain_increment + 1)
-                gains = [(gain_min + i * gain_increment) for i in range(num_gains)]
-
-                self.__port_speed_gain_table[port_name][speed_name] = {
-                    'speed_index': speed_index,
-                    'pixel_time': self.pix_time,
-                    'gain_range': gains,
-                }
-
-                for gain_index in gains:
-                    self.gain = gain_index
-
-                    gain_name = self.gain_name
-
-                    self.__port_speed_gain_table[port_name][speed_name][gain_name] = {
-                        'gain_index': gain_index,
-                        'bit_depth': self.bit_depth,
-                    }
+        # Learn ports, speeds, gains and post-processing features
+        capabilities = self.__load_capabilities()
+        self.__port_speed_gain_table = capabilities['port_speed_gain_table']
+        self.__post_processing_table = capabilities['post_processing_table']
 
         # Reset speed table back to default
         self.readout_port = 0
         self.speed = 0
         self.gain = 1
 
-        # Learn post-processing features
-        self.__post_processing_table = {}
-        try:
-            feature_count = self.get_param(const.PARAM_PP_INDEX, const.ATTR_COUNT)
-            for feature_index in range(feature_count):
-                self.set_param(const.PARAM_PP_INDEX, feature_index)
-
-                feature_id = self.get_param(const.PARAM_PP_FEAT_ID)
-                feature_name = self.get_param(const.PARAM_PP_FEAT_NAME)
-                self.__post_processing_table[feature_name] = {}
-
-                param_count = self.get_param(const.PARAM_PP_PARAM_INDEX, const.ATTR_COUNT)
-                for param_index in range(param_count):
-                    self.set_param(const.PARAM_PP_PARAM_INDEX, param_index)
-
-                    param_id = self.get_param(const.PARAM_PP_PARAM_ID)
-                    param_name = self.get_param(const.PARAM_PP_PARAM_NAME)
-                    param_min = self.get_param(const.PARAM_PP_PARAM, const.ATTR_MIN)
-                    param_max = self.get_param(const.PARAM_PP_PARAM, const.ATTR_MAX)
-                    self.__post_processing_table[feature_name][param_name] = {
-                        'feature_index': feature_index,
-                        'feature_id': feature_id,
-                        'param_index': param_index,
-                        'param_id': param_id,
-                        'param_min': param_min,
-                        'param_max': param_max,
-                    }
+    def __capabilities_cache_path(self):
+        if Camera.CAPABILITIES_CACHE_DIR is None:
+            return None
+        serial_no = self.serial_no
+        if serial_no in ('', 'N/A'):
+            return None  # Not unique
+        key = f'{self.__name}_{serial_no}_{self.cam_fw}'
+        key = ''.join(c if (c.isalnum() or c in '.-') else '_' for c in key)
+        return os.path.join(Camera.CAPABILITIES_CACHE_DIR, f'capabilities_{key}.json')
+
+    def __load_capabilities(self):
+        path = self.__capabilities_cache_path()
+        if path is not None:
+            try:
+                with open(path, encoding='utf-8') as file:
+                    capabilities = json.load(file)
+                if capabilities.get('version') == Camera.CAPABILITIES_CACHE_VERSION:
+                    return capabilities
+            except (OSError, ValueError):
+                pass  # Missing or broken, learn again
 
-        except AttributeError:
-            pass
+        capabilities = pvc.discover_capabilities(self.__handle)
+
+        if path is not None:
+            capabilities['version'] = Camera.CAPABILITIES_CACHE_VERSION
+            try:
+                os.makedirs(os.path.dirname(path), exist_ok=True)
+                tmp_path = f'{path}.{os.getpid()}.tmp'
+                with open(tmp_path, 'w', encoding='utf-8') as file:
+                    json.dump(capabilities, file, indent=1)
+                os.replace(tmp_path, path)
+            except OSError:
+                pass  # Caching is optional
+        return capabilities
 
     def close(self):
         """Closes the camera.
@@ -518,8 +504,72 @@ class Camera:
                             See the get_param documentation for value type.
         """
 
+        if self.__param_batch is not None:
+            # The last assignment of a parameter is applied last
+            self.__param_batch.pop(param_id, None)
+            self.__param_batch[param_id] = value
+            return
         pvc.set_param(self.__handle, param_id, value)
 
+    def get_params(self, params):
+        """Gets values of multiple parameters and attributes in one call.
+
+        All values are read in C++ without holding the GIL. A failure of one
+        item doesn't stop the others.
+
+        Parameters:
+            params (list): A list of `(param_id, param_attr)` tuples.
+
+        Returns:
+            A tuple with values in the order of `params`, see `get_param` for
+            their types. An item that failed holds the exception instance
+            (`AttributeError` or `RuntimeError`) instead of the value.
+        """
+
+        return pvc.get_params(self.__handle, params)
+
+    @contextmanager
+    def batch_params(self):
+        """Collects parameters set within the block and applies them in one call.
+
+        All `set_param` calls, including those done by property setters, are
+        deferred until the block exits. Then the parameters are set in the order
+        they were first assigned, a repeated assignment moves the parameter
+        to the end. Checks done by property setters read the settings valid
+        before the block. If the block raises, no parameter is set.
+
+        Usage:
+            with cam.batch_params() as results:
+                cam.exp_time = 10
+                cam.clear_mode = 'Never'
+            # results maps param_id to None or the exception
+
+        Yields:
+            A dictionary filled on exit with results for each parameter ID.
+
+        Raises:
+            The first per-parameter error after all parameters were attempted.
+        """
+
+        if self.__param_batch is not None:
+            raise RuntimeError('Parameter batch is already active')
+        self.__param_batch = {}
+        results = {}
+        try:
+            yield results
+            batch = self.__param_batch
+        finally:
+            self.__param_batch = None
+
+        if not batch:
+            return
+        errors = pvc.set_params(self.__handle, batch)
+        results.update(zip(batch.keys(), errors))
+        self._set_dtype()
+        for error in errors:
+            if error is not None:
+                raise error
+
     def check_param(self, param_id):
         """Checks if a specified setting of a camera is available to read/modify.
 
@@ -654,23 +704,40 @@ class Camera:
             copyData (bool):
                 Selects whether to return a copy of the numpy frame which points to
                 a new buffer, or the original numpy frame which points to the buffer
-                used directly by PVCAM. Disabling this copy is not recommended for most
-                situations. Refer to PyVCAM Wrapper.md for more details.
+                used directly by PVCAM. Without the copy, live frames are pinned if
+                the acquisition was started with pin_frames=True, so PVCAM doesn't
+                overwrite them until all arrays of the frame are released. A frame
+                too old to be pinned is copied natively then, which is best effort
+                only. Without pin_frames, the arrays may be overwritten by PVCAM
+                any time.
+                Refer to PyVCAM Wrapper.md for more details.
+                Not used if the recompose property is set.
 
         Returns:
             A dictionary with the frame containing available metadata and 2D np.array
-            pixel data, frames per second and frame count.
+            pixel data, frames per second and frame count. With the recompose
+            property set, the pixel data are all ROIs placed in one full-sensor array.
         """
 
+        if self.__recompose is not None:
+            # The canvas is either owned by caller or a new one, never copied
+            return pvc.get_frame_recomposed(
+                self.__handle, timeout_ms, oldestFrame,
+                self.__sensor_size[0], self.__sensor_size[1],
+                self.__recompose['fill'], self.__recompose['canvas'])
+
+        # Arrays pointing to the PVCAM buffer must stay valid, pin or copy them
         frame, fps, frame_count = pvc.get_frame(
-            self.__handle, self.__rois, self.__dtype.num, timeout_ms, oldestFrame)
+            self.__handle, timeout_ms, oldestFrame, not copyData)
 
         if copyData:
             # Shallow copy of the dict
             frame_tmp = frame.copy()
             # Deep copy the data
             frame_tmp['pixel_data'] = [np.copy(arr) for arr in frame['pixel_data']]
-            if 'meta_data' in frame.keys():
+            # Structured arrays with headers are always new, no need to copy them
+            if 'meta_data' in frame.keys() and \
+                    isinstance(frame['meta_data']['roi_headers'], list):
                 frame_tmp['meta_data'] = deepcopy(frame['meta_data'])
 
             frame = frame_tmp
@@ -681,6 +748,56 @@ class Camera:
 
         return frame, fps, frame_count
 
+    def poll_frames(self, max_count, timeout_ms=0, copyData=True):
+        """Calls the pvc.get_frames function with the current camera settings.
+
+        Parameter:
+            max_count (int): The maximum number of queued frames to return.
+            timeout_ms (int):
+                Duration to wait for at least one frame. With zero, the default,
+                the call does not wait and may return no frames.
+            copyData (bool):
+                Selects whether to return pixel data in a new buffer, or directly
+                from the buffer used by PVCAM if the frames lie there back to back.
+                With pin_frames set at start, frames are always copied.
+                The copy is done natively right after the frames are taken from
+                the queue, frames PVCAM may have overwritten meanwhile are dropped.
+                Refer to PyVCAM Wrapper.md for more details.
+
+        Returns:
+            A dictionary with 3D np.array pixel data of the first ROI and 1D
+            np.arrays with frame counts, hardware frame numbers and EOF and BOF
+            timestamps per frame, and frames per second.
+        """
+
+        return pvc.get_frames(
+            self.__handle, max_count, timeout_ms, copyData)
+
+    def poll_frame_view(self, timeout_ms=WAIT_FOREVER, oldestFrame=True, pin=False):
+        """Calls the pvc.get_frame_view function with the current camera settings.
+
+        Parameter:
+            timeout_ms (int): Duration to wait for new frames.
+            oldestFrame (bool):
+                Selects whether to return the oldest or newest frame.
+                Only the oldest frame will be popped off the underlying queue of frames.
+            pin (bool): Keep PVCAM from overwriting the frame until the view and
+                all arrays and buffers taken from it are released. Needs live
+                acquisition started with pin_frames=True, otherwise it has no
+                effect. A frame too old to be pinned is copied, best effort only.
+
+        Returns:
+            A pvc.FrameView with the frame, frames per second and frame count.
+            The metadata are decoded only once the frame_header, roi_headers,
+            ext_metadata or pixel_data attributes are read. The pixel data
+            are never copied and point to the buffer used directly by PVCAM.
+            The buffers attribute exports them via the buffer protocol and
+            DLPack, e.g. to np.asarray, memoryview or torch.from_dlpack.
+        """
+
+        return pvc.get_frame_view(
+            self.__handle, timeout_ms, oldestFrame, pin)
+
     def get_frame(self, exp_time=None, timeout_ms=WAIT_FOREVER,
                   reset_frame_counter=False):
         """Calls the pvc.get_frame function with the current camera settings.
@@ -700,16 +817,20 @@ class Camera:
         return frame['pixel_data']
 
     def get_sequence(self, num_frames, exp_time=None, timeout_ms=WAIT_FOREVER,
-                     interval=None, reset_frame_counter=False):
-        """Calls the pvc.get_frame function with the current camera settings in
-            rapid-succession for the specified number of frames.
+                     interval=None, reset_frame_counter=False, out=None):
+        """Calls the pvc.acquire_stack function with the current camera settings
+            to capture the specified number of frames in one sequence.
 
         Parameter:
             num_frames (int): Number of frames to capture in the sequence
             exp_time (int): The exposure time
-            timeout_ms (int): Duration to wait for new frames.
-            interval (int): The time in milliseconds to wait between captures
+            timeout_ms (int): Duration to wait for each frame.
+            interval (int): The time in milliseconds between exposure starts.
+                Frames are triggered by software in software edge trigger mode,
+                otherwise a one-frame sequence is restarted for each frame.
             reset_frame_counter (bool): Reset frame_count returned by poll_frame.
+            out (np.array): Optional C-contiguous array of shape
+                (num_frames, height, width) and camera's data type to fill.
         Returns:
             A 3D np.array containing the pixel data from the captured frames.
         """
@@ -717,23 +838,23 @@ class Camera:
         if len(self.__rois) > 1:
             raise ValueError('get_sequence does not support multi-roi captures')
 
-        shape = self.__rois[0].shape
-        stack = np.empty((num_frames, shape[1], shape[0]), dtype=self.__dtype)
+        if not isinstance(exp_time, int):
+            exp_time = self.exp_time
 
-        for i in range(num_frames):
-            stack[i] = self.get_frame(exp_time=exp_time, timeout_ms=timeout_ms,
-                                      reset_frame_counter=reset_frame_counter)
-            reset_frame_counter = False
+        if reset_frame_counter:
+            pvc.reset_frame_counter(self.__handle)
 
-            if isinstance(interval, int) and i + 1 < num_frames:
-                time.sleep(interval / 1000)
+        interval_ms = interval if isinstance(interval, int) else 0
 
-        return stack
+        # Set up, acquired and finished in one call without the GIL
+        return pvc.acquire_stack(self.__handle, self.__rois, exp_time, self.__mode,
+                                 num_frames, timeout_ms, interval_ms, out)
 
     def get_vtm_sequence(self, time_list, exp_res, num_frames, timeout_ms=WAIT_FOREVER,
                          interval=None, reset_frame_counter=False):
-        """Calls the pvc.get_frame function within a loop, setting vtm expTime
-            between each capture.
+        """Calls the pvc.acquire_stack function with all vtm timings in Variable
+            Timed Mode, otherwise emulates it with the pvc.get_frame function
+            within a loop, setting expTime between each capture.
 
         Parameter:
             time_list (list of ints): List of vtm timings
@@ -745,14 +866,13 @@ class Camera:
             reset_frame_counter (bool): Reset frame_count returned by poll_frame.
         Returns:
             A 3D np.array containing the pixel data from the captured sequence.
+            In Variable Timed Mode, the achieved cycle and re-arm times are
+            reported by the acq_stats property.
         """
 
         if len(self.__rois) > 1:
             raise ValueError('get_vtm_sequence does not support multi-roi captures')
 
-        shape = self.__rois[0].shape
-        stack = np.empty((num_frames, shape[1], shape[0]), dtype=self.__dtype)
-
         old_res = self.exp_res
         self.exp_res = exp_res
 
@@ -763,26 +883,21 @@ class Camera:
                 if reset_frame_counter:
                     pvc.reset_frame_counter(self.__handle)
 
-                # Use non-zero exposure time for VTM, the actual will be set later
-                pvc.setup_seq(self.__handle, self.__rois, 1, self.__mode, 1)
-                self.__acquisition_mode = 'Sequence'
-
-                for i in range(num_frames):
-                    exp_time = time_list[i % len(time_list)]
-
-                    self.vtm_exp_time = exp_time
-                    pvc.start_set_seq(self.__handle)
-
-                    frame, _, _ = self.poll_frame(timeout_ms=timeout_ms)
-                    stack[i] = frame['pixel_data']
-
-                    if isinstance(interval, int) and i + 1 < num_frames:
-                        time.sleep(interval / 1000)
+                for exp_time in set(time_list):
+                    self.__check_vtm_exp_time(exp_time)
 
-                self.finish()
+                # Every frame is started with next time from the callback, the time
+                # given for setup just must be non-zero
+                interval_ms = interval if isinstance(interval, int) else 0
+                stack = pvc.acquire_stack(self.__handle, self.__rois, 1, self.__mode,
+                                          num_frames, timeout_ms, interval_ms, None,
+                                          list(time_list))
 
             else:  # Emulated VTM, very similar to get_sequence()
 
+                shape = self.__rois[0].shape
+                stack = np.empty((num_frames, shape[1], shape[0]), dtype=self.__dtype)
+
                 for i in range(num_frames):
                     exp_time = time_list[i % len(time_list)]
 
@@ -800,7 +915,8 @@ class Camera:
         return stack
 
     def start_live(self, exp_time=None, buffer_frame_count=16,
-                   stream_to_disk_path=None, reset_frame_counter=False):
+                   stream_to_disk_path=None, reset_frame_counter=False,
+                   stream_backend=None, pin_frames=False):
         """Calls the pvc.start_live function to set up a circular buffer acquisition.
 
         Parameter:
@@ -808,38 +924,50 @@ class Camera:
             buffer_frame_count (int): The number of frames in circ. buffer.
             stream_to_disk_path (str): None, or location where to save the data.
             reset_frame_counter (bool): Reset frame_count returned by poll_frame.
+            stream_backend (str): None or 'write' for synchronous writes, or
+                'io_uring' for multiple writes in flight on Linux. Falls back
+                to synchronous writes if io_uring is not available.
+            pin_frames (bool): Frames polled with poll_frame_view(pin=True)
+                are not overwritten until released. While the oldest frame is
+                pinned, new frames take two spare slots. A pinned frame without
+                arrays or buffer exports alive is then copied out of the buffer,
+                counted by forced_copies in acq_stats. A frame with exports stays
+                in place and PVCAM discards new frames once the spare slots are
+                used up, counted by pin_dropped_frames.
+                Needs buffer_frame_count of at least 2.
         Returns:
             None
+        Raises:
+            ValueError: If pin_frames is set with buffer_frame_count below 2.
         """
 
         if not isinstance(exp_time, int):
             exp_time = self.exp_time
 
-        if isinstance(stream_to_disk_path, str):
-            stream_to_disk_path_abs = os.path.abspath(stream_to_disk_path)
-            directory, filename = os.path.split(stream_to_disk_path_abs)
-            if os.path.exists(directory):
-                try:
-                    os.remove(filename)
-                except OSError:
-                    pass
-            else:
-                raise ValueError(f'Invalid directory for stream to disk: {directory}')
+        self.__check_stream_to_disk_path(stream_to_disk_path)
 
         if reset_frame_counter:
             pvc.reset_frame_counter(self.__handle)
 
         self.__acquisition_mode = 'Live'
         pvc.start_live(self.__handle, self.__rois, exp_time, self.__mode,
-                       buffer_frame_count, stream_to_disk_path)
+                       buffer_frame_count, stream_to_disk_path, stream_backend,
+                       pin_frames)
 
-    def start_seq(self, exp_time=None, num_frames=1, reset_frame_counter=False):
+    def start_seq(self, exp_time=None, num_frames=1, reset_frame_counter=False,
+                  stream_to_disk_path=None, stream_backend=None):
         """Calls the pvc.start_seq function to set up a non-circular buffer acquisition.
 
         Parameter:
             exp_time (int): The exposure time.
-            num_frames (int): The number of frames in a sequence (max. 65535).
+            num_frames (int): The number of frames in a sequence. Sequences
+                longer than 65535 frames or 4GB are acquired in segments.
             reset_frame_counter (bool): Reset frame_count returned by poll_frame.
+            stream_to_disk_path (str): None, or location where to save the data.
+                The file is complete once the acquisition is finished.
+            stream_backend (str): None or 'write' for synchronous writes, or
+                'io_uring' for multiple writes in flight on Linux. Falls back
+                to synchronous writes if io_uring is not available.
         Returns:
             None
         """
@@ -847,11 +975,35 @@ class Camera:
         if not isinstance(exp_time, int):
             exp_time = self.exp_time
 
+        self.__check_stream_to_disk_path(stream_to_disk_path)
+
         if reset_frame_counter:
             pvc.reset_frame_counter(self.__handle)
 
         self.__acquisition_mode = 'Sequence'
-        pvc.start_seq(self.__handle, self.__rois, exp_time, self.__mode, num_frames)
+        pvc.start_seq(self.__handle, self.__rois, exp_time, self.__mode, num_frames,
+                      stream_to_disk_path, stream_backend)
+
+    def __check_vtm_exp_time(self, value):
+        min_exp_time = self.get_param(const.PARAM_EXPOSURE_TIME, const.ATTR_MIN)
+        max_exp_time = self.get_param(const.PARAM_EXPOSURE_TIME, const.ATTR_MAX)
+        max_exp_time = min(max_exp_time, 65535)  # uns16 limit
+        if not min_exp_time <= value <= max_exp_time:
+            raise ValueError(f'Invalid value: {value} - {self} only supports '
+                             f'exposure times between {min_exp_time} and {max_exp_time}')
+
+    @staticmethod
+    def __check_stream_to_disk_path(stream_to_disk_path):
+        if isinstance(stream_to_disk_path, str):
+            stream_to_disk_path_abs = os.path.abspath(stream_to_disk_path)
+            directory, filename = os.path.split(stream_to_disk_path_abs)
+            if os.path.exists(directory):
+                try:
+                    os.remove(filename)
+                except OSError:
+                    pass
+            else:
+                raise ValueError(f'Invalid directory for stream to disk: {directory}')
 
     def finish(self):
         """Ends a previously started live or sequence acquisition.
@@ -1022,6 +1174,37 @@ class Camera:
     def cam_fw(self):
         return pvc.get_cam_fw_version(self.__handle)
 
+    @property
+    def acq_stats(self):
+        return pvc.get_acq_stats(self.__handle)
+
+    @property
+    def acq_buffer_policy(self):
+        return pvc.get_acq_buffer_policy(self.__handle)
+
+    @acq_buffer_policy.setter
+    def acq_buffer_policy(self, value):
+        # Keys not given keep their current value
+        policy = self.acq_buffer_policy
+        unknown = set(value) - {'hugepages', 'prefault', 'mlock'}
+        if unknown:
+            raise ValueError(f'Unknown acquisition buffer policy keys: {sorted(unknown)}')
+        policy.update(value)
+        pvc.set_acq_buffer_policy(self.__handle, policy['hugepages'], policy['prefault'],
+                                  policy['mlock'])
+
+    @property
+    def param_cache_enabled(self):
+        return pvc.get_param_cache_stats(self.__handle)['enabled']
+
+    @param_cache_enabled.setter
+    def param_cache_enabled(self, value):
+        pvc.set_param_cache_enabled(self.__handle, value)
+
+    @property
+    def param_cache_stats(self):
+        return pvc.get_param_cache_stats(self.__handle)
+
     @property
     def chip_name(self):
         return self.get_param(const.PARAM_CHIP_NAME)
@@ -1319,12 +1502,7 @@ class Camera:
 
     @vtm_exp_time.setter
     def vtm_exp_time(self, value):
-        min_exp_time = self.get_param(const.PARAM_EXPOSURE_TIME, const.ATTR_MIN)
-        max_exp_time = self.get_param(const.PARAM_EXPOSURE_TIME, const.ATTR_MAX)
-        max_exp_time = min(max_exp_time, 65535)  # uns16 limit
-        if not min_exp_time <= value <= max_exp_time:
-            raise ValueError(f'Invalid value: {value} - {self} only supports '
-                             f'exposure times between {min_exp_time} and {max_exp_time}')
+        self.__check_vtm_exp_time(value)
         self.set_param(const.PARAM_EXP_TIME, value)
 
     @property
@@ -1506,6 +1684,31 @@ class Camera:
     def metadata_enabled(self, value):
         self.set_param(const.PARAM_METADATA_ENABLED, value)
 
+    @property
+    def metadata_format(self):
+        return pvc.get_metadata_format(self.__handle)
+
+    @metadata_format.setter
+    def metadata_format(self, value):
+        pvc.set_metadata_format(self.__handle, value)
+
+    @property
+    def recompose(self):
+        return None if self.__recompose is None else dict(self.__recompose)
+
+    @recompose.setter
+    def recompose(self, value):
+        if value is None or value is False:
+            self.__recompose = None
+            return
+        recompose = {'fill': 0, 'canvas': None}
+        if value is not True:
+            unknown = set(value) - set(recompose)
+            if unknown:
+                raise ValueError(f'Unknown recompose keys: {sorted(unknown)}')
+            recompose.update(value)
+        self.__recompose = recompose
+
     @property
     @deprecated("Use 'metadata_enabled' property instead")
     def meta_data_enabled(self):
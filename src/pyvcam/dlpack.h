@@ -0,0 +1,79 @@
+#ifndef PYVCAM_DLPACK_H
+#define PYVCAM_DLPACK_H
+
+// System
+#include <cstdint>
+
+// Subset of the DLPack ABI (https://github.com/dmlc/dlpack, v1.0) needed to
+// export host memory. The layout must match dlpack.h exactly, consumers rely
+// on it. Only the types and constants used by the pvc module are declared.
+
+static constexpr const char* DLPACK_CAPSULE_NAME = "dltensor";
+static constexpr const char* DLPACK_USED_CAPSULE_NAME = "used_dltensor";
+static constexpr const char* DLPACK_VERSIONED_CAPSULE_NAME = "dltensor_versioned";
+static constexpr const char* DLPACK_USED_VERSIONED_CAPSULE_NAME = "used_dltensor_versioned";
+
+static constexpr uint32_t DLPACK_MAJOR_VERSION = 1;
+static constexpr uint32_t DLPACK_MINOR_VERSION = 0;
+
+static constexpr uint64_t DLPACK_FLAG_BITMASK_READ_ONLY = 1ULL << 0;
+
+struct DLPackVersion
+{
+    uint32_t major;
+    uint32_t minor;
+};
+
+enum DLDeviceType : int32_t
+{
+    kDLCPU = 1,
+};
+
+struct DLDevice
+{
+    DLDeviceType device_type;
+    int32_t device_id;
+};
+
+enum DLDataTypeCode : uint8_t
+{
+    kDLInt = 0U,
+    kDLUInt = 1U,
+    kDLFloat = 2U,
+};
+
+struct DLDataType
+{
+    uint8_t code;
+    uint8_t bits;
+    uint16_t lanes;
+};
+
+struct DLTensor
+{
+    void* data;
+    DLDevice device;
+    int32_t ndim;
+    DLDataType dtype;
+    int64_t* shape;
+    int64_t* strides; // In elements, NULL for compact row-major tensors
+    uint64_t byte_offset;
+};
+
+struct DLManagedTensor
+{
+    DLTensor dl_tensor;
+    void* manager_ctx;
+    void (*deleter)(DLManagedTensor* self);
+};
+
+struct DLManagedTensorVersioned
+{
+    DLPackVersion version;
+    void* manager_ctx;
+    void (*deleter)(DLManagedTensorVersioned* self);
+    uint64_t flags;
+    DLTensor dl_tensor;
+};
+
+#endif // PYVCAM_DLPACK_H
@@ -0,0 +1,165 @@
+#ifndef PYVCAM_FRAME_HANDLER_H
+#define PYVCAM_FRAME_HANDLER_H
+
+// PVCAM
+#include <master.h>
+#include <pvcam.h>
+
+// Local
+#include "frame_ring.h"
+
+// System
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <string>
+
+// The EOF callback registered with PVCAM for live and sequence acquisitions.
+// It is a template over the camera, so native tests can drive the very same
+// handler with a camera stand-in free of Python. The camera provides the
+// members used below, Camera in pvcmodule.cpp documents their meaning.
+
+/**
+ * Takes the latest frame from PVCAM, queues it for get_frame and hands it to
+ * the frame slots and the stream writer. The camera mutex is held only briefly
+ * to report errors and to notify waiters.
+ */
+template<typename Cam>
+static void NewFrameHandler(FRAME_INFO* pFrameInfo, void* context)
+{
+    const auto cbTime = std::chrono::high_resolution_clock::now();
+
+    // Registered with the Camera as context, it outlives the registration
+    auto* cam = static_cast<Cam*>(context);
+    if (!cam)
+    {
+        fprintf(stderr, "pvc.NewFrameHandler: Missing camera instance.\n");
+        return; // No 'cam' means no mutex lock and no notify_all
+    }
+
+    void* address;
+    FRAME_INFO fi;
+    const rs_bool getLatestFrameResult =
+        pl_exp_get_latest_frame_ex(pFrameInfo->hCam, &address, &fi);
+
+    const uns32 frameCnt = ++cam->m_acqFrameCnt;
+    //printf("New frame callback. Frame count %u\n", frameCnt);
+
+    // Re-compute FPS every 5 frames
+    constexpr uns32 FPS_FRAME_COUNT = 5;
+    if (++cam->m_fpsFrameCnt >= FPS_FRAME_COUNT)
+    {
+        const auto timeDeltaUs =
+            std::chrono::duration_cast<std::chrono::microseconds>(
+                cbTime - cam->m_fpsLastTime).count();
+        if (timeDeltaUs != 0)
+        {
+            cam->m_fps = (double)cam->m_fpsFrameCnt / timeDeltaUs * 1e6;
+            cam->m_fpsLastTime = cbTime;
+            cam->m_fpsFrameCnt = 0;
+            //printf("FPS: %.1f timeDeltaUs: %lld\n", cam->m_fps.load(), timeDeltaUs);
+        }
+    }
+
+    if (!getLatestFrameResult)
+    {
+        cam->m_statCbErrors++;
+        {
+            std::lock_guard<std::mutex> lock(cam->m_mutex);
+            cam->m_acqCbError = "Failed to get latest frame from PVCAM.";
+        }
+        cam->m_acqCond.notify_all(); // Wakeup get_frame if anybody waits
+        return;
+    }
+
+    Frame frame;
+    frame.address = address;
+    frame.count = frameCnt;
+    frame.nr = cam->m_seqFrameBase + (uns32)fi.FrameNr; // Continuous across segments
+    frame.timeStamp = fi.TimeStamp;
+    frame.timeStampBof = fi.TimeStampBOF;
+
+    if (cam->m_isSequence)
+    {
+        if (cam->m_seqLastEofTime != std::chrono::high_resolution_clock::time_point())
+        {
+            const uint64_t cycleUs =
+                (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+                    cbTime - cam->m_seqLastEofTime).count();
+            cam->m_statCycleTimeTotalUs += cycleUs;
+            if (cycleUs > cam->m_statCycleTimeMaxUs.load(std::memory_order_relaxed))
+            {
+                cam->m_statCycleTimeMaxUs.store(cycleUs, std::memory_order_relaxed);
+            }
+        }
+        cam->m_seqLastEofTime = cbTime;
+    }
+
+    // Next segment of a long sequence is started once this frame is queued
+    bool rearm = false;
+    if (cam->m_isSequence && (uns32)fi.FrameNr >= cam->m_seqSetupFrames)
+    {
+        cam->m_seqFrameBase += cam->m_seqSetupFrames;
+        rearm = cam->m_seqFrameBase < cam->m_seqTotal && cam->m_seqRearm;
+    }
+
+    // Lock the new frame, let PVCAM reuse the oldest ones that aren't pinned
+    if (!cam->m_isSequence
+            && !cam->m_frameSlots->OnNewFrame(frame.address, frame.count, frame.nr))
+    {
+        char errMsg[ERROR_MSG_LEN] = "<UNKNOWN ERROR>";
+        pl_error_message(pl_error_code(), errMsg); // Ignore PVCAM error
+        cam->m_statCbErrors++;
+        std::lock_guard<std::mutex> lock(cam->m_mutex);
+        cam->m_acqCbError = std::string("Failed to unlock oldest frame: ") + errMsg;
+    }
+
+    // FrameNr is 1-based and restarts with every acquisition start
+    if (cam->m_lastFrameNr != 0 && frame.nr > cam->m_lastFrameNr + 1)
+    {
+        cam->m_statFrameNrGaps++;
+        cam->m_statFramesLost += frame.nr - cam->m_lastFrameNr - 1;
+    }
+    cam->m_lastFrameNr = frame.nr;
+
+    // Add frame to the queue, the oldest is dropped once the capacity is reached
+    if (cam->m_acqQueue.Push(frame))
+    {
+        cam->m_statQueueDropped++;
+    }
+    const uint64_t queueDepth = cam->m_acqQueue.Size();
+    if (queueDepth > cam->m_statMaxQueueDepth.load(std::memory_order_relaxed))
+    {
+        cam->m_statMaxQueueDepth.store(queueDepth, std::memory_order_relaxed);
+    }
+
+    // Only queues the data for the writer thread, never waits for it
+    std::string streamError;
+    if (!cam->StreamFrameToDisk(frame, streamError))
+    {
+        cam->m_statCbErrors++;
+        std::lock_guard<std::mutex> lock(cam->m_mutex);
+        cam->m_acqCbError = streamError;
+    }
+
+    if (rearm)
+    {
+        cam->m_seqSegmentEofTime = cbTime;
+        cam->m_seqRearmThread.Signal();
+    }
+
+    // Pairs with the increment in get_frame, either the waiter sees the new frame
+    // in the queue or we see the waiter and notify it
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (cam->m_acqWaiters.load() > 0)
+    {
+        {
+            // Held only for a moment, get_frame never keeps it while building Python objects
+            std::lock_guard<std::mutex> lock(cam->m_mutex);
+        }
+        cam->m_acqCond.notify_all(); // Wakeup get_frame
+    }
+}
+
+#endif // PYVCAM_FRAME_HANDLER_H
@@ -0,0 +1,198 @@
+#ifndef PYVCAM_FRAME_RING_H
+#define PYVCAM_FRAME_RING_H
+
+// PVCAM
+#include <master.h>
+
+// System
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <type_traits>
+
+// Local constants
+
+static constexpr size_t CACHE_LINE_SIZE = 64;
+
+// Local types
+
+struct Frame
+{
+    void* address{ NULL }; // Address within AcqBuffer received from PVCAM
+    uns32 count{ 0 }; // Frame number that resets after every setup
+    uns32 nr{ 0 }; // FrameNr from PVCAM's FRAME_INFO structure
+    long64 timeStamp{ 0 }; // EOF timestamp from FRAME_INFO
+    long64 timeStampBof{ 0 }; // BOF timestamp from FRAME_INFO
+};
+
+static_assert(std::is_trivially_copyable<Frame>::value, "Frame is copied word by word");
+
+/**
+ * Fixed-capacity ring of frame descriptors with overwrite-oldest semantics.
+ *
+ * There is exactly one producer, the PVCAM EOF callback, that never blocks.
+ * It is not a strict single-producer/single-consumer ring though. When the ring
+ * is full, the producer drops the oldest frame by advancing the tail with CAS.
+ * Consumers pop frames by advancing the same tail with CAS too, so they may run
+ * on any thread, but they have to be serialized by the caller.
+ *
+ * The slot array is rounded up to a power of two greater than the capacity.
+ * The producer thus never writes a slot that a consumer may legally read.
+ * A consumer that got preempted for a whole lap might copy a slot that is
+ * being rewritten. Like with a seqlock, such a copy is detected by re-checking
+ * the head or tail and discarded. The slots are copied via relaxed atomic words
+ * and fences, so the concurrent copy is not a data race.
+ */
+class FrameRing
+{
+public:
+    /** Drops all frames and re-allocates slots, must not run concurrently. */
+    void Reset(size_t capacity)
+    {
+        size_t slotCount = 2;
+        while (slotCount <= capacity)
+            slotCount <<= 1;
+
+        m_slots.reset(new Slot[slotCount]);
+        for (size_t n = 0; n < slotCount; n++)
+            StoreSlot(n, Frame());
+        m_mask = slotCount - 1;
+        m_capacity = capacity;
+        m_head.store(0, std::memory_order_relaxed);
+        m_tail.store(0, std::memory_order_relaxed);
+    }
+
+    /** Producer only. Returns true if the oldest frame had to be dropped. */
+    bool Push(const Frame& frame)
+    {
+        if (m_capacity == 0)
+            return true;
+
+        const uint64_t head = m_head.load(std::memory_order_relaxed);
+        uint64_t tail = m_tail.load(std::memory_order_acquire);
+
+        bool dropped = false;
+        while (head - tail >= m_capacity)
+        {
+            // On failure the tail is reloaded, a consumer might have popped already
+            if (m_tail.compare_exchange_weak(tail, tail + 1,
+                        std::memory_order_acq_rel, std::memory_order_acquire))
+            {
+                dropped = true;
+                tail++;
+            }
+        }
+
+        // Orders the slot words after the head and tail loaded above,
+        // pairs with the fence in consumers that copied the slot meanwhile
+        std::atomic_thread_fence(std::memory_order_release);
+        StoreSlot(head & m_mask, frame);
+        m_head.store(head + 1, std::memory_order_release);
+
+        return dropped;
+    }
+
+    /** Consumer only. Removes and returns the oldest frame, false if empty. */
+    bool PopOldest(Frame& frame)
+    {
+        uint64_t tail = m_tail.load(std::memory_order_acquire);
+        for (;;)
+        {
+            const uint64_t head = m_head.load(std::memory_order_acquire);
+            if (tail == head)
+                return false;
+
+            const Frame candidate = LoadSlot(tail & m_mask);
+            // Keeps the slot words loaded before the CAS re-checks the tail
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (m_tail.compare_exchange_strong(tail, tail + 1,
+                        std::memory_order_acq_rel, std::memory_order_acquire))
+            {
+                frame = candidate;
+                return true;
+            }
+        }
+    }
+
+    /** Consumer only. Returns the latest frame without removing it, false if empty. */
+    bool PeekLatest(Frame& frame) const
+    {
+        for (;;)
+        {
+            const uint64_t head = m_head.load(std::memory_order_acquire);
+            if (head == m_tail.load(std::memory_order_acquire))
+                return false;
+
+            const Frame candidate = LoadSlot((head - 1) & m_mask);
+
+            // The slot is rewritten once the producer gets a whole lap ahead.
+            // Keeps the slot words loaded before the head is re-checked.
+            std::atomic_thread_fence(std::memory_order_acquire);
+            const uint64_t headAfter = m_head.load(std::memory_order_relaxed);
+            if (headAfter - head < m_mask)
+            {
+                frame = candidate;
+                return true;
+            }
+        }
+    }
+
+    size_t Size() const
+    {
+        const uint64_t tail = m_tail.load(std::memory_order_acquire);
+        const uint64_t head = m_head.load(std::memory_order_acquire);
+        return (head > tail) ? (size_t)(head - tail) : 0;
+    }
+
+    bool Empty() const
+    {
+        return Size() == 0;
+    }
+
+    size_t Capacity() const
+    {
+        return m_capacity;
+    }
+
+private:
+    static constexpr size_t SLOT_WORDS = (sizeof(Frame) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+    struct Slot
+    {
+        std::atomic<uint64_t> words[SLOT_WORDS];
+    };
+
+    void StoreSlot(size_t index, const Frame& frame)
+    {
+        uint64_t words[SLOT_WORDS]{};
+        memcpy(words, &frame, sizeof(Frame));
+        for (size_t n = 0; n < SLOT_WORDS; n++)
+            m_slots[index].words[n].store(words[n], std::memory_order_relaxed);
+    }
+
+    Frame LoadSlot(size_t index) const
+    {
+        uint64_t words[SLOT_WORDS];
+        for (size_t n = 0; n < SLOT_WORDS; n++)
+            words[n] = m_slots[index].words[n].load(std::memory_order_relaxed);
+        Frame frame;
+        memcpy(&frame, words, sizeof(Frame));
+        return frame;
+    }
+
+    std::unique_ptr<Slot[]> m_slots{};
+    uint64_t m_mask{ 0 };
+    size_t m_capacity{ 0 };
+
+    // Head and tail are padded to separate cache lines to avoid false sharing
+    // between the callback thread and the thread calling get_frame.
+    char m_pad0[CACHE_LINE_SIZE]{};
+    std::atomic<uint64_t> m_head{ 0 }; // Next slot to write, owned by producer
+    char m_pad1[CACHE_LINE_SIZE - sizeof(std::atomic<uint64_t>)]{};
+    std::atomic<uint64_t> m_tail{ 0 }; // Oldest valid slot, advanced by both sides
+    char m_pad2[CACHE_LINE_SIZE - sizeof(std::atomic<uint64_t>)]{};
+};
+
+#endif // PYVCAM_FRAME_RING_H
@@ -0,0 +1,476 @@
+#ifndef PYVCAM_FRAME_SLOTS_H
+#define PYVCAM_FRAME_SLOTS_H
+
+// PVCAM
+#include <master.h>
+#include <pvcam.h>
+
+// System
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+// Local
+#include "task_thread.h"
+
+// Local constants
+
+static constexpr uns32 FRAME_SLOTS_SPARE = 2; // Slots always left to PVCAM for new frames
+
+// Local types
+
+class FrameSlots;
+
+/**
+ * Keeps one frame slot pinned while alive. Shared by all objects pointing to
+ * the frame, the last one releases the slot.
+ *
+ * If PVCAM runs short of free slots while the frame has no exports, the frame
+ * is copied out of the slot and the slot gets unlocked. Objects holding just
+ * the pin must resolve pointers to the frame right before every use then,
+ * objects keeping pointers hold a FrameSlotExport instead.
+ */
+class FrameSlotPin
+{
+public:
+    FrameSlotPin(std::shared_ptr<FrameSlots> slots, uint64_t generation, uns32 slot,
+            const void* slotData, size_t slotBytes)
+        : m_slots(std::move(slots)), m_generation(generation), m_slot(slot),
+        m_slotData(static_cast<const uint8_t*>(slotData)), m_slotBytes(slotBytes)
+    {
+    }
+
+    FrameSlotPin(const FrameSlotPin&) = delete;
+    FrameSlotPin& operator=(const FrameSlotPin&) = delete;
+
+    inline ~FrameSlotPin();
+
+    /** Maps pointer into the slot to the frame copy if the frame was copied out. */
+    void* Resolve(const void* data) const
+    {
+        const uint8_t* copy = m_copyData.load(std::memory_order_acquire);
+        const auto* bytes = static_cast<const uint8_t*>(data);
+        if (!copy || bytes < m_slotData || bytes >= m_slotData + m_slotBytes)
+            return const_cast<void*>(data);
+        return const_cast<uint8_t*>(copy + (bytes - m_slotData));
+    }
+
+private:
+    friend class FrameSlots;
+    friend class FrameSlotExport;
+
+    std::shared_ptr<FrameSlots> m_slots;
+    uint64_t m_generation;
+    uns32 m_slot;
+    const uint8_t* m_slotData;
+    size_t m_slotBytes;
+    uns32 m_exports{ 0 }; // Guarded by FrameSlots mutex
+    std::unique_ptr<uint8_t[]> m_copy{}; // Set once, with FrameSlots mutex locked
+    std::atomic<const uint8_t*> m_copyData{ nullptr };
+};
+
+/**
+ * Keeps pinned frame at its address while alive, held by objects keeping raw
+ * pointers to the frame like arrays, buffer views and DLPack tensors. A frame
+ * with exports is never copied out, its slot stays locked until the last
+ * export and pin are released. Pointers resolved by the export stay valid.
+ * Does nothing without a pin.
+ */
+class FrameSlotExport
+{
+public:
+    FrameSlotExport() = default;
+
+    inline explicit FrameSlotExport(std::shared_ptr<FrameSlotPin> pin);
+
+    FrameSlotExport(FrameSlotExport&& other) noexcept
+        : m_pin(std::move(other.m_pin))
+    {
+    }
+
+    FrameSlotExport& operator=(FrameSlotExport&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Release();
+            m_pin = std::move(other.m_pin);
+        }
+        return *this;
+    }
+
+    FrameSlotExport(const FrameSlotExport&) = delete;
+    FrameSlotExport& operator=(const FrameSlotExport&) = delete;
+
+    ~FrameSlotExport()
+    {
+        Release();
+    }
+
+    void* Resolve(const void* data) const
+    {
+        return (m_pin) ? m_pin->Resolve(data) : const_cast<void*>(data);
+    }
+
+    inline void Release();
+
+private:
+    std::shared_ptr<FrameSlotPin> m_pin{};
+};
+
+/**
+ * Tracks frames locked in the circular acquisition buffer and pins on them.
+ *
+ * With pinning enabled, live acquisition runs in CIRC_NO_OVERWRITE mode where
+ * PVCAM doesn't overwrite a frame until it is unlocked, always the oldest one
+ * first. The EOF callback records every new frame as locked and unlocks the
+ * oldest frames lazily, only while more than the slot count minus
+ * FRAME_SLOTS_SPARE frames are locked. The frames thus stay intact as long as
+ * possible.
+ *
+ * PVCAM unlocks frames only in order, so a pinned oldest frame holds back all
+ * later ones, the spare slots take new frames meanwhile. Once they are taken,
+ * a pinned frame without exports is copied out of its slot and unlocked by
+ * a worker thread, counted as forced copy. A frame with exports stays locked
+ * until they are released, PVCAM discards new frames when all slots are
+ * locked, counted as dropped frames. The callback never copies or allocates.
+ */
+class FrameSlots : public std::enable_shared_from_this<FrameSlots>
+{
+public:
+    struct Stats
+    {
+        uint64_t pins{ 0 }; // Frames pinned since setup
+        uint64_t forcedCopies{ 0 }; // Frames copied as they couldn't be pinned or kept pinned
+        uint64_t droppedFrames{ 0 }; // Frames PVCAM discarded while all slots were locked
+        uint64_t unlockErrors{ 0 };
+        uns32 pinnedSlots{ 0 }; // Slots pinned at the moment
+        uns32 lockedSlots{ 0 }; // Slots PVCAM doesn't write at the moment
+    };
+
+    /**
+     * Prepares for new acquisition, must not run concurrently with the callback.
+     * Pins of previous acquisition don't apply anymore.
+     */
+    void Reset(int16 hcam, const void* base, size_t slotBytes, uns32 slotCount,
+            bool enabled)
+    {
+        m_copyThread.Stop(); // Never joined with the lock held, the task needs it
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_generation++;
+        m_hcam = hcam;
+        m_base = static_cast<const uint8_t*>(base);
+        m_slotBytes = slotBytes;
+        m_enabled = enabled && slotBytes != 0 && slotCount > 1;
+        m_active = m_enabled;
+        m_maxLocked = slotCount - (std::min)(FRAME_SLOTS_SPARE, slotCount - 1);
+        m_slotPins.assign((m_enabled) ? slotCount : 0, std::weak_ptr<FrameSlotPin>());
+        m_slotPinPtrs.assign((m_enabled) ? slotCount : 0, nullptr);
+        m_slotFrame.assign((m_enabled) ? slotCount : 0, 0);
+        m_slotLocked.assign((m_enabled) ? slotCount : 0, false);
+        m_locked.clear();
+        m_nextSlot = 0;
+        m_lastFrameNr = 0;
+        m_bufferFull = false;
+        m_stats = Stats();
+        // Without the thread pinned frames are never copied out, only held longer
+        if (m_enabled)
+            m_copyThread.Start([this]() { CopyOutPinned(); });
+    }
+
+    /** Stops unlocking, called before the acquisition is finished or aborted. */
+    void Stop()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_active = false;
+        }
+        m_copyThread.Cancel();
+    }
+
+    /**
+     * Forgets the camera, called before it gets closed. Pins still alive never
+     * call PVCAM then, even if the acquisition was not stopped. Also stops the
+     * worker thread, so it must be called before the owner drops its reference,
+     * the thread must never release the last one.
+     */
+    void Close()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_generation++;
+            m_hcam = -1;
+            m_enabled = false;
+            m_active = false;
+        }
+        m_copyThread.Stop();
+    }
+
+    bool IsEnabled() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_enabled;
+    }
+
+    /** Returns max. frames kept locked, the queue should not hold more of them. */
+    uns32 GetMaxLocked() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_maxLocked;
+    }
+
+    /** Returns true if any pin of this or previous acquisition is alive. */
+    bool HasPins() const
+    {
+        return m_livePins.load() > 0;
+    }
+
+    /**
+     * Callback only. Records new frame as locked and unlocks the oldest frames
+     * not pinned if too many are locked. Frame number is the 1-based FrameNr
+     * reported by PVCAM. Returns false if PVCAM failed to unlock.
+     */
+    bool OnNewFrame(const void* address, uns32 frameCount, uns32 frameNr)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_active)
+            return true;
+        const uns32 slotCount = (uns32)m_slotPins.size();
+        // Frames missing since the last one filled all slots had no room in the buffer
+        if (m_bufferFull && frameNr > m_lastFrameNr + 1)
+            m_stats.droppedFrames += frameNr - m_lastFrameNr - 1;
+        m_lastFrameNr = frameNr;
+        uns32 slot;
+        if (!GetSlot(address, slot) || m_slotLocked[slot])
+        {
+            m_stats.unlockErrors++; // Out of sync with PVCAM
+            return false;
+        }
+        // PVCAM fills slots in order, frames without callback are locked too
+        for (uns32 skipped = m_nextSlot; skipped != slot; skipped = (skipped + 1) % slotCount)
+        {
+            if (m_slotLocked[skipped])
+                break;
+            m_slotLocked[skipped] = true;
+            m_slotFrame[skipped] = 0; // Unknown, never pinned
+            m_locked.push_back(skipped);
+        }
+        m_slotLocked[slot] = true;
+        m_slotFrame[slot] = frameCount;
+        m_locked.push_back(slot);
+        m_nextSlot = (slot + 1) % slotCount;
+        m_bufferFull = m_locked.size() == slotCount;
+        return UnlockExcess();
+    }
+
+    /**
+     * Pins the slot with given frame if it is still locked, sharing the pin
+     * already alive if any. Returns empty pointer if the frame may have been
+     * overwritten already or pinning is disabled.
+     */
+    std::shared_ptr<FrameSlotPin> Pin(const void* address, uns32 frameCount)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        uns32 slot;
+        if (!m_active || !GetSlot(address, slot) || !m_slotLocked[slot]
+                || m_slotFrame[slot] != frameCount)
+            return std::shared_ptr<FrameSlotPin>();
+        std::shared_ptr<FrameSlotPin> pin = m_slotPins[slot].lock();
+        if (pin)
+            return pin;
+        // Any pin left is being destroyed, it releases nothing once replaced
+        pin = std::make_shared<FrameSlotPin>(shared_from_this(), m_generation, slot,
+                address, m_slotBytes);
+        m_slotPins[slot] = pin;
+        m_slotPinPtrs[slot] = pin.get();
+        m_livePins++;
+        m_stats.pins++;
+        return pin;
+    }
+
+    void CountForcedCopy()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stats.forcedCopies++;
+    }
+
+    Stats GetStats() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Stats stats = m_stats;
+        stats.pinnedSlots = (uns32)std::count_if(m_slotPinPtrs.begin(), m_slotPinPtrs.end(),
+                [](const FrameSlotPin* pin) { return pin != nullptr; });
+        stats.lockedSlots = (uns32)m_locked.size();
+        return stats;
+    }
+
+private:
+    friend class FrameSlotPin;
+    friend class FrameSlotExport;
+
+    void Unpin(FrameSlotPin* pin)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_livePins--;
+        if (pin->m_generation != m_generation || m_slotPinPtrs[pin->m_slot] != pin)
+            return; // Set up again, camera closed or frame copied out in the meantime
+        m_slotPinPtrs[pin->m_slot] = nullptr;
+        m_slotPins[pin->m_slot].reset();
+        if (m_active)
+            UnlockExcess(); // PVCAM might have no free slot and wait for this one
+    }
+
+    void AddExport(FrameSlotPin* pin)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        pin->m_exports++;
+    }
+
+    void ReleaseExport(FrameSlotPin* pin)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (--pin->m_exports == 0 && CanCopyOutOldest())
+            m_copyThread.Signal();
+    }
+
+    /** Expects the lock. */
+    bool GetSlot(const void* address, uns32& slot) const
+    {
+        const auto* bytes = static_cast<const uint8_t*>(address);
+        if (bytes < m_base)
+            return false;
+        const size_t offset = (size_t)(bytes - m_base);
+        if (offset % m_slotBytes != 0 || offset / m_slotBytes >= m_slotPins.size())
+            return false;
+        slot = (uns32)(offset / m_slotBytes);
+        return true;
+    }
+
+    /**
+     * Expects the lock. Returns true if the oldest frame is pinned without
+     * exports and PVCAM already uses the spare slots.
+     */
+    bool CanCopyOutOldest() const
+    {
+        if (!m_active || m_locked.size() <= m_maxLocked)
+            return false;
+        const FrameSlotPin* pin = m_slotPinPtrs[m_locked.front()];
+        return pin && pin->m_exports == 0;
+    }
+
+    /**
+     * Expects the lock. Unlocks the oldest frames not pinned over the limit.
+     * Stops at a pinned frame, lets the worker thread copy it out if possible.
+     */
+    bool UnlockExcess()
+    {
+        while (m_locked.size() > m_maxLocked)
+        {
+            const uns32 slot = m_locked.front();
+            if (m_slotPinPtrs[slot])
+            {
+                if (CanCopyOutOldest())
+                    m_copyThread.Signal();
+                break;
+            }
+            // PVCAM wants the oldest frame to be retrieved before it gets unlocked
+            void* address;
+            FRAME_INFO fi;
+            if (!pl_exp_get_oldest_frame_ex(m_hcam, &address, &fi)
+                    || !pl_exp_unlock_oldest_frame(m_hcam))
+            {
+                m_stats.unlockErrors++;
+                return false;
+            }
+            m_slotLocked[slot] = false;
+            m_locked.pop_front();
+        }
+        return true;
+    }
+
+    /**
+     * Worker thread task. Copies pinned frames without exports out of their
+     * slots, the oldest first, while PVCAM uses the spare slots. The copy is
+     * made without the lock, the pin held meanwhile keeps the slot locked.
+     * It is dropped if the frame got an export in the meantime.
+     */
+    void CopyOutPinned()
+    {
+        for (;;)
+        {
+            std::shared_ptr<FrameSlotPin> pin; // Released without the lock, might call Unpin
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (!CanCopyOutOldest())
+                    return;
+                // Empty if the last pin is being destroyed, Unpin unlocks the slot then
+                pin = m_slotPins[m_locked.front()].lock();
+                if (!pin)
+                    return;
+            }
+            std::unique_ptr<uint8_t[]> copy(new(std::nothrow) uint8_t[pin->m_slotBytes]);
+            if (!copy)
+                return; // PVCAM discards new frames until the pin is released
+            memcpy(copy.get(), pin->m_slotData, pin->m_slotBytes);
+
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!CanCopyOutOldest() || m_slotPinPtrs[m_locked.front()] != pin.get())
+                continue;
+            pin->m_copy = std::move(copy);
+            pin->m_copyData.store(pin->m_copy.get(), std::memory_order_release);
+            m_slotPinPtrs[pin->m_slot] = nullptr;
+            m_slotPins[pin->m_slot].reset();
+            m_stats.forcedCopies++;
+            UnlockExcess();
+        }
+    }
+
+    mutable std::mutex m_mutex{};
+    uint64_t m_generation{ 0 };
+    int16 m_hcam{ -1 };
+    const uint8_t* m_base{ nullptr };
+    size_t m_slotBytes{ 0 };
+    bool m_enabled{ false };
+    bool m_active{ false };
+    uns32 m_maxLocked{ 0 };
+    std::vector<std::weak_ptr<FrameSlotPin>> m_slotPins{}; // Pin shared by objects per slot
+    // Pin holding the slot, cleared by Unpin before the pin is destroyed
+    std::vector<FrameSlotPin*> m_slotPinPtrs{};
+    std::vector<uns32> m_slotFrame{}; // Frame count of the frame locked in slot
+    std::vector<bool> m_slotLocked{};
+    std::deque<uns32> m_locked{}; // Locked slots, the oldest frame first
+    uns32 m_nextSlot{ 0 }; // Slot PVCAM fills next
+    uns32 m_lastFrameNr{ 0 };
+    bool m_bufferFull{ false }; // All slots locked once the last frame arrived
+    std::atomic<uns32> m_livePins{ 0 };
+    Stats m_stats{};
+    TaskThread m_copyThread{}; // Declared last, stopped before other members are destroyed
+};
+
+inline FrameSlotPin::~FrameSlotPin()
+{
+    m_slots->Unpin(this);
+}
+
+inline FrameSlotExport::FrameSlotExport(std::shared_ptr<FrameSlotPin> pin)
+    : m_pin(std::move(pin))
+{
+    if (m_pin)
+        m_pin->m_slots->AddExport(m_pin.get());
+}
+
+inline void FrameSlotExport::Release()
+{
+    if (!m_pin)
+        return;
+    m_pin->m_slots->ReleaseExport(m_pin.get());
+    m_pin.reset();
+}
+
+#endif // PYVCAM_FRAME_SLOTS_H
@@ -0,0 +1,267 @@
+#ifndef PYVCAM_IO_URING_WRITER_H
+#define PYVCAM_IO_URING_WRITER_H
+
+// The io_uring interface is used directly via system calls,
+// liburing is needed neither at build time nor at run time.
+#if defined(__linux__) && defined(__has_include)
+    #if __has_include(<linux/io_uring.h>)
+        #define PYVCAM_HAS_IO_URING 1
+    #endif
+#endif
+
+#ifdef PYVCAM_HAS_IO_URING
+
+// System
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#include <linux/io_uring.h>
+#include <sys/mman.h> // mmap
+#include <sys/syscall.h> // syscall
+#include <sys/uio.h> // iovec
+#include <unistd.h> // close
+
+// The numbers are the same on all architectures, older C libraries don't know them
+#ifndef __NR_io_uring_setup
+    #define __NR_io_uring_setup 425
+#endif
+#ifndef __NR_io_uring_enter
+    #define __NR_io_uring_enter 426
+#endif
+#ifndef __NR_io_uring_register
+    #define __NR_io_uring_register 427
+#endif
+
+/**
+ * Minimal io_uring submission and completion queue pair for file writes.
+ *
+ * The file is registered as fixed file. The data buffer is registered too
+ * if the kernel and RLIMIT_MEMLOCK allow it, otherwise plain writes are used.
+ * Not thread-safe, the writes must be submitted and reaped by one thread.
+ */
+class IoUringWriter
+{
+public:
+    IoUringWriter() = default;
+    IoUringWriter(const IoUringWriter&) = delete;
+    IoUringWriter& operator=(const IoUringWriter&) = delete;
+
+    ~IoUringWriter()
+    {
+        Close();
+    }
+
+    /** Returns false if io_uring is not available, e.g. old kernel or seccomp. */
+    bool Open(int fd, void* buffer, size_t bufferBytes, unsigned depth)
+    {
+        Close();
+
+        io_uring_params params;
+        memset(&params, 0, sizeof(params));
+        m_ringFd = (int)syscall(__NR_io_uring_setup, depth, &params);
+        if (m_ringFd < 0)
+        {
+            m_ringFd = -1;
+            return false;
+        }
+
+        m_sqRingBytes = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+        m_cqRingBytes = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+        if (params.features & IORING_FEAT_SINGLE_MMAP)
+        {
+            if (m_cqRingBytes > m_sqRingBytes)
+                m_sqRingBytes = m_cqRingBytes;
+            m_cqRingBytes = 0;
+        }
+
+        m_sqRing = mmap(NULL, m_sqRingBytes, PROT_READ | PROT_WRITE,
+                MAP_SHARED | MAP_POPULATE, m_ringFd, IORING_OFF_SQ_RING);
+        if (m_sqRing == MAP_FAILED)
+        {
+            m_sqRing = NULL;
+            Close();
+            return false;
+        }
+        if (m_cqRingBytes == 0)
+        {
+            m_cqRing = m_sqRing;
+        }
+        else
+        {
+            m_cqRing = mmap(NULL, m_cqRingBytes, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, m_ringFd, IORING_OFF_CQ_RING);
+            if (m_cqRing == MAP_FAILED)
+            {
+                m_cqRing = NULL;
+                Close();
+                return false;
+            }
+        }
+        m_sqesBytes = params.sq_entries * sizeof(io_uring_sqe);
+        void* sqes = mmap(NULL, m_sqesBytes, PROT_READ | PROT_WRITE,
+                MAP_SHARED | MAP_POPULATE, m_ringFd, IORING_OFF_SQES);
+        if (sqes == MAP_FAILED)
+        {
+            Close();
+            return false;
+        }
+        m_sqes = static_cast<io_uring_sqe*>(sqes);
+
+        auto* sq = static_cast<uint8_t*>(m_sqRing);
+        m_sqTail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+        m_sqMask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+        m_sqArray = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+        auto* cq = static_cast<uint8_t*>(m_cqRing);
+        m_cqHead = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+        m_cqTail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+        m_cqMask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+        m_cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+        m_depth = params.sq_entries;
+
+        if (syscall(__NR_io_uring_register, m_ringFd, IORING_REGISTER_FILES, &fd, 1) < 0)
+        {
+            Close();
+            return false;
+        }
+
+        iovec iov;
+        iov.iov_base = buffer;
+        iov.iov_len = bufferBytes;
+        m_bufferRegistered =
+            syscall(__NR_io_uring_register, m_ringFd, IORING_REGISTER_BUFFERS, &iov, 1) == 0;
+
+        return true;
+    }
+
+    void Close()
+    {
+        if (m_sqes)
+            munmap(m_sqes, m_sqesBytes);
+        if (m_cqRing && m_cqRing != m_sqRing)
+            munmap(m_cqRing, m_cqRingBytes);
+        if (m_sqRing)
+            munmap(m_sqRing, m_sqRingBytes);
+        if (m_ringFd >= 0)
+            close(m_ringFd); // Unregisters the file and buffer too
+        m_sqes = NULL;
+        m_cqRing = NULL;
+        m_sqRing = NULL;
+        m_ringFd = -1;
+        m_inFlight = 0;
+        m_bufferRegistered = false;
+    }
+
+    /** Max. number of writes in flight. */
+    unsigned Depth() const
+    {
+        return m_depth;
+    }
+
+    unsigned InFlight() const
+    {
+        return m_inFlight;
+    }
+
+    bool IsBufferRegistered() const
+    {
+        return m_bufferRegistered;
+    }
+
+    /**
+     * Queues a write of data from the registered buffer at given file offset.
+     * The tag is passed back on completion. Fails if Depth() writes are in flight.
+     */
+    bool Submit(const void* data, uint32_t bytes, uint64_t fileOffset, uint64_t tag)
+    {
+        if (m_inFlight >= m_depth)
+            return false;
+
+        const unsigned tail = *m_sqTail; // Written by this thread only
+        const unsigned index = tail & m_sqMask;
+        io_uring_sqe* sqe = &m_sqes[index];
+        memset(sqe, 0, sizeof(*sqe));
+        sqe->opcode = (m_bufferRegistered) ? IORING_OP_WRITE_FIXED : IORING_OP_WRITE;
+        sqe->flags = IOSQE_FIXED_FILE;
+        sqe->fd = 0; // Index in registered files
+        sqe->addr = (uint64_t)(uintptr_t)data;
+        sqe->len = bytes;
+        sqe->off = fileOffset;
+        sqe->buf_index = 0;
+        sqe->user_data = tag;
+        m_sqArray[index] = index;
+        __atomic_store_n(m_sqTail, tail + 1, __ATOMIC_RELEASE);
+
+        int res;
+        do
+        {
+            res = (int)syscall(__NR_io_uring_enter, m_ringFd, 1, 0, 0, NULL, 0);
+        } while (res < 0 && errno == EINTR);
+        if (res < 1)
+            return false;
+
+        m_inFlight++;
+        return true;
+    }
+
+    /**
+     * Waits for at least minComplete writes and calls handler(tag, result)
+     * for every completed one. The result is bytes written or negative errno.
+     */
+    template<typename Handler>
+    bool Reap(unsigned minComplete, Handler handler)
+    {
+        if (minComplete > m_inFlight)
+            minComplete = m_inFlight;
+
+        unsigned head = *m_cqHead; // Written by this thread only
+        unsigned reaped = 0;
+        for (;;)
+        {
+            const unsigned tail = __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE);
+            while (head != tail)
+            {
+                const io_uring_cqe& cqe = m_cqes[head & m_cqMask];
+                handler(cqe.user_data, cqe.res);
+                head++;
+                reaped++;
+                m_inFlight--;
+            }
+            __atomic_store_n(m_cqHead, head, __ATOMIC_RELEASE);
+
+            if (reaped >= minComplete)
+                return true;
+
+            const int res = (int)syscall(__NR_io_uring_enter, m_ringFd, 0,
+                    minComplete - reaped, IORING_ENTER_GETEVENTS, NULL, 0);
+            if (res < 0 && errno != EINTR)
+                return false;
+        }
+    }
+
+private:
+    int m_ringFd{ -1 };
+    void* m_sqRing{ NULL };
+    void* m_cqRing{ NULL };
+    size_t m_sqRingBytes{ 0 };
+    size_t m_cqRingBytes{ 0 };
+    io_uring_sqe* m_sqes{ NULL };
+    size_t m_sqesBytes{ 0 };
+
+    unsigned* m_sqTail{ NULL };
+    unsigned m_sqMask{ 0 };
+    unsigned* m_sqArray{ NULL };
+    unsigned* m_cqHead{ NULL };
+    unsigned* m_cqTail{ NULL };
+    unsigned m_cqMask{ 0 };
+    io_uring_cqe* m_cqes{ NULL };
+
+    unsigned m_depth{ 0 };
+    unsigned m_inFlight{ 0 };
+    bool m_bufferRegistered{ false };
+};
+
+#endif // PYVCAM_HAS_IO_URING
+
+#endif // PYVCAM_IO_URING_WRITER_H
@@ -0,0 +1,201 @@
+#ifndef PYVCAM_PARAM_CACHE_H
+#define PYVCAM_PARAM_CACHE_H
+
+// PVCAM
+#include <master.h>
+#include <pvcam.h>
+
+// System
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+
+/**
+ * Per-camera cache of parameter attributes that don't change while settings
+ * stay the same, so reading a parameter doesn't cost extra round trips.
+ *
+ * ATTR_TYPE never changes and is kept until the camera is closed.
+ * ATTR_AVAIL, ATTR_ACCESS, ATTR_COUNT, ATTR_MIN, ATTR_MAX and ATTR_INCREMENT
+ * may depend on other settings, e.g. the gain range on selected speed or
+ * the PP_PARAM range on selected PP feature and parameter. These are dropped
+ * whenever a parameter that others depend on is set, and also when a parameter
+ * is set, its own attributes are dropped. ATTR_CURRENT, ATTR_DEFAULT and
+ * ATTR_LIVE are never cached.
+ *
+ * The list of parameters others depend on can't be complete for all cameras,
+ * thus the cache is disabled until enabled by the user.
+ *
+ * Value is the union holding any parameter value. Values holding pointers,
+ * i.e. smart streaming ranges, must not be stored by the caller.
+ */
+template<typename Value>
+class ParamCache
+{
+public:
+    struct Stats
+    {
+        uint64_t hits{ 0 };
+        uint64_t misses{ 0 }; // Lookups of cacheable attributes not found
+        uint64_t invalidations{ 0 }; // Times dependent attributes were dropped
+        size_t entries{ 0 };
+    };
+
+    static bool IsCacheable(int16 attr)
+    {
+        switch (attr)
+        {
+        case ATTR_TYPE:
+        case ATTR_AVAIL:
+        case ATTR_ACCESS:
+        case ATTR_COUNT:
+        case ATTR_MIN:
+        case ATTR_MAX:
+        case ATTR_INCREMENT:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    /** Returns true if setting given parameter may change attributes of others. */
+    static bool IsDependency(uns32 paramId)
+    {
+        switch (paramId)
+        {
+        // Speed table
+        case PARAM_READOUT_PORT:
+        case PARAM_SPDTAB_INDEX:
+        case PARAM_GAIN_INDEX:
+        // Post-processing feature and parameter selection
+        case PARAM_PP_INDEX:
+        case PARAM_PP_PARAM_INDEX:
+        case PARAM_PP_PARAM:
+        // Other modes enabling or limiting other parameters
+        case PARAM_EXPOSURE_MODE:
+        case PARAM_EXPOSE_OUT_MODE:
+        case PARAM_BINNING_SER:
+        case PARAM_BINNING_PAR:
+        case PARAM_PMODE:
+        case PARAM_CLEAR_MODE:
+        case PARAM_EXP_RES:
+        case PARAM_EXP_RES_INDEX:
+        case PARAM_SCAN_MODE:
+        case PARAM_TRIGTAB_SIGNAL:
+        case PARAM_CENTROIDS_ENABLED:
+        case PARAM_CENTROIDS_MODE:
+        case PARAM_IMAGE_FORMAT:
+        case PARAM_IMAGE_COMPRESSION:
+        case PARAM_SMART_STREAM_MODE_ENABLED:
+        case PARAM_HOST_FRAME_SUMMING_ENABLED:
+            return true;
+        default:
+            return false;
+        }
+    }
+
+    /** Copies cached value to given one and returns true if found. */
+    bool Get(uns32 paramId, int16 attr, Value& value)
+    {
+        if (!IsCacheable(attr))
+            return false;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (!m_enabled)
+            return false;
+        const auto it = m_entries.find(Key(paramId, attr));
+        if (it == m_entries.end())
+        {
+            m_stats.misses++;
+            return false;
+        }
+        m_stats.hits++;
+        value = it->second;
+        return true;
+    }
+
+    /** Stores value read from camera, ignored for attributes not cacheable. */
+    void Put(uns32 paramId, int16 attr, const Value& value)
+    {
+        if (!IsCacheable(attr))
+            return;
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_enabled)
+            m_entries[Key(paramId, attr)] = value;
+    }
+
+    /** Drops attributes that may have changed by successful set of given parameter. */
+    void OnSet(uns32 paramId)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (IsDependency(paramId))
+        {
+            DropAllButType();
+            return;
+        }
+        for (const int16 attr : { ATTR_AVAIL, ATTR_ACCESS, ATTR_COUNT, ATTR_MIN, ATTR_MAX,
+                ATTR_INCREMENT })
+        {
+            m_entries.erase(Key(paramId, attr));
+        }
+    }
+
+    /** Drops all attributes that may depend on settings, e.g. after PP reset. */
+    void Invalidate()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        DropAllButType();
+    }
+
+    /** Drops everything, disabled cache is always empty. */
+    void SetEnabled(bool enabled)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_enabled = enabled;
+        m_entries.clear();
+    }
+
+    bool IsEnabled() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_enabled;
+    }
+
+    Stats GetStats() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        Stats stats = m_stats;
+        stats.entries = m_entries.size();
+        return stats;
+    }
+
+    void ResetStats()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stats = Stats();
+    }
+
+private:
+    static uint64_t Key(uns32 paramId, int16 attr)
+    {
+        return ((uint64_t)paramId << 16) | (uns16)attr;
+    }
+
+    /** Expects the lock. */
+    void DropAllButType()
+    {
+        for (auto it = m_entries.begin(); it != m_entries.end();)
+        {
+            if ((int16)(it->first & 0xFFFF) == ATTR_TYPE)
+                ++it;
+            else
+                it = m_entries.erase(it);
+        }
+        m_stats.invalidations++;
+    }
+
+    mutable std::mutex m_mutex{};
+    std::unordered_map<uint64_t, Value> m_entries{};
+    Stats m_stats{};
+    bool m_enabled{ false };
+};
+
+#endif // PYVCAM_PARAM_CACHE_H
@@ -0,0 +1,88 @@
+#ifndef PYVCAM_PARTICLES_H
+#define PYVCAM_PARTICLES_H
+
+// PVCAM
+#include <master.h>
+#include <pvcam.h>
+
+// System
+#include <cstring>
+
+// Decoding of particle IDs and moments from extended metadata of ROIs,
+// reported by cameras in centroids modes. The values are stored in columns
+// with one row per ROI in the order of ROI headers, so callers can wrap them
+// in arrays without creating an object per particle.
+
+struct ParticleColumns
+{
+    uns32* ids{ nullptr };
+    uns32* m0{ nullptr };
+    uns32* m2{ nullptr };
+    uns8* valid{ nullptr }; // Non-zero if the ROI carried any particle tag
+};
+
+/** Reads integer scalar value of extended metadata item, false for other types. */
+static inline bool GetExtMdItemUns32(const md_ext_item& item, uns32& value)
+{
+    const uns8* p = (const uns8*)item.value;
+    switch (item.tagInfo->type)
+    {
+    case TYPE_INT8:
+    case TYPE_UNS8: value = *p; return true;
+    case TYPE_INT16:
+    case TYPE_UNS16: { uns16 v; memcpy(&v, p, sizeof(v)); value = v; return true; }
+    case TYPE_INT32:
+    case TYPE_UNS32:
+    case TYPE_ENUM: memcpy(&value, p, sizeof(value)); return true;
+    case TYPE_INT64:
+    case TYPE_UNS64: { ulong64 v; memcpy(&v, p, sizeof(v)); value = (uns32)v; return true; }
+    default: return false;
+    }
+}
+
+/** Returns true if any ROI of decoded frame has extended metadata. */
+static inline bool HasParticleExtMd(const md_frame* mdFrame)
+{
+    for (uns16 i = 0; i < mdFrame->header->roiCount; i++)
+    {
+        if (mdFrame->roiArray[i].extMdData && mdFrame->roiArray[i].extMdDataSize > 0)
+            return true;
+    }
+    return false;
+}
+
+/**
+ * Fills the columns with particle data of all ROIs in decoded frame. The columns
+ * have a row per ROI and must be zeroed, rows of ROIs without particle tags stay
+ * zero. Returns false on PVCAM error.
+ */
+static inline bool DecodeParticles(const md_frame* mdFrame, const ParticleColumns& columns)
+{
+    // Rather big, but only filled up to the number of tags found
+    md_ext_item_collection collection;
+    for (uns16 i = 0; i < mdFrame->header->roiCount; i++)
+    {
+        const md_frame_roi& mdRoi = mdFrame->roiArray[i];
+        if (!mdRoi.extMdData || mdRoi.extMdDataSize == 0)
+            continue;
+        if (!pl_md_read_extended(&collection, mdRoi.extMdData, mdRoi.extMdDataSize))
+            return false;
+        for (uns16 n = 0; n < collection.count; n++)
+        {
+            const md_ext_item& item = collection.list[n];
+            uns32* column;
+            switch (item.tagInfo->tag)
+            {
+            case PL_MD_EXT_TAG_PARTICLE_ID: column = columns.ids; break;
+            case PL_MD_EXT_TAG_PARTICLE_M0: column = columns.m0; break;
+            case PL_MD_EXT_TAG_PARTICLE_M2: column = columns.m2; break;
+            default: continue;
+            }
+            if (GetExtMdItemUns32(item, column[i]))
+                columns.valid[i] = 1;
+        }
+    }
+    return true;
+}
+
+#endif // PYVCAM_PARTICLES_H
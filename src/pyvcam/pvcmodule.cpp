@@ -7,81 +7,110 @@
 #include <master.h>
 #include <pvcam.h>
 
+// Local
+#include "acq_buffer.h"
+#include "bitpack.h"
+#include "dlpack.h"
+#include "frame_handler.h"
+#include "frame_ring.h"
+#include "frame_slots.h"
+#include "param_cache.h"
+#include "particles.h"
+#include "recompose.h"
+#include "stream_file.h"
+#include "stream_writer.h"
+#include "task_thread.h"
+
 // System
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
 #include <cstdint>
 #include <cstdio>
+#include <cstring>
+#include <deque>
 #include <iostream>
 #include <limits>
 #include <map>
 #include <memory>
 #include <mutex>
 #include <new>
-#include <queue>
 #include <string>
 #include <thread>
 #include <vector>
 
 #ifdef _WIN32
     #include <Windows.h>
-    #include <malloc.h> // _aligned_malloc
-    using FileHandle = HANDLE;
-    const/*expr*/ auto cInvalidFileHandle = (FileHandle)INVALID_HANDLE_VALUE;
 #else
-    #include <stdlib.h> // aligned_alloc
     #include <sys/types.h> // open
     #include <sys/stat.h> // open
     #include <fcntl.h> // open
-    #include <unistd.h> // close, write, sysconf
-    using FileHandle = int;
-    constexpr auto cInvalidFileHandle = (FileHandle)-1;
+    #include <unistd.h> // close
+#endif
+
+// Python versions without free-threading support
+#ifndef Py_BEGIN_CRITICAL_SECTION
+    #define Py_BEGIN_CRITICAL_SECTION(op) {
+    #define Py_END_CRITICAL_SECTION() }
+#endif
+#ifndef Py_TPFLAGS_DISALLOW_INSTANTIATION
+    #define Py_TPFLAGS_DISALLOW_INSTANTIATION 0 // tp_new is cleared by ModuleExec
 #endif
 
 // Local constants
 
 static constexpr uns16 MAX_ROIS = 512; // Max 15 ROIs, but up to 512 centroids
-static constexpr uns32 ALIGNMENT_BOUNDARY = 4096;
+static constexpr size_t STREAM_INDEX_RESERVE = 65536; // Index entries allocated upfront
+static constexpr uns32 SEQ_SEGMENT_SLOTS = 16; // Buffer slots rotated by one-frame segments
 
 // Local types
 
-struct AcqBuffer
+enum class MetadataFormat
 {
-    AcqBuffer(size_t size)
-        : size(size)
-    {
-        // Always align frameBuffer on a page boundary.
-        // This is required for non-buffered streaming to disk.
-#ifdef _WIN32
-        data = _aligned_malloc(size, ALIGNMENT_BOUNDARY);
-#else
-        data = aligned_alloc(ALIGNMENT_BOUNDARY, size);
-#endif
-        if (!data)
-            throw std::bad_alloc();
-    }
+    Dict,  // Python dicts per frame and ROI header
+    NumPy, // Structured arrays with MdFrameHeaderRecord and MdRoiHeaderRecord
+};
 
-    ~AcqBuffer()
-    {
-#ifdef _WIN32
-        _aligned_free(data);
-#else
-        free(data);
-#endif
-    }
+#pragma pack(push, 1)
 
-    void* data{ NULL };
-    size_t size;
+/** Decoded md_frame_header or md_frame_header_v3 as stored in NumPy record. */
+struct MdFrameHeaderRecord
+{
+    char signature[4];
+    uns8 version;
+    uns32 frameNr;
+    uns16 roiCount;
+    ulong64 timestampBofPs;
+    ulong64 timestampEofPs;
+    ulong64 exposureTimePs;
+    uns8 bitDepth;
+    uns8 colorMask;
+    uns8 flags;
+    uns16 extendedMdSize;
+    uns8 imageFormat;
+    uns8 imageCompression;
 };
 
-struct Frame
+/** Decoded md_frame_roi_header as stored in NumPy record. */
+struct MdRoiHeaderRecord
 {
-    void* address{ NULL }; // Address within AcqBuffer received from PVCAM
-    uns32 count{ 0 }; // Frame number that resets after every setup
-    uns32 nr{ 0 }; // FrameNr from PVCAM's FRAME_INFO structure
+    uns16 roiNr;
+    uns32 timestampBOR;
+    uns32 timestampEOR;
+    uns16 s1;
+    uns16 s2;
+    uns16 sbin;
+    uns16 p1;
+    uns16 p2;
+    uns16 pbin;
+    uns8 flags;
+    uns16 extendedMdSize;
+    uns32 roiDataSize;
 };
 
+#pragma pack(pop)
+
 union ParamValue
 {
     char val_str[MAX_PP_NAME_LEN];
@@ -104,58 +133,154 @@ union ParamValue
 class Camera
 {
 public:
+    /** Returns metadata structure lent by LendMdFrame back to the camera. */
+    struct MdFrameReturn
+    {
+        Camera* cam;
+        void operator()(md_frame* mdFrame) const
+        {
+            std::lock_guard<std::mutex> lock(cam->m_mutex);
+            cam->m_mdFrames.push_back(mdFrame);
+        }
+    };
+    using MdFramePtr = std::unique_ptr<md_frame, MdFrameReturn>;
+
     Camera()
     {
-        if (!pl_md_create_frame_struct_cont(&m_mdFrame, MAX_ROIS))
+        md_frame* mdFrame;
+        if (!pl_md_create_frame_struct_cont(&mdFrame, MAX_ROIS))
             throw std::bad_alloc();
+        m_mdFrames.push_back(mdFrame);
     }
 
     ~Camera()
     {
-        UnsetStreamToDisk();
+        m_seqRearmThread.Stop(); // The task uses members destroyed below
+        m_frameSlots->Close(); // Pins may outlive the camera
+        std::string streamError;
+        UnsetStreamToDisk(streamError);
         ReleaseAcqBuffer();
-        pl_md_release_frame_struct(m_mdFrame); // Ignore PVCAM errors
+        for (md_frame* mdFrame : m_mdFrames)
+            pl_md_release_frame_struct(mdFrame); // Ignore PVCAM errors
+    }
+
+    /**
+     * Lends a metadata structure for decoding frames, so threads getting frames
+     * concurrently never share one. It gets back to the camera when released.
+     * Expects the lock, returns empty pointer on PVCAM error.
+     */
+    MdFramePtr LendMdFrame()
+    {
+        md_frame* mdFrame;
+        if (!m_mdFrames.empty())
+        {
+            mdFrame = m_mdFrames.back();
+            m_mdFrames.pop_back();
+        }
+        else if (!pl_md_create_frame_struct_cont(&mdFrame, MAX_ROIS))
+        {
+            return MdFramePtr(NULL, MdFrameReturn{ this });
+        }
+        return MdFramePtr(mdFrame, MdFrameReturn{ this });
+    }
+
+    /** Returns true if the current buffer fits given frames. Expects the lock. */
+    bool CanReuseAcqBuffer(uns32 frameCount, uns32 frameBytes) const
+    {
+        // Pinned frames of previous acquisition must stay intact
+        return m_acqBuffer && m_acqBuffer->size == (uint64_t)frameBytes * frameCount
+            && m_acqBuffer->requested == m_acqBufferPolicy && !m_frameSlots->HasPins();
     }
 
-    bool AllocateAcqBuffer(uns32 frameCount, uns32 frameBytes)
+    /**
+     * Returns a buffer for given frames from the pool, allocated and pre-faulted
+     * if needed. Touches neither the camera nor Python, thus can run without
+     * the lock and the GIL. Returns empty pointer on failure.
+     */
+    static std::shared_ptr<AcqBuffer> NewAcqBuffer(uns32 frameCount, uns32 frameBytes,
+            const AcqBufferPolicy& policy)
     {
         // PVCAM supports buffer up to 4GB only
         const uint64_t bufferBytes64 = (uint64_t)frameBytes * frameCount;
         if (bufferBytes64 > (std::numeric_limits<uns32>::max)())
-            return false;
-
-        if (m_acqBuffer && m_acqBuffer->size == bufferBytes64)
-            return true; // Already allocated
-
-        ReleaseAcqBuffer();
+            return std::shared_ptr<AcqBuffer>();
 
         try
         {
-            auto acqBuffer = std::make_shared<AcqBuffer>(bufferBytes64);
-
-            m_acqBuffer = acqBuffer;
-            m_frameCount = frameCount;
-            m_frameBytes = frameBytes;
+            // Buffers still referenced by NumPy arrays get back to the pool later
+            return AcqBufferPool::Instance().Acquire(bufferBytes64, policy);
         }
         catch (const std::bad_alloc& /*ex*/)
         {
-            return false;
+            return std::shared_ptr<AcqBuffer>();
         }
+    }
 
-        return true;
+    /** Expects the lock. */
+    void SetAcqBuffer(std::shared_ptr<AcqBuffer> acqBuffer, uns32 frameCount, uns32 frameBytes)
+    {
+        m_acqBuffer = std::move(acqBuffer);
+        m_seqPrevBuffer.reset();
+        m_frameCount = frameCount;
+        m_frameBytes = frameBytes;
+    }
+
+    void ResetAcqStats()
+    {
+        m_statQueueDropped = 0;
+        m_statFrameNrGaps = 0;
+        m_statFramesLost = 0;
+        m_statMaxQueueDepth = 0;
+        m_statCbErrors = 0;
+        m_statStreamAtRisk = 0;
+        m_statStreamOverwritten = 0;
+        m_statStreamQueueFull = 0;
+        m_statRearmCount = 0;
+        m_statRearmLatencyMaxUs = 0;
+        m_statRearmLatencyTotalUs = 0;
+        m_statCycleTimeMaxUs = 0;
+        m_statCycleTimeTotalUs = 0;
+    }
+
+    /** Returns true if PVCAM fills the acquisition buffer more than once. */
+    bool IsBufferReused() const
+    {
+        return !m_isSequence || m_seqSegmentFrames < m_seqTotal;
+    }
+
+    /**
+     * Returns the buffer holding given frame data, the one of previous sequence
+     * lap or the current one. Expects the lock.
+     */
+    std::shared_ptr<AcqBuffer> GetAcqBufferOf(const void* frameAddress) const
+    {
+        if (m_seqPrevBuffer)
+        {
+            const auto* bytes = static_cast<const uns8*>(frameAddress);
+            const auto* data = static_cast<const uns8*>(m_seqPrevBuffer->data);
+            if (bytes >= data && bytes < data + m_seqPrevBuffer->size)
+                return m_seqPrevBuffer;
+        }
+        return m_acqBuffer;
     }
 
     void ReleaseAcqBuffer()
     {
         m_acqBuffer.reset(); // Drop buffer ownership
+        m_seqPrevBuffer.reset();
         m_frameCount = 0;
         m_frameBytes = 0;
     }
 
-    bool SetStreamToDisk(const char* streamToDiskPath)
+    bool SetStreamToDisk(const char* streamToDiskPath, bool useIoUring, uns16 bitDepth)
     {
+        std::lock_guard<std::mutex> lock(m_streamMutex);
+
         if (!streamToDiskPath)
+        {
+            m_streamBackend = NULL;
             return true;
+        }
 
         if (m_streamFileHandle != cInvalidFileHandle)
             return false; // Already streaming
@@ -175,116 +300,258 @@ public:
         if (m_streamFileHandle == cInvalidFileHandle)
             return false;
 
-        m_readIndex = 0;
-        m_frameResidual = 0;
+        if (!WriteStreamFileHeader(bitDepth)
+                || !m_streamWriter.Start(m_streamFileHandle, m_acqBuffer, m_streamDataOffset,
+                    useIoUring))
+        {
+            CloseStreamFile();
+            return false;
+        }
+        m_streamBackend = m_streamWriter.GetBackend();
+
+        m_streamLayout.Reset(m_streamDataOffset, (uns32)m_acqBuffer->size,
+                (uns32)m_acqBuffer->paddedSize, m_frameBytes, IsBufferReused(),
+                STREAM_INDEX_RESERVE);
+
+        m_streamPending.clear();
+        m_streamQueuedBytes = 0;
 
         return true;
     }
 
-    bool StreamFrameToDisk(void* frameAddress)
+    /**
+     * Hands the new frame over to the writer thread, never waits for it.
+     * Returns false with error message set if streaming failed.
+     */
+    bool StreamFrameToDisk(const Frame& frame, std::string& error)
     {
+        std::lock_guard<std::mutex> lock(m_streamMutex);
+
         if (m_streamFileHandle == cInvalidFileHandle)
             return true;
 
-        // When streaming to a file, we must always write to an alignment boundary.
-        // Since the frame may not be a multiple of the alignment boundary,
-        // we might not write the entire frame. The remainder of the frame will
-        // be written on the next pass through this function. When we reach the end
-        // of the circular buffer we may need to pad additional bytes onto the end
-        // of the frame to meet the alignment requirement. These bytes are to be
-        // discarded later when using the file.
-
-        // TODO: What? EOF callback is invoked for every frame, one by one
-        // Frames may arrive out of order.
-        // To handle this situation, m_readIndex is used to track which bytes
+        // Frames may arrive out of order, the layout tracks which bytes
         // stream to file next rather than the pointer returned by PVCAM
-
-        uns32 availableBytes = m_frameResidual + m_frameBytes;
-
-        // This routine may fall behind writing the latest data.
-        // Attempt to catch up when the frameAddress is ahead of the
-        // read index by more than a frame.
-        const uintptr_t availableIndex =
-            (uintptr_t)frameAddress - (uintptr_t)m_acqBuffer->data;
-        if (availableIndex > m_readIndex)
+        const uns32 frameOffset = (uns32)((uintptr_t)frame.address
+                - (uintptr_t)m_acqBuffer->data);
+        uns32 availableBytes;
+        const StreamSegment segment =
+            m_streamLayout.AddFrame(frameOffset, frame.nr, frame.timeStamp, availableBytes);
+
+        // The writer thread is behind by the bytes queued but not written yet,
+        // plus the bytes of frames not queued so far, including this one.
+        // PVCAM overwrites data the writer still needs once it laps the writer.
+        bool overwritten = false;
+        bool atRisk = false;
+        if (IsBufferReused())
         {
-            if (availableBytes < availableIndex - m_readIndex)
-            {
-                availableBytes = (uns32)(availableIndex - m_readIndex);
-            }
+            const uint64_t pendingBytes =
+                m_streamQueuedBytes - m_streamWriter.GetWrittenBytes() + availableBytes;
+            overwritten = pendingBytes > m_acqBuffer->size;
+            // Next frame will overwrite unless writer catches up
+            atRisk = pendingBytes + m_frameBytes > m_acqBuffer->size;
         }
 
-        uns32 bytesToWrite = (availableBytes / ALIGNMENT_BOUNDARY) * ALIGNMENT_BOUNDARY;
-        const bool lastFrameInBuffer =
-            (m_acqBuffer->size - m_readIndex - bytesToWrite) < ALIGNMENT_BOUNDARY;
-        if (lastFrameInBuffer)
+        // The segment is queued even if overwritten to keep the file layout intact
+        if (segment.bytes > 0 && !QueueStreamSegment(segment))
+        {
+            m_statStreamQueueFull++;
+            atRisk = true; // Kept by the callback until the writer makes room
+        }
+        if (overwritten)
         {
-            bytesToWrite += ALIGNMENT_BOUNDARY;
+            m_streamLayout.MarkLastOverwritten();
+            m_statStreamOverwritten++;
+        }
+        else if (atRisk)
+        {
+            m_statStreamAtRisk++;
         }
 
-        void* alignedFrameData = reinterpret_cast<uns8*>(m_acqBuffer->data) + m_readIndex;
-        uns32 bytesWritten = 0;
-#ifdef _WIN32
-        ::WriteFile(m_streamFileHandle, alignedFrameData, (DWORD)bytesToWrite,
-                (LPDWORD)&bytesWritten, NULL);
-#else
-        bytesWritten += ::write(m_streamFileHandle, alignedFrameData, bytesToWrite);
-#endif
-        if (bytesWritten != bytesToWrite)
+        if (m_streamWriter.HasFailed())
         {
-            m_acqCbError =
-                std::string("Streaming to disk failed, not all bytes written")
-                + " - expected " + std::to_string(bytesToWrite)
-                + " but written " + std::to_string(bytesWritten) + ".";
+            error = m_streamWriter.GetError();
+            return false;
+        }
+        if (overwritten)
+        {
+            error = "Streaming to disk failed, frames in acquisition buffer"
+                " were overwritten before written to disk.";
             return false;
         }
-
-        // Store the count of frame bytes not written.
-        // Increment read index or reset to start of frame buffer if needed
-        m_frameResidual = (lastFrameInBuffer) ? 0 : availableBytes - bytesWritten;
-        m_readIndex = (lastFrameInBuffer) ? 0 : m_readIndex + bytesWritten;
 
         return true;
     }
 
-    bool UnsetStreamToDisk()
+    /**
+     * Flushes all data to disk and closes the file. Must not run concurrently
+     * with the callback. Returns false with error message set on failure.
+     */
+    bool UnsetStreamToDisk(std::string& error)
     {
+        std::lock_guard<std::mutex> lock(m_streamMutex);
+
         if (m_streamFileHandle == cInvalidFileHandle)
             return true;
 
         bool writeOk = true;
 
-        if (m_frameResidual != 0)
+        const StreamSegment finalSegment = m_streamLayout.GetFinalSegment();
+        if (finalSegment.bytes > 0)
         {
-            void* alignedFrameData =
-                reinterpret_cast<uns8*>(m_acqBuffer->data) + m_readIndex;
-            uns32 bytesWritten = 0;
-#ifdef _WIN32
-            ::WriteFile(m_streamFileHandle, alignedFrameData,
-                    (DWORD)ALIGNMENT_BOUNDARY, (LPDWORD)&bytesWritten, NULL);
-#else
-            bytesWritten +=
-                ::write(m_streamFileHandle, alignedFrameData, ALIGNMENT_BOUNDARY);
-#endif
-            if (bytesWritten != ALIGNMENT_BOUNDARY)
-            {
-                // Set error but complete the cleanup first
-                m_acqCbError =
-                    std::string("Streaming to disk failed, not all bytes written")
-                    + " - expected " + std::to_string(ALIGNMENT_BOUNDARY)
-                    + " but written " + std::to_string(bytesWritten) + ".";
-                writeOk = false;
-            }
+            QueueStreamSegment(finalSegment);
+        }
+        // No more frames come, the writer gets the rest even if it takes a while
+        for (const StreamSegment& segment : m_streamPending)
+        {
+            m_streamWriter.Queue(segment);
+        }
+        m_streamPending.clear();
+
+        // Let the writer thread flush all queued segments and exit
+        m_streamWriter.Stop();
+
+        if (m_streamWriter.HasFailed())
+        {
+            // Set error but complete the cleanup first
+            error = m_streamWriter.GetError();
+            writeOk = false;
+        }
+        else if (!FinalizeStreamFile(error))
+        {
+            writeOk = false;
         }
 
+        CloseStreamFile();
+
+        return writeOk;
+    }
+
+private:
+    /** Expects the stream lock. */
+    void CloseStreamFile()
+    {
+        m_streamHeader.reset();
+        m_streamLayout.Clear();
+
 #ifdef _WIN32
         ::CloseHandle(m_streamFileHandle);
 #else
         ::close(m_streamFileHandle);
 #endif
         m_streamFileHandle = cInvalidFileHandle;
+    }
 
-        return writeOk;
+    /**
+     * Writes the file header in front of the data. It is kept in memory until
+     * streaming ends, then it gets rewritten with the location of the index.
+     */
+    bool WriteStreamFileHeader(uns16 bitDepth)
+    {
+        const size_t roisBytes = m_rois.size() * sizeof(rgn_type);
+        const uns32 headerBytes = (uns32)((sizeof(StreamFileHeader) + roisBytes
+                    + ALIGNMENT_BOUNDARY - 1) / ALIGNMENT_BOUNDARY * ALIGNMENT_BOUNDARY);
+        try
+        {
+            m_streamHeader.reset(new AcqBuffer(headerBytes));
+        }
+        catch (const std::bad_alloc& /*ex*/)
+        {
+            return false;
+        }
+        uns8* page = reinterpret_cast<uns8*>(m_streamHeader->data);
+        memset(page, 0, headerBytes);
+
+        const uns32 bytesPerPixel = (bitDepth <= 8) ? 1 : (bitDepth <= 16) ? 2 : 4;
+        auto* header = reinterpret_cast<StreamFileHeader*>(page);
+        memcpy(header->magic, STREAM_FILE_MAGIC, sizeof(header->magic));
+        header->version = STREAM_FILE_VERSION;
+        header->headerBytes = headerBytes;
+        header->frameBytes = m_frameBytes;
+        header->bufferFrameCount = m_frameCount;
+        header->bufferBytes = m_acqBuffer->size;
+        // Sequence buffer is not circular unless segmented, one lap needs no padding
+        header->lapBytes = (IsBufferReused()) ? m_acqBuffer->paddedSize : m_acqBuffer->size;
+        snprintf(header->dtype, sizeof(header->dtype), "<u%u", bytesPerPixel);
+        header->bitDepth = bitDepth;
+        header->metadataEnabled = (m_metadataEnabled) ? 1 : 0;
+        header->imageCompression = m_imageCompression;
+        header->roiCount = (uns32)m_rois.size();
+        memcpy(page + sizeof(StreamFileHeader), m_rois.data(), roisBytes);
+
+        m_streamDataOffset = headerBytes;
+        // Moves file position to data
+        return WriteFileData(m_streamFileHandle, page, headerBytes) == headerBytes;
+    }
+
+    /** Appends the frame index behind the data and updates the header. */
+    bool FinalizeStreamFile(std::string& error)
+    {
+        const uint64_t indexOffset = m_streamDataOffset + m_streamQueuedBytes;
+        const std::vector<StreamFileIndexEntry>& index = m_streamLayout.GetIndex();
+        const size_t indexBytes = index.size() * sizeof(StreamFileIndexEntry);
+        if (indexBytes > 0)
+        {
+            std::unique_ptr<AcqBuffer> indexBuffer;
+            try
+            {
+                indexBuffer.reset(new AcqBuffer(indexBytes));
+            }
+            catch (const std::bad_alloc& /*ex*/)
+            {
+                error = "Streaming to disk failed, unable to allocate frame index.";
+                return false;
+            }
+            // O_DIRECT requires whole pages, the reader ignores the zeroed tail
+            const uns32 alignedBytes = (uns32)((indexBytes + ALIGNMENT_BOUNDARY - 1)
+                / ALIGNMENT_BOUNDARY * ALIGNMENT_BOUNDARY);
+            memset(indexBuffer->data, 0, alignedBytes);
+            memcpy(indexBuffer->data, index.data(), indexBytes);
+            const uns32 bytesWritten = WriteFileDataAt(m_streamFileHandle, indexBuffer->data,
+                    alignedBytes, indexOffset);
+            if (bytesWritten != alignedBytes)
+            {
+                error = GetStreamWriteError(alignedBytes, bytesWritten);
+                return false;
+            }
+        }
+
+        auto* header = reinterpret_cast<StreamFileHeader*>(m_streamHeader->data);
+        header->indexOffset = indexOffset;
+        header->frameCount = index.size();
+        const uns32 bytesWritten =
+            WriteFileDataAt(m_streamFileHandle, header, header->headerBytes, 0);
+        if (bytesWritten != header->headerBytes)
+        {
+            error = GetStreamWriteError(header->headerBytes, bytesWritten);
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * Expects the stream lock. Appends a segment to those not handed over to
+     * the writer yet and hands over as many as the writer queue takes without
+     * waiting. Returns false if any segment is left for later.
+     */
+    bool QueueStreamSegment(const StreamSegment& segment)
+    {
+        m_streamQueuedBytes += segment.bytes;
+        if (!m_streamPending.empty()
+                && m_streamPending.back().offset + m_streamPending.back().bytes
+                    == segment.offset)
+        {
+            m_streamPending.back().bytes += segment.bytes;
+        }
+        else
+        {
+            m_streamPending.push_back(segment);
+        }
+        while (!m_streamPending.empty() && m_streamWriter.TryQueue(m_streamPending.front()))
+        {
+            m_streamPending.pop_front();
+        }
+        return m_streamPending.empty();
     }
 
 public:
@@ -293,47 +560,188 @@ public:
     // Reference-counted ownership of the acq. buffer shared with NumPy objects
     // to guarantee the buffer is valid until last capsule releases it.
     std::shared_ptr<AcqBuffer> m_acqBuffer{ NULL };
+    AcqBufferPolicy m_acqBufferPolicy{}; // Applied with next allocation
     uns32 m_frameCount{ 0 };
     uns32 m_frameBytes{ 0 };
+    std::vector<rgn_type> m_rois{}; // Regions the acquisition was set up with
 
+    // FPS is updated by the callback only, but read by get_frame
     std::chrono::time_point<std::chrono::high_resolution_clock> m_fpsLastTime{
         std::chrono::high_resolution_clock::now() };
-    double m_fps{ 0.0 };
+    std::atomic<double> m_fps{ 0.0 };
     uns32 m_fpsFrameCnt{ 0 };
 
     bool m_isSequence{ false };
 
+    // Sequences longer than PVCAM can acquire at once are split into segments.
+    // Once the callback got the last frame of a segment, it lets m_seqRearmThread
+    // start the next one, every segment reuses the acquisition buffer from its
+    // beginning.
+    uns32 m_seqTotal{ 0 }; // Frames in the whole sequence
+    uns32 m_seqSegmentFrames{ 0 }; // Frames in full segment, same as m_seqTotal if not split
+    int16 m_seqExpMode{ 0 };
+    uns32 m_seqExpTime{ 0 };
+    uns32 m_seqSetupFrames{ 0 }; // Frames PVCAM is set up for, the last segment is shorter
+    uns32 m_seqFrameBase{ 0 }; // Frames in segments before the current one
+    std::atomic<bool> m_seqRearm{ false }; // Cleared on finish or abort
+    // With VTM exposure times given, every segment is one frame long and exposed
+    // with the next time from the list. Segments rotate over several buffer slots,
+    // so a frame is not overwritten by the next one before it is retrieved.
+    std::vector<uns16> m_seqExpTimes{};
+    uns32 m_seqExpTimeIndex{ 0 }; // Index of the time used by next segment
+    uns32 m_seqSegmentSlots{ 1 }; // Segment-sized slots in the acquisition buffer
+    std::chrono::high_resolution_clock::time_point m_seqLastEofTime{}; // Callback only
+    // PVCAM functions other than those getting frames are not meant to be called
+    // from within the callback, it only signals this thread to start next segment
+    TaskThread m_seqRearmThread{};
+    std::chrono::high_resolution_clock::time_point m_seqSegmentEofTime{}; // Set before signal
+    // Buffer of the previous lap of a segmented sequence, kept as long as queued
+    // frames may point to it. A lap over the buffer goes to a new one from the pool
+    // if frames of the previous lap were not retrieved or were exported without copy.
+    std::shared_ptr<AcqBuffer> m_seqPrevBuffer{};
+
+    // The callback pushes frames to the ring without holding m_mutex,
+    // it locks it only briefly to notify m_acqCond without a lost wakeup.
     std::condition_variable m_acqCond{};
-    std::queue<Frame> m_acqQueue{};
-    size_t m_acqQueueCapacity{ 0 };
+    std::atomic<uns32> m_acqWaiters{ 0 };
+    FrameRing m_acqQueue{};
     bool m_acqAbort{ false };
-    bool m_acqNewFrame{ false };
-    uns32 m_acqFrameCnt{ 0 };
+    std::atomic<uns32> m_acqFrameCnt{ 0 };
     std::string m_acqCbError{};
 
+    // Frames in live buffer pinned by objects pointing to them, never overwritten
+    std::shared_ptr<FrameSlots> m_frameSlots{ std::make_shared<FrameSlots>() };
+
+    // Acquisition statistics, updated by the callback and reset with every setup.
+    // Atomic so get_acq_stats can read them any time without stalling the callback.
+    std::atomic<uint64_t> m_statQueueDropped{ 0 }; // Frames dropped by queue overflow or overwritten
+    std::atomic<uint64_t> m_statFrameNrGaps{ 0 }; // Number of discontinuities in FrameNr
+    std::atomic<uint64_t> m_statFramesLost{ 0 }; // Sum of FrameNr values missing in gaps
+    std::atomic<uint64_t> m_statMaxQueueDepth{ 0 };
+    std::atomic<uint64_t> m_statCbErrors{ 0 };
+    std::atomic<uint64_t> m_statStreamAtRisk{ 0 }; // Frames close to overwrite before written
+    std::atomic<uint64_t> m_statStreamOverwritten{ 0 }; // Frames overwritten before written
+    std::atomic<uint64_t> m_statStreamQueueFull{ 0 }; // Frames not queued for the writer at once
+    std::atomic<uint64_t> m_statRearmCount{ 0 }; // Sequence segments started by the re-arm thread
+    std::atomic<uint64_t> m_statRearmLatencyMaxUs{ 0 }; // From last frame to next start
+    std::atomic<uint64_t> m_statRearmLatencyTotalUs{ 0 };
+    std::atomic<uint64_t> m_statCycleTimeMaxUs{ 0 }; // Between EOFs of sequence frames
+    std::atomic<uint64_t> m_statCycleTimeTotalUs{ 0 };
+    uns32 m_lastFrameNr{ 0 }; // Callback only, zeroed on acquisition start
+
     // Metadata objects
     bool m_metadataEnabled{ false };
-    md_frame* m_mdFrame{ NULL };
+    std::vector<md_frame*> m_mdFrames{}; // Not lent at the moment, one per concurrent reader
+    MetadataFormat m_metadataFormat{ MetadataFormat::Dict };
+
+    // PL_IMAGE_COMPRESSIONS value at setup, used for frames without metadata
+    uns8 m_imageCompression{ (uns8)PL_IMAGE_COMPRESSION_NONE };
+    // Geometry of frames without metadata derived from m_rois at setup,
+    // the array shape of the first region and NumPy type of its pixels
+    npy_intp m_frameDims[2]{ 0, 0 };
+    int m_typenum{ NPY_UINT16 };
+
+    // Parameter attributes that don't change until some settings change
+    ParamCache<ParamValue> m_paramCache{};
 
     // Stream to disk
     FileHandle m_streamFileHandle{ cInvalidFileHandle };
-    uns32 m_readIndex{ 0 }; // Position in m_acqBuffer to save data from
-    uns32 m_frameResidual{ 0 };
+
+    // Disk writes are done by a dedicated thread, so a stalled file system never
+    // blocks the callback. The callback queues aligned segments of m_acqBuffer,
+    // those the writer queue has no room for yet wait in m_streamPending.
+    // The stream state is guarded by its own lock, never by m_mutex.
+    std::mutex m_streamMutex{};
+    StreamWriter m_streamWriter{};
+    std::deque<StreamSegment> m_streamPending{};
+    uint64_t m_streamQueuedBytes{ 0 }; // Including pending segments
+    std::atomic<const char*> m_streamBackend{ NULL }; // Name of the writer backend
+
+    // Stream file container, the index is appended by the callback only
+    std::unique_ptr<AcqBuffer> m_streamHeader{}; // Aligned header page(s)
+    uns32 m_streamDataOffset{ 0 }; // File offset of the first lap
+    StreamFileLayout m_streamLayout{};
 };
 
-// Global variables
+/** Cameras opened by one module instance. */
+struct CameraRegistry
+{
+    std::map<int16, std::shared_ptr<Camera>> cameras{}; // The key is hcam
+    std::mutex mutex{};
+};
 
-std::map<int16, std::shared_ptr<Camera>> g_cameraMap{}; // The key is hcam
-std::mutex                               g_cameraMapMutex{};
+/**
+ * Per-module state. Zeroed by Python before the module is executed, thus
+ * holds pointers only. The callback gets its Camera via context pointer and
+ * never touches the state.
+ */
+struct ModuleState
+{
+    CameraRegistry* cameraRegistry;
+    PyTypeObject* frameViewType;
+    PyTypeObject* frameBufferType;
+    PyArray_Descr* mdFrameHeaderDescr;
+    PyArray_Descr* mdRoiHeaderDescr;
+};
 
 // Local functions
 
+static ModuleState* GetModuleState(PyObject* module)
+{
+    return static_cast<ModuleState*>(PyModule_GetState(module));
+}
+
 /** Helper that always returns NULL and raises ValueError "Invalid parameters." message. */
 static PyObject* ParamParseError()
 {
     return PyErr_Format(PyExc_ValueError, "Invalid parameters.");
 }
 
+/**
+ * Converters of METH_FASTCALL arguments, the same as PyArg_ParseTuple formats
+ * "h", "i" and "I" without the format string parsing. Return false with Python
+ * error set on failure.
+ */
+static bool ArgAsInt16(PyObject* arg, int16& value)
+{
+    const long longValue = PyLong_AsLong(arg);
+    if (longValue == -1 && PyErr_Occurred())
+        return false;
+    if (longValue < (std::numeric_limits<int16>::min)()
+            || longValue > (std::numeric_limits<int16>::max)())
+    {
+        PyErr_SetString(PyExc_OverflowError, "Value out of int16 range.");
+        return false;
+    }
+    value = (int16)longValue;
+    return true;
+}
+
+static bool ArgAsInt(PyObject* arg, int& value)
+{
+    const long longValue = PyLong_AsLong(arg);
+    if (longValue == -1 && PyErr_Occurred())
+        return false;
+    if (longValue < (std::numeric_limits<int>::min)()
+            || longValue > (std::numeric_limits<int>::max)())
+    {
+        PyErr_SetString(PyExc_OverflowError, "Value out of int range.");
+        return false;
+    }
+    value = (int)longValue;
+    return true;
+}
+
+static bool ArgAsUns32(PyObject* arg, uns32& value)
+{
+    // No overflow checking like with "I" format
+    const unsigned long longValue = PyLong_AsUnsignedLongMask(arg);
+    if (longValue == (unsigned long)-1 && PyErr_Occurred())
+        return false;
+    value = (uns32)longValue;
+    return true;
+}
+
 /** Helper that always returns NULL and raises RuntimeError with PVCAM error message. */
 static PyObject* PvcamError()
 {
@@ -342,14 +750,15 @@ static PyObject* PvcamError()
     return PyErr_Format(PyExc_RuntimeError, errMsg);
 }
 
-/** Helper that returns Camera instance from global map, or NULL if doesn't exist. */
-static std::shared_ptr<Camera> GetCamera(int16 hcam, bool setPyErr = true)
+/** Helper that returns Camera instance opened by given module, or NULL if doesn't exist. */
+static std::shared_ptr<Camera> GetCamera(PyObject* module, int16 hcam, bool setPyErr = true)
 {
+    CameraRegistry& registry = *GetModuleState(module)->cameraRegistry;
     std::shared_ptr<Camera> cam;
     try
     {
-        std::lock_guard<std::mutex> lock(g_cameraMapMutex);
-        cam = g_cameraMap.at(hcam);
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        cam = registry.cameras.at(hcam);
     }
     catch (const std::out_of_range& ex)
     {
@@ -360,6 +769,22 @@ static std::shared_ptr<Camera> GetCamera(int16 hcam, bool setPyErr = true)
     return cam;
 }
 
+/**
+ * Reads a parameter attribute through the cache of given camera, that may be
+ * null for cameras not opened by this module. Returns false on PVCAM error.
+ */
+static bool GetParamCached(int16 hcam, Camera* cam, uns32 paramId, int16 attr,
+        ParamValue& value)
+{
+    if (cam && cam->m_paramCache.Get(paramId, attr, value))
+        return true;
+    if (!pl_get_param(hcam, paramId, attr, &value))
+        return false;
+    if (cam)
+        cam->m_paramCache.Put(paramId, attr, value);
+    return true;
+}
+
 /** Sets ValueError on error and returns rgn_type with all zeroes */
 static rgn_type PopulateRegion(PyObject* roiObj)
 {
@@ -470,75 +895,172 @@ static std::vector<uns32> PopulateSsParams(PyObject* ssListObj)
     return ssArray;
 }
 
-static void NewFrameHandler(FRAME_INFO* pFrameInfo, void* context)
+/** Helper that returns bit depth of pixels in host memory, false with Python error set. */
+static bool GetHostBitDepth(int16 hcam, uns16& bitDepth)
 {
-    std::shared_ptr<Camera> cam = GetCamera(pFrameInfo->hCam, false);
-    if (!cam)
+    rs_bool avail;
+    if (!pl_get_param(hcam, PARAM_BIT_DEPTH_HOST, ATTR_AVAIL, &avail))
+        avail = FALSE;
+    const uns32 paramId = (avail) ? PARAM_BIT_DEPTH_HOST : PARAM_BIT_DEPTH;
+
+    int16 value;
+    if (!pl_get_param(hcam, paramId, ATTR_CURRENT, &value))
     {
-        fprintf(stderr, "pvc.NewFrameHandler: Invalid camera instance key.\n");
-        return; // No 'cam' means no mutex lock and no notify_all
+        PvcamError();
+        return false;
     }
+    bitDepth = (uns16)value;
+    return true;
+}
 
-    void* address;
-    FRAME_INFO fi;
-    const rs_bool getLatestFrameResult =
-        pl_exp_get_latest_frame_ex(pFrameInfo->hCam, &address, &fi);
+/** Returns NumPy type of uncompressed pixels, the same as Camera uses for its dtype. */
+static int GetPixelTypenum(uns16 bitDepth)
+{
+    if (bitDepth <= 8)
+        return NPY_UINT8;
+    if (bitDepth <= 16)
+        return NPY_UINT16;
+    return NPY_UINT32;
+}
 
-    std::lock_guard<std::mutex> lock(cam->m_mutex);
+/** Helper that returns current pixel data compression, false with Python error set. */
+static bool GetImageCompression(int16 hcam, uns8& compression)
+{
+    compression = (uns8)PL_IMAGE_COMPRESSION_NONE;
 
-    cam->m_acqFrameCnt++;
-    //printf("New frame callback. Frame count %u\n", cam->m_acqFrameCnt);
+    rs_bool avail;
+    if (!pl_get_param(hcam, PARAM_IMAGE_COMPRESSION, ATTR_AVAIL, &avail) || !avail)
+        return true;
 
-    // Re-compute FPS every 5 frames
-    constexpr uns32 FPS_FRAME_COUNT = 5;
-    if (++cam->m_fpsFrameCnt >= FPS_FRAME_COUNT)
+    int32 value;
+    if (!pl_get_param(hcam, PARAM_IMAGE_COMPRESSION, ATTR_CURRENT, &value))
     {
-        const auto now = std::chrono::high_resolution_clock::now();
-        const auto timeDeltaUs =
-            std::chrono::duration_cast<std::chrono::microseconds>(
-                now - cam->m_fpsLastTime).count();
-        if (timeDeltaUs != 0)
-        {
-            cam->m_fps = (double)cam->m_fpsFrameCnt / timeDeltaUs * 1e6;
-            cam->m_fpsLastTime = now;
-            cam->m_fpsFrameCnt = 0;
-            //printf("FPS: %.1f timeDeltaUs: %lld\n", cam->m_fps, timeDeltaUs);
-        }
+        PvcamError();
+        return false;
     }
+    compression = (uns8)value;
+    return true;
+}
 
-    if (!getLatestFrameResult)
+/**
+ * Starts the next segment of a sequence, the first one too. Set-up members
+ * are not changed during acquisition, so the re-arm thread doesn't lock any
+ * mutex. It is also the only one replacing the buffer during acquisition.
+ * Returns false on PVCAM error.
+ */
+static bool StartSeqSegment(int16 hcam, Camera& cam)
+{
+    const uns32 frames =
+        (std::min)(cam.m_seqSegmentFrames, cam.m_seqTotal - cam.m_seqFrameBase);
+    if (frames != cam.m_seqSetupFrames)
     {
-        cam->m_acqCbError = "Failed to get latest frame from PVCAM.";
-        cam->m_acqCond.notify_all(); // Wakeup get_frame if anybody waits
-        return;
+        // The last segment is shorter, re-used for the first one of next sequence
+        uns32 bytes;
+        if (!pl_exp_setup_seq(hcam, (uns16)frames, (uns16)cam.m_rois.size(),
+                    cam.m_rois.data(), cam.m_seqExpMode, cam.m_seqExpTime, &bytes))
+            return false;
+        cam.m_seqSetupFrames = frames;
+    }
+    if (!cam.m_seqExpTimes.empty())
+    {
+        const size_t index = cam.m_seqExpTimeIndex % cam.m_seqExpTimes.size();
+        uns16 expTime = cam.m_seqExpTimes[index];
+        if (!pl_set_param(hcam, PARAM_EXP_TIME, &expTime))
+            return false;
+        cam.m_seqExpTimeIndex++;
     }
+    const uns32 slot =
+        (cam.m_seqFrameBase / cam.m_seqSegmentFrames) % cam.m_seqSegmentSlots;
+    uns8* buffer = (uns8*)cam.m_acqBuffer->data
+        + (size_t)slot * cam.m_seqSegmentFrames * cam.m_frameBytes;
+    return pl_exp_start_seq(hcam, buffer) != PV_FAIL;
+}
 
-    Frame frame;
-    frame.address = address;
-    frame.count = cam->m_acqFrameCnt;
-    frame.nr = (uns32)fi.FrameNr;
+/**
+ * Starts the next segment of a sequence on the re-arm thread, signaled by the
+ * callback once it queued the last frame of previous segment.
+ *
+ * A segment starting a new lap over the buffer would overwrite frames still
+ * queued or exported without copy. The buffer is kept then and the lap goes to
+ * a new buffer from the pool, usually one released by earlier laps. Exported
+ * frames keep their buffer alive, like they do after the acquisition ends.
+ * Streamed sequences always reuse the one buffer the writer follows, so do all
+ * if no new buffer can be allocated.
+ */
+static void RearmSeq(int16 hcam, Camera& cam)
+{
+    if (!cam.m_seqRearm)
+        return; // Finished or aborted meanwhile
 
-    // Add frame to the queue, pop the oldest once the capacity is reached
-    while (cam->m_acqQueue.size() >= cam->m_acqQueueCapacity)
+    const bool newLap =
+        (cam.m_seqFrameBase / cam.m_seqSegmentFrames) % cam.m_seqSegmentSlots == 0;
+    std::shared_ptr<AcqBuffer> newBuffer;
+    bool streamed;
     {
-        //printf("Dropped frame nr %u in favor of nr %u\n",
-        //        cam->m_acqQueue.front().nr, frame.nr);
-        cam->m_acqQueue.pop();
+        std::lock_guard<std::mutex> lock(cam.m_streamMutex);
+        streamed = cam.m_streamFileHandle != cInvalidFileHandle;
     }
-    cam->m_acqQueue.push(frame);
-    cam->m_acqNewFrame = true;
-
-    if (cam->m_streamFileHandle != cInvalidFileHandle)
+    if (newLap && !streamed)
     {
-        if (!cam->StreamFrameToDisk(frame.address))
+        size_t bufferBytes = 0;
+        AcqBufferPolicy policy;
+        {
+            std::lock_guard<std::mutex> lock(cam.m_mutex);
+            // Getters hold extra reference only briefly, worst case a new buffer is used
+            const bool referenced =
+                cam.m_acqQueue.Size() > 0 || cam.m_acqBuffer.use_count() > 1;
+            if (referenced)
+            {
+                bufferBytes = cam.m_acqBuffer->size;
+                policy = cam.m_acqBuffer->requested;
+            }
+        }
+        if (bufferBytes > 0)
         {
-            // cam->m_acqCbError already set in StreamFrameToDisk()
-            cam->m_acqCond.notify_all(); // Wakeup get_frame if anybody waits
-            return;
+            try
+            {
+                newBuffer = AcqBufferPool::Instance().Acquire(bufferBytes, policy);
+            }
+            catch (const std::bad_alloc& /*ex*/)
+            {
+                // Reuse the buffer, same as before there was any check
+            }
         }
     }
 
-    cam->m_acqCond.notify_all(); // Wakeup get_frame if anybody waits
+    std::shared_ptr<AcqBuffer> prevBuffer; // Released without holding the lock
+    if (newBuffer)
+    {
+        std::lock_guard<std::mutex> lock(cam.m_mutex);
+        // The queue holds at most one lap, nothing points to older laps anymore
+        prevBuffer = std::move(cam.m_seqPrevBuffer);
+        cam.m_seqPrevBuffer = std::move(cam.m_acqBuffer);
+        cam.m_acqBuffer = std::move(newBuffer);
+    }
+
+    if (StartSeqSegment(hcam, cam))
+    {
+        const uint64_t latencyUs =
+            (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::high_resolution_clock::now() - cam.m_seqSegmentEofTime).count();
+        cam.m_statRearmCount++;
+        cam.m_statRearmLatencyTotalUs += latencyUs;
+        if (latencyUs > cam.m_statRearmLatencyMaxUs.load(std::memory_order_relaxed))
+        {
+            cam.m_statRearmLatencyMaxUs.store(latencyUs, std::memory_order_relaxed);
+        }
+    }
+    else
+    {
+        char errMsg[ERROR_MSG_LEN] = "<UNKNOWN ERROR>";
+        pl_error_message(pl_error_code(), errMsg); // Ignore PVCAM error
+        cam.m_statCbErrors++;
+        {
+            std::lock_guard<std::mutex> lock(cam.m_mutex);
+            cam.m_acqCbError = std::string("Failed to start next sequence segment: ") + errMsg;
+        }
+        cam.m_acqCond.notify_all(); // Wakeup get_frame if anybody waits
+    }
 }
 
 // Module functions
@@ -639,10 +1161,11 @@ static PyObject* pvc_open_camera(PyObject* self, PyObject* args)
                 "Unable to allocate new Camera instance (%s).", ex.what());
     }
 
-    // Successfully opened, save new Camera instance to global map
+    // Successfully opened, save new Camera instance to module's registry
     {
-        std::lock_guard<std::mutex> lock(g_cameraMapMutex);
-        g_cameraMap[hcam] = cam;
+        CameraRegistry& registry = *GetModuleState(self)->cameraRegistry;
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.cameras[hcam] = cam;
     }
     return PyLong_FromLong(hcam);
 }
@@ -654,90 +1177,213 @@ static PyObject* pvc_close_camera(PyObject* self, PyObject* args)
     if (!PyArg_ParseTuple(args, "h", &hcam))
         return ParamParseError();
 
+    // Pins released later must not unlock frames of closed camera, even if
+    // the acquisition was not stopped
+    {
+        CameraRegistry& registry = *GetModuleState(self)->cameraRegistry;
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        auto it = registry.cameras.find(hcam);
+        if (it != registry.cameras.end())
+        {
+            it->second->m_seqRearmThread.Stop();
+            it->second->m_frameSlots->Close();
+        }
+    }
+
     if (!pl_cam_close(hcam))
         return PvcamError();
 
-    // Successfully closed, remove Camera instance from global map
+    // Successfully closed, no callback runs anymore, remove Camera instance from registry
     {
-        std::lock_guard<std::mutex> lock(g_cameraMapMutex);
-        g_cameraMap.erase(hcam);
+        CameraRegistry& registry = *GetModuleState(self)->cameraRegistry;
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.cameras.erase(hcam);
     }
     Py_RETURN_NONE;
 }
 
-/** Returns the value of the specified parameter. */
-static PyObject* pvc_get_param(PyObject* self, PyObject* args)
+/**
+ * Parameter read or write done without holding the GIL. The outcome is
+ * converted to Python value or exception once the GIL is held again.
+ */
+struct ParamAccess
 {
-    int16 hcam;
-    uns32 paramId;
-    int16 paramAttr;
-    if (!PyArg_ParseTuple(args, "hIh", &hcam, &paramId, &paramAttr))
-        return ParamParseError();
+    enum class Error
+    {
+        None,
+        Pvcam, // PVCAM call failed, see errorMsg
+        NotAvailable,
+        TypeMismatch, // Type reported by PVCAM differs from type in parameter ID
+        UnknownAttr,
+    };
 
-    rs_bool avail;
-    if (!pl_get_param(hcam, paramId, ATTR_AVAIL, &avail))
-        return PvcamError();
-    if (paramAttr == ATTR_AVAIL)
-        return PyBool_FromLong(avail);
-    if (!avail)
-        return PyErr_Format(PyExc_AttributeError,
-                "Invalid setting for this camera. Parameter ID 0x%08X is not available.",
-                paramId);
+    uns32 paramId{ 0 };
+    int16 attr{ ATTR_CURRENT };
+    uns16 type{ TYPE_INT32 };
+    ParamValue value{};
+    std::vector<uns32> ssItems{}; // Storage for SMART streaming values
+    Error error{ Error::None };
+    std::string errorMsg{};
 
-    uns16 paramType;
-    if (!pl_get_param(hcam, paramId, ATTR_TYPE, &paramType))
-        return PvcamError();
+    /** Records message of last PVCAM error, returns false for convenience. */
+    bool SetPvcamError()
+    {
+        char errMsg[ERROR_MSG_LEN] = "<UNKNOWN ERROR>";
+        pl_error_message(pl_error_code(), errMsg); // Ignore PVCAM error
+        error = Error::Pvcam;
+        errorMsg = errMsg;
+        return false;
+    }
+};
+
+/**
+ * Reads given attribute like pl_get_param, checks the availability and reads
+ * the type first. Doesn't touch Python objects, may be called without the GIL.
+ * Returns false on error recorded in access.
+ */
+static bool GetParamAccess(int16 hcam, Camera* cam, ParamAccess& access)
+{
+    ParamValue attrValue;
+    if (!GetParamCached(hcam, cam, access.paramId, ATTR_AVAIL, attrValue))
+        return access.SetPvcamError();
+    if (access.attr == ATTR_AVAIL)
+    {
+        access.value.val_bool = attrValue.val_bool;
+        return true;
+    }
+    if (!attrValue.val_bool)
+    {
+        access.error = ParamAccess::Error::NotAvailable;
+        return false;
+    }
 
-    ParamValue paramValue;
-    std::vector<uns32> ssItems; // Helper container to hold data for SMART streaming
-    if (paramType == TYPE_SMART_STREAM_TYPE_PTR)
+    if (!GetParamCached(hcam, cam, access.paramId, ATTR_TYPE, attrValue))
+        return access.SetPvcamError();
+    access.type = attrValue.val_uns16;
+
+    if (access.type == TYPE_SMART_STREAM_TYPE_PTR)
     {
-        switch (paramAttr)
+        switch (access.attr)
         {
         case ATTR_CURRENT:
         case ATTR_DEFAULT:
         case ATTR_MIN:
         case ATTR_MAX:
         case ATTR_INCREMENT:
-            if (!pl_get_param(hcam, paramId, ATTR_MAX, &paramValue.val_ss.entries))
-                return PvcamError();
-            ssItems.resize(paramValue.val_ss.entries);
-            paramValue.val_ss.params = ssItems.data();
+            if (!pl_get_param(hcam, access.paramId, ATTR_MAX, &access.value.val_ss.entries))
+                return access.SetPvcamError();
+            access.ssItems.resize(access.value.val_ss.entries);
+            access.value.val_ss.params = access.ssItems.data();
             break;
         default:
             break;
         }
     }
 
-    if (!pl_get_param(hcam, paramId, paramAttr, &paramValue))
-        return PvcamError();
+    // Ranges of smart streaming point to local storage, never cached
+    Camera* cacheCam = (access.type != TYPE_SMART_STREAM_TYPE_PTR) ? cam : NULL;
+    if (!GetParamCached(hcam, cacheCam, access.paramId, access.attr, access.value))
+        return access.SetPvcamError();
 
-    switch (paramAttr)
+    switch (access.attr)
     {
-    //case ATTR_AVAIL: // Already handled above
     case ATTR_LIVE:
-        return PyBool_FromLong(paramValue.val_bool);
     case ATTR_TYPE:
     case ATTR_ACCESS:
-        return PyLong_FromUnsignedLong(paramValue.val_uns16);
     case ATTR_COUNT:
-        return PyLong_FromUnsignedLong(paramValue.val_uns32);
     case ATTR_CURRENT:
-        break; // Handle all param types below
+        break;
     case ATTR_DEFAULT:
     case ATTR_MIN:
     case ATTR_MAX:
     case ATTR_INCREMENT:
-        if (paramType == TYPE_SMART_STREAM_TYPE_PTR)
-            for (uns32 i = 0; i < paramValue.val_ss.entries; i++)
-                paramValue.val_ss.params[i] = 0;
-        break; // Continue handling as other param types below
+        if (access.type == TYPE_SMART_STREAM_TYPE_PTR)
+            for (uns32 i = 0; i < access.value.val_ss.entries; i++)
+                access.value.val_ss.params[i] = 0;
+        break;
     default:
-        return PyErr_Format(PyExc_RuntimeError,
-                "Failed to match parameter attribute (%u).", (uns32)paramAttr);
+        access.error = ParamAccess::Error::UnknownAttr;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Writes the value like pl_set_param after checking the availability and
+ * that the camera reports the type the value was converted for.
+ * Doesn't touch Python objects, may be called without the GIL.
+ * Returns false on error recorded in access.
+ */
+static bool SetParamAccess(int16 hcam, Camera* cam, ParamAccess& access)
+{
+    ParamValue attrValue;
+    if (!GetParamCached(hcam, cam, access.paramId, ATTR_AVAIL, attrValue))
+        return access.SetPvcamError();
+    if (!attrValue.val_bool)
+    {
+        access.error = ParamAccess::Error::NotAvailable;
+        return false;
+    }
+
+    if (!GetParamCached(hcam, cam, access.paramId, ATTR_TYPE, attrValue))
+        return access.SetPvcamError();
+    if (attrValue.val_uns16 != access.type)
+    {
+        access.error = ParamAccess::Error::TypeMismatch;
+        return false;
+    }
+
+    if (access.type == TYPE_SMART_STREAM_TYPE_PTR)
+        access.value.val_ss.params = access.ssItems.data();
+
+    if (!pl_set_param(hcam, access.paramId, &access.value))
+        return access.SetPvcamError();
+
+    if (cam)
+        cam->m_paramCache.OnSet(access.paramId);
+    return true;
+}
+
+/** Sets Python error for failed access, always returns NULL. */
+static PyObject* ParamAccessError(const ParamAccess& access)
+{
+    switch (access.error)
+    {
+    case ParamAccess::Error::NotAvailable:
+        return PyErr_Format(PyExc_AttributeError,
+                "Invalid setting for this camera. Parameter ID 0x%08X is not available.",
+                access.paramId);
+    case ParamAccess::Error::TypeMismatch:
+        return PyErr_Format(PyExc_RuntimeError,
+                "Type of parameter ID 0x%08X doesn't match its ID.", access.paramId);
+    case ParamAccess::Error::UnknownAttr:
+        return PyErr_Format(PyExc_RuntimeError,
+                "Failed to match parameter attribute (%u).", (uns32)access.attr);
+    case ParamAccess::Error::Pvcam:
+    default:
+        return PyErr_Format(PyExc_RuntimeError, "%s", access.errorMsg.c_str());
+    }
+}
+
+/** Converts value read by GetParamAccess, returns NULL with Python error set on failure. */
+static PyObject* GetNewPyParamValue(const ParamAccess& access)
+{
+    const ParamValue& paramValue = access.value;
+    switch (access.attr)
+    {
+    case ATTR_AVAIL:
+    case ATTR_LIVE:
+        return PyBool_FromLong(paramValue.val_bool);
+    case ATTR_TYPE:
+    case ATTR_ACCESS:
+        return PyLong_FromUnsignedLong(paramValue.val_uns16);
+    case ATTR_COUNT:
+        return PyLong_FromUnsignedLong(paramValue.val_uns32);
+    default:
+        break; // Handle all param types below
     }
 
-    switch (paramType)
+    switch (access.type)
     {
     case TYPE_CHAR_PTR:
         return PyUnicode_FromString(paramValue.val_str);
@@ -771,7 +1417,7 @@ static PyObject* pvc_get_param(PyObject* self, PyObject* args)
             return NULL;
         for (uns32 i = 0; i < paramValue.val_ss.entries; i++)
         {
-            PyObject* pySsItem = PyLong_FromUnsignedLong(paramValue.val_ss.params[i]);
+            PyObject* pySsItem = PyLong_FromUnsignedLong(access.ssItems[i]);
             if (!pySsItem)
             {
                 Py_DECREF(pySsList);
@@ -798,40 +1444,24 @@ static PyObject* pvc_get_param(PyObject* self, PyObject* args)
     case TYPE_RGN_LIST_TYPE_PTR: // Not used in PVCAM
     default:
         return PyErr_Format(PyExc_RuntimeError,
-                "Failed to match parameter type (%u).", (uns32)paramType);
+                "Failed to match parameter type (%u).", (uns32)access.type);
     }
 }
 
-/** Sets a specified parameter to a given value. */
-static PyObject* pvc_set_param(PyObject* self, PyObject* args)
+/**
+ * Converts Python value to access.value according to access.type.
+ * Returns false with Python error set on failure.
+ */
+static bool PopulateParamValue(PyObject* paramValueObj, ParamAccess& access)
 {
-    int16 hcam;
-    uns32 paramId;
-    PyObject* paramValueObj;
-    if (!PyArg_ParseTuple(args, "hIO", &hcam, &paramId, &paramValueObj))
-        return ParamParseError();
-
-    rs_bool avail;
-    if (!pl_get_param(hcam, paramId, ATTR_AVAIL, &avail))
-        return PvcamError();
-    if (!avail)
-        return PyErr_Format(PyExc_AttributeError,
-                "Invalid setting for this camera. Parameter ID 0x%08X is not available.",
-                paramId);
-
-    uns16 paramType;
-    if (!pl_get_param(hcam, paramId, ATTR_TYPE, &paramType))
-        return PvcamError();
-
-    ParamValue paramValue;
-    std::vector<uns32> ssItems; // Helper container to hold data for SMART streaming
-    switch (paramType)
+    ParamValue& paramValue = access.value;
+    switch (access.type)
     {
     case TYPE_CHAR_PTR: {
         Py_ssize_t size;
         const char* str = PyUnicode_AsUTF8AndSize(paramValueObj, &size);
         if (!str)
-            return NULL;
+            return false;
         const size_t strLen = (std::min)((size_t)size, sizeof(paramValue.val_str));
         memcpy(paramValue.val_str, str, strLen);
         break;
@@ -873,17 +1503,20 @@ static PyObject* pvc_set_param(PyObject* self, PyObject* args)
         paramValue.val_uns16 = (uns16)PyLong_AsUnsignedLong(paramValueObj);
         break;
     case TYPE_SMART_STREAM_TYPE_PTR: {
-        ssItems = PopulateSsParams(paramValueObj);
+        access.ssItems = PopulateSsParams(paramValueObj);
         if (PyErr_Occurred())
-            return NULL;
-        paramValue.val_ss.entries = (uns16)ssItems.size();
-        paramValue.val_ss.params = ssItems.data();
+            return false;
+        paramValue.val_ss.entries = (uns16)access.ssItems.size();
+        paramValue.val_ss.params = access.ssItems.data();
         break;
     }
     case TYPE_RGN_TYPE:
         paramValue.val_roi = PopulateRegion(paramValueObj);
         if (paramValue.val_roi.sbin == 0) // Invalid roi has all zeroes, let's check sbin only
-            return PyErr_Format(PyExc_ValueError, "Failed to parse ROI members.");
+        {
+            PyErr_Format(PyExc_ValueError, "Failed to parse ROI members.");
+            return false;
+        }
         break;
     case TYPE_SMART_STREAM_TYPE: // Not used in PVCAM
     case TYPE_VOID_PTR: // Not used in PVCAM
@@ -892,18 +1525,215 @@ static PyObject* pvc_set_param(PyObject* self, PyObject* args)
     case TYPE_RGN_LIST_TYPE: // Not used in PVCAM
     case TYPE_RGN_LIST_TYPE_PTR: // Not used in PVCAM
     default:
-        return PyErr_Format(PyExc_RuntimeError,
-                "Failed to match parameter type (%u).", (uns32)paramType);
+        PyErr_Format(PyExc_RuntimeError,
+                "Failed to match parameter type (%u).", (uns32)access.type);
+        return false;
     }
-    if (PyErr_Occurred())
-        return NULL;
+    return !PyErr_Occurred();
+}
+
+/** Returns the value of the specified parameter. */
+static PyObject* pvc_get_param(PyObject* self, PyObject* const* args, Py_ssize_t nargs)
+{
+    ParamAccess access;
+    int16 hcam;
+    if (nargs != 3 || !ArgAsInt16(args[0], hcam) || !ArgAsUns32(args[1], access.paramId)
+            || !ArgAsInt16(args[2], access.attr))
+        return ParamParseError();
+
+    std::shared_ptr<Camera> cam = GetCamera(self, hcam, false);
+
+    if (!GetParamAccess(hcam, cam.get(), access))
+        return ParamAccessError(access);
+
+    return GetNewPyParamValue(access);
+}
+
+/** Sets a specified parameter to a given value. */
+static PyObject* pvc_set_param(PyObject* self, PyObject* const* args, Py_ssize_t nargs)
+{
+    ParamAccess access;
+    int16 hcam;
+    if (nargs != 3 || !ArgAsInt16(args[0], hcam) || !ArgAsUns32(args[1], access.paramId))
+        return ParamParseError();
+    PyObject* paramValueObj = args[2];
 
-    if (!pl_set_param(hcam, paramId, &paramValue))
+    std::shared_ptr<Camera> cam = GetCamera(self, hcam, false);
+
+    // Get the type for value conversion, SetParamAccess checks it again from cache
+    ParamValue attrValue;
+    if (!GetParamCached(hcam, cam.get(), access.paramId, ATTR_AVAIL, attrValue))
+        return PvcamError();
+    if (!attrValue.val_bool)
+    {
+        access.error = ParamAccess::Error::NotAvailable;
+        return ParamAccessError(access);
+    }
+    if (!GetParamCached(hcam, cam.get(), access.paramId, ATTR_TYPE, attrValue))
         return PvcamError();
+    access.type = attrValue.val_uns16;
+
+    if (!PopulateParamValue(paramValueObj, access))
+        return NULL;
+
+    if (!SetParamAccess(hcam, cam.get(), access))
+        return ParamAccessError(access);
 
     Py_RETURN_NONE;
 }
 
+/**
+ * Converts Python error set to an exception instance, used for per-item
+ * errors in batches. Returns new reference.
+ */
+static PyObject* FetchPyErrAsException()
+{
+    PyObject* type;
+    PyObject* value;
+    PyObject* traceback;
+    PyErr_Fetch(&type, &value, &traceback);
+    PyErr_NormalizeException(&type, &value, &traceback);
+    Py_XDECREF(type);
+    Py_XDECREF(traceback);
+    if (!value)
+    {
+        Py_INCREF(Py_None);
+        return Py_None;
+    }
+    return value;
+}
+
+/**
+ * Reads multiple parameter attributes given as sequence of (id, attr) tuples
+ * with the GIL released. Returns a tuple with values in the same order,
+ * failed items hold the exception instead of value.
+ */
+static PyObject* pvc_get_params(PyObject* self, PyObject* args)
+{
+    int16 hcam;
+    PyObject* itemsObj;
+    if (!PyArg_ParseTuple(args, "hO", &hcam, &itemsObj))
+        return ParamParseError();
+
+    PyObject* itemsSeq = PySequence_Fast(itemsObj, "Parameters must be a sequence.");
+    if (!itemsSeq)
+        return NULL;
+    const Py_ssize_t count = PySequence_Fast_GET_SIZE(itemsSeq);
+    std::vector<ParamAccess> accesses((size_t)count);
+    for (Py_ssize_t n = 0; n < count; n++)
+    {
+        PyObject* itemObj = PySequence_Fast_GET_ITEM(itemsSeq, n);
+        ParamAccess& access = accesses[(size_t)n];
+        if (!PyArg_ParseTuple(itemObj, "Ih", &access.paramId, &access.attr))
+        {
+            Py_DECREF(itemsSeq);
+            return PyErr_Format(PyExc_ValueError,
+                    "Item %zd must be (param_id, attr) tuple.", n);
+        }
+    }
+    Py_DECREF(itemsSeq);
+
+    std::shared_ptr<Camera> cam = GetCamera(self, hcam, false);
+
+    Py_BEGIN_ALLOW_THREADS
+    for (ParamAccess& access : accesses)
+        GetParamAccess(hcam, cam.get(), access);
+    Py_END_ALLOW_THREADS
+
+    PyObject* pyResults = PyTuple_New(count);
+    if (!pyResults)
+        return NULL;
+    for (Py_ssize_t n = 0; n < count; n++)
+    {
+        const ParamAccess& access = accesses[(size_t)n];
+        PyObject* pyResult = (access.error == ParamAccess::Error::None)
+            ? GetNewPyParamValue(access)
+            : ParamAccessError(access);
+        if (!pyResult)
+            pyResult = FetchPyErrAsException();
+        PyTuple_SET_ITEM(pyResults, n, pyResult);
+    }
+    return pyResults;
+}
+
+/**
+ * Sets multiple parameters given as dict {id: value} in dict order with
+ * the GIL released. Values are converted according to the type encoded in
+ * parameter ID. Returns a tuple with None for every parameter set, or
+ * the exception if it failed. Failed items don't stop the batch.
+ */
+static PyObject* pvc_set_params(PyObject* self, PyObject* args)
+{
+    int16 hcam;
+    PyObject* paramsObj;
+    if (!PyArg_ParseTuple(args, "hO!", &hcam, &PyDict_Type, &paramsObj))
+        return ParamParseError();
+
+    const Py_ssize_t count = PyDict_Size(paramsObj);
+    std::vector<ParamAccess> accesses((size_t)count);
+    std::vector<PyObject*> conversionErrors((size_t)count, NULL);
+    auto Cleanup = [&]()
+    {
+        for (PyObject* pyError : conversionErrors)
+            Py_XDECREF(pyError);
+    };
+
+    Py_ssize_t pos = 0;
+    PyObject* keyObj;
+    PyObject* valueObj;
+    for (Py_ssize_t n = 0; PyDict_Next(paramsObj, &pos, &keyObj, &valueObj); n++)
+    {
+        ParamAccess& access = accesses[(size_t)n];
+        access.paramId = (uns32)PyLong_AsUnsignedLong(keyObj);
+        if (PyErr_Occurred())
+        {
+            Cleanup();
+            return PyErr_Format(PyExc_ValueError, "Parameter ID must be an integer.");
+        }
+        access.type = (uns16)((access.paramId >> 24) & 0xFF);
+        if (!PopulateParamValue(valueObj, access))
+            conversionErrors[(size_t)n] = FetchPyErrAsException();
+    }
+
+    std::shared_ptr<Camera> cam = GetCamera(self, hcam, false);
+
+    Py_BEGIN_ALLOW_THREADS
+    for (size_t n = 0; n < accesses.size(); n++)
+    {
+        if (!conversionErrors[n])
+            SetParamAccess(hcam, cam.get(), accesses[n]);
+    }
+    Py_END_ALLOW_THREADS
+
+    PyObject* pyResults = PyTuple_New(count);
+    if (!pyResults)
+    {
+        Cleanup();
+        return NULL;
+    }
+    for (Py_ssize_t n = 0; n < count; n++)
+    {
+        const ParamAccess& access = accesses[(size_t)n];
+        PyObject* pyResult = conversionErrors[(size_t)n];
+        conversionErrors[(size_t)n] = NULL; // Stolen by the tuple
+        if (!pyResult)
+        {
+            if (access.error == ParamAccess::Error::None)
+            {
+                Py_INCREF(Py_None);
+                pyResult = Py_None;
+            }
+            else
+            {
+                ParamAccessError(access);
+                pyResult = FetchPyErrAsException();
+            }
+        }
+        PyTuple_SET_ITEM(pyResults, n, pyResult);
+    }
+    return pyResults;
+}
+
 /** Checks if a specified parameter is available. */
 static PyObject* pvc_check_param(PyObject* self, PyObject* args)
 {
@@ -912,11 +1742,51 @@ static PyObject* pvc_check_param(PyObject* self, PyObject* args)
     if (!PyArg_ParseTuple(args, "hI", &hcam, &paramId))
         return ParamParseError();
 
-    rs_bool avail;
-    if (!pl_get_param(hcam, paramId, ATTR_AVAIL, &avail))
+    std::shared_ptr<Camera> cam = GetCamera(self, hcam, false);
+
+    ParamValue attrValue;
+    if (!GetParamCached(hcam, cam.get(), paramId, ATTR_AVAIL, attrValue))
         return PvcamError();
 
-    return PyBool_FromLong(avail);
+    return PyBool_FromLong(attrValue.val_bool);
+}
+
+/**
+ * Gets the acquisition buffer for new setup, the current one if it fits.
+ * A new one is allocated without holding the camera mutex and the GIL, as
+ * pre-faulting a large buffer may take long. Returns false with Python error
+ * set on failure.
+ */
+static bool PrepareAcqBuffer(Camera& cam, uns32 frameCount, uns32 frameBytes,
+        std::shared_ptr<AcqBuffer>& acqBuffer)
+{
+    AcqBufferPolicy policy;
+    {
+        std::lock_guard<std::mutex> lock(cam.m_mutex);
+        if (cam.CanReuseAcqBuffer(frameCount, frameBytes))
+        {
+            acqBuffer = cam.m_acqBuffer;
+            return true;
+        }
+        policy = cam.m_acqBufferPolicy;
+        // Queued frames of previous acquisition point to the buffer released
+        // to the pool, they would be dropped by the setup anyway
+        cam.m_acqQueue.Reset(0);
+        cam.ReleaseAcqBuffer();
+    }
+
+    Py_BEGIN_ALLOW_THREADS
+    acqBuffer = Camera::NewAcqBuffer(frameCount, frameBytes, policy);
+    Py_END_ALLOW_THREADS
+
+    if (!acqBuffer)
+    {
+        PyErr_Format(PyExc_MemoryError,
+                "Unable to allocate acquisition buffer for %u frame %u bytes each.",
+                frameCount, frameBytes);
+        return false;
+    }
+    return true;
 }
 
 /** Sets up a live acquisition. */
@@ -928,20 +1798,42 @@ static PyObject* pvc_setup_live(PyObject* self, PyObject* args)
     int16 expMode;
     uns32 bufferFrameCount; /* Number of frames in the acquisition buffer */
     char* streamToDiskPath; /* None, or location where to save the data */
-    if (!PyArg_ParseTuple(args, "hO!IhIz", &hcam, &PyList_Type, &roiListObj,
-                &expTime, &expMode, &bufferFrameCount, &streamToDiskPath))
+    char* streamBackend = NULL; /* None or "write", or "io_uring" */
+    int pinFramesInt = 0; /* Must be int, tracks frames pinned by objects pointing to them */
+    if (!PyArg_ParseTuple(args, "hO!IhIz|zi", &hcam, &PyList_Type, &roiListObj,
+                &expTime, &expMode, &bufferFrameCount, &streamToDiskPath, &streamBackend,
+                &pinFramesInt))
         return ParamParseError();
+    // Pinned frames are not overwritten until released, needs at least one spare slot
+    const bool pinFrames = pinFramesInt != 0;
+    if (pinFrames && bufferFrameCount <= 1)
+        return PyErr_Format(PyExc_ValueError,
+                "Pinning frames needs a buffer of at least 2 frames.");
+
+    bool useIoUring = false;
+    if (streamBackend)
+    {
+        useIoUring = strcmp(streamBackend, "io_uring") == 0;
+        if (!useIoUring && strcmp(streamBackend, "write") != 0)
+            return PyErr_Format(PyExc_ValueError,
+                    "Unknown stream to disk backend '%s'.", streamBackend);
+    }
 
     const std::vector<rgn_type> roiArray = PopulateRegions(roiListObj);
     if (roiArray.empty())
         return NULL;
 
+    std::shared_ptr<Camera> cam = GetCamera(self, hcam);
+    if (!cam)
+        return NULL;
+
     uns32 frameBytes;
     if (!pl_exp_setup_cont(hcam, (uns16)roiArray.size(), roiArray.data(),
-                expMode, expTime, &frameBytes, CIRC_OVERWRITE))
+                expMode, expTime, &frameBytes, (pinFrames) ? CIRC_NO_OVERWRITE : CIRC_OVERWRITE))
         return PvcamError();
 
-    if (!pl_cam_register_callback_ex3(hcam, PL_CALLBACK_EOF, (void*)NewFrameHandler, NULL))
+    if (!pl_cam_register_callback_ex3(hcam, PL_CALLBACK_EOF, (void*)NewFrameHandler<Camera>,
+                cam.get()))
         return PvcamError();
 
     bool metadataAvail = false;
@@ -960,29 +1852,43 @@ static PyObject* pvc_setup_live(PyObject* self, PyObject* args)
         }
     }
 
-    std::shared_ptr<Camera> cam = GetCamera(hcam);
-    if (!cam)
+    uns16 bitDepth;
+    if (!GetHostBitDepth(hcam, bitDepth))
+        return NULL;
+
+    uns8 imageCompression;
+    if (!GetImageCompression(hcam, imageCompression))
+        return NULL;
+
+    std::shared_ptr<AcqBuffer> acqBuffer;
+    if (!PrepareAcqBuffer(*cam, bufferFrameCount, frameBytes, acqBuffer))
         return NULL;
 
     {
         std::lock_guard<std::mutex> lock(cam->m_mutex);
 
+        cam->SetAcqBuffer(std::move(acqBuffer), bufferFrameCount, frameBytes);
+
+        // The geometry describes frames in the buffer, set only once it is allocated
         cam->m_metadataEnabled = metadataEnabled;
+        cam->m_imageCompression = imageCompression;
+        cam->m_rois = roiArray;
+        cam->m_frameDims[0] = (roiArray[0].p2 - roiArray[0].p1 + 1) / roiArray[0].pbin;
+        cam->m_frameDims[1] = (roiArray[0].s2 - roiArray[0].s1 + 1) / roiArray[0].sbin;
+        cam->m_typenum = GetPixelTypenum(bitDepth);
 
-        if (!cam->AllocateAcqBuffer(bufferFrameCount, frameBytes))
-            return PyErr_Format(PyExc_MemoryError,
-                    "Unable to allocate acquisition buffer for %u frame %u bytes each.",
-                    bufferFrameCount, frameBytes);
+        cam->m_isSequence = false;
 
-        if (!cam->SetStreamToDisk(streamToDiskPath))
+        if (!cam->SetStreamToDisk(streamToDiskPath, useIoUring, bitDepth))
             return PyErr_Format(PyExc_MemoryError,
                     "Unable to set stream to disk to path '%s'.", streamToDiskPath);
 
-        std::queue<Frame>().swap(cam->m_acqQueue);
-        cam->m_acqQueueCapacity = bufferFrameCount;
+        cam->m_frameSlots->Reset(hcam, cam->m_acqBuffer->data, frameBytes, bufferFrameCount,
+                pinFrames);
+        // Queued frames are still locked, those dropped from queue get unlocked
+        cam->m_acqQueue.Reset((pinFrames) ? cam->m_frameSlots->GetMaxLocked() : bufferFrameCount);
+        cam->ResetAcqStats();
         cam->m_acqAbort = false;
-        cam->m_acqNewFrame = false;
-        cam->m_isSequence = false;
     }
 
     return PyLong_FromUnsignedLong(frameBytes);
@@ -995,22 +1901,87 @@ static PyObject* pvc_setup_seq(PyObject* self, PyObject* args)
     PyObject* roiListObj;
     uns32 expTime;
     int16 expMode;
-    uns16 expTotal;
-    if (!PyArg_ParseTuple(args, "hO!IhH", &hcam, &PyList_Type, &roiListObj,
-                &expTime, &expMode, &expTotal))
+    uns32 expTotal;
+    char* streamToDiskPath = NULL; /* None, or location where to save the data */
+    char* streamBackend = NULL; /* None or "write", or "io_uring" */
+    PyObject* expTimesObj = Py_None; /* None, or VTM exposure times applied in turn */
+    if (!PyArg_ParseTuple(args, "hO!IhI|zzO", &hcam, &PyList_Type, &roiListObj,
+                &expTime, &expMode, &expTotal, &streamToDiskPath, &streamBackend,
+                &expTimesObj))
+        return ParamParseError();
+    if (expTotal == 0)
         return ParamParseError();
 
+    std::vector<uns16> expTimes;
+    if (expTimesObj != Py_None)
+    {
+        PyObject* seq = PySequence_Fast(expTimesObj, "Exposure times must be a sequence.");
+        if (!seq)
+            return NULL;
+        const Py_ssize_t count = PySequence_Fast_GET_SIZE(seq);
+        for (Py_ssize_t n = 0; n < count; n++)
+        {
+            const unsigned long value = PyLong_AsUnsignedLong(PySequence_Fast_GET_ITEM(seq, n));
+            if (PyErr_Occurred() || value == 0
+                    || value > (std::numeric_limits<uns16>::max)())
+            {
+                Py_DECREF(seq);
+                PyErr_Clear();
+                return PyErr_Format(PyExc_ValueError,
+                        "VTM exposure times must be between 1 and %u.",
+                        (unsigned)(std::numeric_limits<uns16>::max)());
+            }
+            expTimes.push_back((uns16)value);
+        }
+        Py_DECREF(seq);
+        if (expTimes.empty())
+            return PyErr_Format(PyExc_ValueError, "No VTM exposure times given.");
+    }
+
+    bool useIoUring = false;
+    if (streamBackend)
+    {
+        useIoUring = strcmp(streamBackend, "io_uring") == 0;
+        if (!useIoUring && strcmp(streamBackend, "write") != 0)
+            return PyErr_Format(PyExc_ValueError,
+                    "Unknown stream to disk backend '%s'.", streamBackend);
+    }
+
     const std::vector<rgn_type> roiArray = PopulateRegions(roiListObj);
     if (roiArray.empty())
         return NULL;
 
+    std::shared_ptr<Camera> cam = GetCamera(self, hcam);
+    if (!cam)
+        return NULL;
+
+    // PVCAM acquires up to 65535 frames in up to 4GB buffer at once,
+    // longer sequences are split into segments started one by one
     uns32 acqBufferBytes;
-    if (!pl_exp_setup_seq(hcam, expTotal, (uns16)roiArray.size(), roiArray.data(),
+    if (!pl_exp_setup_seq(hcam, 1, (uns16)roiArray.size(), roiArray.data(),
                 expMode, expTime, &acqBufferBytes))
         return PvcamError();
-    const uns32 frameBytes = acqBufferBytes / expTotal;
+    const uint64_t maxSegmentFrames = (std::min)(
+            (uint64_t)(std::numeric_limits<uns16>::max)(),
+            (uint64_t)(std::numeric_limits<uns32>::max)() / acqBufferBytes);
+    // Every VTM frame is started separately with its own exposure time
+    const uns32 segmentFrames = (expTimes.empty())
+        ? (uns32)(std::min)((uint64_t)expTotal, maxSegmentFrames)
+        : 1;
+    const uns32 segmentSlots = (expTimes.empty())
+        ? 1
+        : (uns32)(std::min)((uint64_t)(std::min)(expTotal, SEQ_SEGMENT_SLOTS),
+                (uint64_t)(std::numeric_limits<uns32>::max)() / acqBufferBytes);
+    if (segmentFrames > 1)
+    {
+        if (!pl_exp_setup_seq(hcam, (uns16)segmentFrames, (uns16)roiArray.size(),
+                    roiArray.data(), expMode, expTime, &acqBufferBytes))
+            return PvcamError();
+    }
+    const uns32 frameBytes = acqBufferBytes / segmentFrames;
 
-    if (!pl_cam_register_callback_ex3(hcam, PL_CALLBACK_EOF, (void*)NewFrameHandler, NULL))
+    if (!pl_cam_register_callback_ex3(hcam, PL_CALLBACK_EOF, (void*)NewFrameHandler<Camera>,
+                cam.get()))
         return PvcamError();
 
     bool metadataAvail = false;
@@ -1029,30 +2000,87 @@ static PyObject* pvc_setup_seq(PyObject* self, PyObject* args)
         }
     }
 
-    std::shared_ptr<Camera> cam = GetCamera(hcam);
-    if (!cam)
+    uns16 bitDepth;
+    if (!GetHostBitDepth(hcam, bitDepth))
+        return NULL;
+
+    uns8 imageCompression;
+    if (!GetImageCompression(hcam, imageCompression))
+        return NULL;
+
+    std::shared_ptr<AcqBuffer> acqBuffer;
+    if (!PrepareAcqBuffer(*cam, segmentFrames * segmentSlots, frameBytes, acqBuffer))
         return NULL;
 
     {
         std::lock_guard<std::mutex> lock(cam->m_mutex);
 
+        cam->SetAcqBuffer(std::move(acqBuffer), segmentFrames * segmentSlots, frameBytes);
+
+        // The geometry describes frames in the buffer, set only once it is allocated
         cam->m_metadataEnabled = metadataEnabled;
+        cam->m_imageCompression = imageCompression;
+        cam->m_rois = roiArray;
+        cam->m_frameDims[0] = (roiArray[0].p2 - roiArray[0].p1 + 1) / roiArray[0].pbin;
+        cam->m_frameDims[1] = (roiArray[0].s2 - roiArray[0].s1 + 1) / roiArray[0].sbin;
+        cam->m_typenum = GetPixelTypenum(bitDepth);
 
-        if (!cam->AllocateAcqBuffer(expTotal, frameBytes))
+        cam->m_isSequence = true;
+        cam->m_seqTotal = expTotal;
+        cam->m_seqSegmentFrames = segmentFrames;
+        cam->m_seqSetupFrames = segmentFrames;
+        cam->m_seqExpMode = expMode;
+        cam->m_seqExpTime = expTime;
+        cam->m_seqExpTimes = std::move(expTimes);
+        cam->m_seqExpTimeIndex = 0;
+        cam->m_seqSegmentSlots = segmentSlots;
+
+        if (!cam->SetStreamToDisk(streamToDiskPath, useIoUring, bitDepth))
             return PyErr_Format(PyExc_MemoryError,
-                    "Unable to allocate acquisition buffer for %u frame %u bytes each.",
-                    (uns32)expTotal, frameBytes);
+                    "Unable to set stream to disk to path '%s'.", streamToDiskPath);
 
-        std::queue<Frame>().swap(cam->m_acqQueue);
-        cam->m_acqQueueCapacity = expTotal;
+        cam->m_frameSlots->Reset(hcam, NULL, 0, 0, false);
+        cam->m_acqQueue.Reset(segmentFrames * segmentSlots);
+        cam->ResetAcqStats();
         cam->m_acqAbort = false;
-        cam->m_acqNewFrame = false;
-        cam->m_isSequence = true;
+    }
+
+    // Segments after the first one are started by the re-arm thread
+    if (segmentFrames * segmentSlots < expTotal)
+    {
+        Camera* camPtr = cam.get(); // The camera stops the thread before destruction
+        if (!cam->m_seqRearmThread.Start([hcam, camPtr]() { RearmSeq(hcam, *camPtr); }))
+            return PyErr_Format(PyExc_RuntimeError,
+                    "Unable to start thread for sequence segments.");
+    }
+    else
+    {
+        cam->m_seqRearmThread.Stop();
     }
 
     return PyLong_FromUnsignedLong(frameBytes);
 }
 
+/** Starts already set up live acquisition, doesn't touch Python. Returns false on PVCAM error. */
+static bool StartLive(int16 hcam, Camera& cam)
+{
+    void* acqBuffer = NULL;
+    uns32 acqBufferBytes = 0;
+    {
+        std::lock_guard<std::mutex> lock(cam.m_mutex);
+
+        cam.m_fpsFrameCnt = 0;
+        cam.m_fpsLastTime = std::chrono::high_resolution_clock::now();
+        cam.m_acqCbError.clear();
+        cam.m_lastFrameNr = 0;
+
+        acqBuffer = cam.m_acqBuffer->data;
+        acqBufferBytes = (uns32)cam.m_acqBuffer->size;
+    }
+
+    return pl_exp_start_cont(hcam, acqBuffer, acqBufferBytes) != PV_FAIL;
+}
+
 /** Starts already set up live acquisition. */
 static PyObject* pvc_start_set_live(PyObject* self, PyObject* args)
 {
@@ -1060,27 +2088,40 @@ static PyObject* pvc_start_set_live(PyObject* self, PyObject* args)
     if (!PyArg_ParseTuple(args, "h", &hcam))
         return ParamParseError();
 
-    std::shared_ptr<Camera> cam = GetCamera(hcam);
+    std::shared_ptr<Camera> cam = GetCamera(self, hcam);
     if (!cam)
         return NULL;
 
-    void* acqBuffer = NULL;
-    uns32 acqBufferBytes = 0;
-    {
-        std::lock_guard<std::mutex> lock(cam->m_mutex);
+    if (!StartLive(hcam, *cam))
+        return PvcamError();
 
-        cam->m_fpsFrameCnt = 0;
-        cam->m_fpsLastTime = std::chrono::high_resolution_clock::now();
-        cam->m_acqCbError.clear();
+    Py_RETURN_NONE;
+}
 
-        acqBuffer = cam->m_acqBuffer->data;
-        acqBufferBytes = (uns32)cam->m_acqBuffer->size;
+/**
+ * Starts already set up sequence from its first segment, doesn't touch Python.
+ * A restarted sequence continues with next VTM exposure time and cycle time
+ * measurement. Returns false on PVCAM error.
+ */
+static bool StartSeq(int16 hcam, Camera& cam, bool restart = false)
+{
+    {
+        std::lock_guard<std::mutex> lock(cam.m_mutex);
+
+        cam.m_fpsFrameCnt = 0;
+        cam.m_fpsLastTime = std::chrono::high_resolution_clock::now();
+        cam.m_acqCbError.clear();
+        cam.m_lastFrameNr = 0;
+        cam.m_seqFrameBase = 0;
+        cam.m_seqRearm = true;
+        if (!restart)
+        {
+            cam.m_seqExpTimeIndex = 0;
+            cam.m_seqLastEofTime = std::chrono::high_resolution_clock::time_point();
+        }
     }
 
-    if (!pl_exp_start_cont(hcam, acqBuffer, acqBufferBytes))
-        return PvcamError();
-
-    Py_RETURN_NONE;
+    return StartSeqSegment(hcam, cam);
 }
 
 /** Starts already set up sequence acquisition. */
@@ -1090,22 +2131,11 @@ static PyObject* pvc_start_set_seq(PyObject* self, PyObject* args)
     if (!PyArg_ParseTuple(args, "h", &hcam))
         return ParamParseError();
 
-    std::shared_ptr<Camera> cam = GetCamera(hcam);
+    std::shared_ptr<Camera> cam = GetCamera(self, hcam);
     if (!cam)
         return NULL;
 
-    void* acqBuffer = NULL;
-    {
-        std::lock_guard<std::mutex> lock(cam->m_mutex);
-
-        cam->m_fpsFrameCnt = 0;
-        cam->m_fpsLastTime = std::chrono::high_resolution_clock::now();
-        cam->m_acqCbError.clear();
-
-        acqBuffer = cam->m_acqBuffer->data;
-    }
-
-    if (!pl_exp_start_seq(hcam, acqBuffer))
+    if (!StartSeq(hcam, *cam))
         return PvcamError();
 
     Py_RETURN_NONE;
@@ -1118,14 +2148,15 @@ static PyObject* pvc_start_live(PyObject* self, PyObject* args)
     if (!frameBytesObj)
         return NULL;
 
-    PyObject* arg1 = PyTuple_GetSlice(args, 0, 1); // Just hcam
-    if (!arg1)
-        return NULL;
-
-    if (!pvc_start_set_live(self, arg1))
-        frameBytesObj = NULL;
+    // Already parsed by setup function, hcam is valid
+    const int16 hcam = (int16)PyLong_AsLong(PyTuple_GET_ITEM(args, 0));
+    std::shared_ptr<Camera> cam = GetCamera(self, hcam);
+    if (!cam || !StartLive(hcam, *cam))
+    {
+        Py_DECREF(frameBytesObj);
+        return (cam) ? PvcamError() : NULL;
+    }
 
-    Py_DECREF(arg1);
     return frameBytesObj;
 }
 
@@ -1136,25 +2167,27 @@ static PyObject* pvc_start_seq(PyObject* self, PyObject* args)
     if (!frameBytesObj)
         return NULL;
 
-    PyObject* arg1 = PyTuple_GetSlice(args, 0, 1); // Just hcam
-    if (!arg1)
-        return NULL;
-
-    if (!pvc_start_set_seq(self, arg1))
-        frameBytesObj = NULL;
+    // Already parsed by setup function, hcam is valid
+    const int16 hcam = (int16)PyLong_AsLong(PyTuple_GET_ITEM(args, 0));
+    std::shared_ptr<Camera> cam = GetCamera(self, hcam);
+    if (!cam || !StartSeq(hcam, *cam))
+    {
+        Py_DECREF(frameBytesObj);
+        return (cam) ? PvcamError() : NULL;
+    }
 
-    Py_DECREF(arg1);
     return frameBytesObj;
 }
 
 /** Returns current acquisition status, works during acquisition only. */
-static PyObject* pvc_check_frame_status(PyObject* self, PyObject* args)
+static PyObject* pvc_check_frame_status(PyObject* self, PyObject* const* args,
+        Py_ssize_t nargs)
 {
     int16 hcam;
-    if (!PyArg_ParseTuple(args, "h", &hcam))
+    if (nargs != 1 || !ArgAsInt16(args[0], hcam))
         return ParamParseError();
 
-    std::shared_ptr<Camera> cam = GetCamera(hcam);
+    std::shared_ptr<Camera> cam = GetCamera(self, hcam);
     if (!cam)
         return NULL;
 
@@ -1192,35 +2225,128 @@ static PyObject* pvc_check_frame_status(PyObject* self, PyObject* args)
     }
 }
 
-static PyObject* pvc_get_frame(PyObject* self, PyObject* args)
+/**
+ * Validates given PL_IMAGE_COMPRESSIONS value and the size of data compressed
+ * with it, and returns NumPy type number of decompressed pixels.
+ * Returns NPY_NOTYPE with Python error set on failure.
+ */
+static int GetUnpackedTypenum(uns8 compression, size_t count, size_t dataBytes)
 {
-    int16 hcam;
-    PyObject* roiListObj;
-    int typenum; // Numpy typenum specifying data type for image data
-    int timeoutMs; // Poll frame timeout in ms, negative values will wait forever
-    int oldestFrameInt; // Must be int, "p" format for bool breaks other args
-    if (!PyArg_ParseTuple(args, "hO!iii", &hcam, &PyList_Type, &roiListObj,
-                &typenum, &timeoutMs, &oldestFrameInt))
-        return ParamParseError();
-    bool oldestFrame = (bool)oldestFrameInt;
+    if (!BitPackIsSupported(compression))
+    {
+        PyErr_Format(PyExc_NotImplementedError,
+                "Unsupported image compression (%u).", (unsigned)compression);
+        return NPY_NOTYPE;
+    }
+    if (BitPackPackedBytes(count, compression) > dataBytes)
+    {
+        PyErr_Format(PyExc_RuntimeError,
+                "Compressed pixel data size does not match ROI size.");
+        return NPY_NOTYPE;
+    }
+    return (BitPackUnpackedPixelBytes(compression) == sizeof(uns16))
+        ? NPY_UINT16
+        : NPY_UINT32;
+}
 
-    std::shared_ptr<Camera> cam = GetCamera(hcam);
-    if (!cam)
+/**
+ * Creates a new array with given shape and unpacks the compressed pixels
+ * into it. Returns NULL with Python error set on failure.
+ */
+static PyObject* GetNewPyArrayUnpacked(int numDims, npy_intp* dims, const void* data,
+        size_t dataBytes, uns8 compression)
+{
+    const npy_intp count = PyArray_MultiplyList(dims, numDims);
+    const int typenum = GetUnpackedTypenum(compression, (size_t)count, dataBytes);
+    if (typenum == NPY_NOTYPE)
         return NULL;
 
-    bool isSequence = false;
+    PyObject* pyArray = PyArray_SimpleNew(numDims, dims, typenum);
+    if (!pyArray)
+        return NULL;
+    void* dst = PyArray_DATA((PyArrayObject*)pyArray);
+
+    Py_BEGIN_ALLOW_THREADS
+    BitUnpack(data, (size_t)count, compression, dst);
+    Py_END_ALLOW_THREADS
+
+    return pyArray;
+}
+
+/** Keeps the acquisition buffer and optionally the frame in its slot alive. */
+struct AcqBufferOwner
+{
+    std::shared_ptr<AcqBuffer> acqBuffer;
+    FrameSlotExport pinExport;
+};
+
+/**
+ * Makes given array, created on top of the acquisition buffer, an owner
+ * of that buffer. The buffer thus outlives the camera or next setup until
+ * the array is deleted. With a pin given, the array exports the frame and
+ * PVCAM doesn't overwrite it until then, the caller must keep the frame in
+ * place with an export of its own until this returns. Returns false with
+ * Python error set on failure.
+ */
+static bool SetAcqBufferAsArrayBase(PyObject* pyArray,
+        const std::shared_ptr<AcqBuffer>& acqBuffer,
+        const std::shared_ptr<FrameSlotPin>& pin = std::shared_ptr<FrameSlotPin>())
+{
+    auto* owner = new(std::nothrow) AcqBufferOwner{ acqBuffer, FrameSlotExport(pin) };
+    if (!owner)
     {
-        std::lock_guard<std::mutex> lock(cam->m_mutex);
-        isSequence = cam->m_isSequence;
+        PyErr_Format(PyExc_MemoryError, "Unable to allocate capsule owner");
+        return false;
+    }
+
+    static constexpr const char* CAPSULE_NAME = "pvc.AcqBuffer";
+
+    auto capsuleDtor = [](PyObject* capsule)
+    {
+        void* ptr = PyCapsule_GetPointer(capsule, CAPSULE_NAME);
+        if (ptr)
+        {
+            auto* owner = reinterpret_cast<AcqBufferOwner*>(ptr);
+            delete owner; // Drops refcounts, maybe frees buffer or unpins slot if last
+        }
+    };
+
+    PyObject* capsule = PyCapsule_New((void*)owner, CAPSULE_NAME, capsuleDtor);
+    if (!capsule)
+    {
+        delete owner;
+        return false;
+    }
+
+    if (PyArray_SetBaseObject((PyArrayObject*)pyArray, capsule) < 0)
+    {
+        Py_DECREF(capsule); // Calls owner's destructor, drops refcount
+        return false;
     }
 
+    return true;
+}
+
+/**
+ * Waits until the callback queues a frame, the acquisition ends or fails,
+ * or the timeout expires. Expects unlocked camera mutex that stays locked on
+ * return. Returns false with Python error set if the acquisition cannot
+ * deliver frames anymore. An expired timeout is not reported as an error.
+ */
+static bool WaitForFrame(int16 hcam, Camera& cam, std::unique_lock<std::mutex>& lock,
+        int timeoutMs)
+{
+    lock.lock();
+    const bool isSequence = cam.m_isSequence;
+    lock.unlock();
+
     int16 status;
     uns32 dummy;
     rs_bool checkStatusResult = (isSequence)
         ? pl_exp_check_status(hcam, &status, &dummy)
         : pl_exp_check_cont_status(hcam, &status, &dummy, &dummy);
 
-    std::unique_lock<std::mutex> lock(cam->m_mutex);
+    lock.lock();
 
     if (timeoutMs != 0)
     {
@@ -1231,450 +2357,2686 @@ static PyObject* pvc_get_frame(PyObject* self, PyObject* args)
                 ? std::chrono::milliseconds(timeoutMs)
                 : std::chrono::hours(24 * 365 * 100)); // WAIT_FOREVER ~ 100 years
 
-        // Release the GIL to allow other Python threads to run
-        Py_BEGIN_ALLOW_THREADS
-
         // Exit loop if readout finished or failed, new data available,
         // abort occurred or timeout expired
-        while (checkStatusResult && !cam->m_acqNewFrame && !cam->m_acqAbort
-                && cam->m_acqCbError.empty()
-                && status != READOUT_FAILED && status != READOUT_NOT_ACTIVE)
+        auto keepWaiting = [&]()
         {
-            const auto now = std::chrono::high_resolution_clock::now();
-            if (now >= timeEnd)
-                break;
-
-            auto timeNext = (std::min)(now + timeStep, timeEnd);
-            cam->m_acqCond.wait_until(lock, timeNext);
+            return checkStatusResult && cam.m_acqQueue.Empty() && !cam.m_acqAbort
+                && cam.m_acqCbError.empty()
+                && status != READOUT_FAILED && status != READOUT_NOT_ACTIVE
+                && std::chrono::high_resolution_clock::now() < timeEnd;
+        };
 
+        while (keepWaiting())
+        {
+            // Release the GIL to allow other Python threads to run. The lock is
+            // never held while taking the GIL back, because other threads may
+            // wait for the lock with the GIL held.
             lock.unlock();
+            Py_BEGIN_ALLOW_THREADS
+            lock.lock();
 
-            checkStatusResult = (isSequence)
-                ? pl_exp_check_status(hcam, &status, &dummy)
-                : pl_exp_check_cont_status(hcam, &status, &dummy, &dummy);
+            cam.m_acqWaiters++;
+            while (keepWaiting())
+            {
+                const auto timeNext = (std::min)(
+                        std::chrono::high_resolution_clock::now() + timeStep, timeEnd);
+                cam.m_acqCond.wait_until(lock, timeNext);
 
-            lock.lock();
-        }
+                lock.unlock();
+
+                checkStatusResult = (isSequence)
+                    ? pl_exp_check_status(hcam, &status, &dummy)
+                    : pl_exp_check_cont_status(hcam, &status, &dummy, &dummy);
+
+                lock.lock();
+            }
+            cam.m_acqWaiters--;
 
-        Py_END_ALLOW_THREADS
+            lock.unlock();
+            Py_END_ALLOW_THREADS
+            lock.lock(); // Another thread may have taken the frame meanwhile
+        }
     }
 
     if (!checkStatusResult)
     {
-        cam->m_acqNewFrame = false;
-        return PvcamError();
+        PvcamError();
+        return false;
     }
     if (status == READOUT_FAILED)
     {
-        cam->m_acqNewFrame = false;
-        return PyErr_Format(PyExc_RuntimeError, "Frame readout failed.");
+        PyErr_Format(PyExc_RuntimeError, "Frame readout failed.");
+        return false;
     }
     if (status == READOUT_NOT_ACTIVE)
     {
-        cam->m_acqNewFrame = false;
-        return PyErr_Format(PyExc_RuntimeError, "Acquisition not active.");
+        PyErr_Format(PyExc_RuntimeError, "Acquisition not active.");
+        return false;
     }
-    if (!cam->m_acqCbError.empty())
+    if (!cam.m_acqCbError.empty())
     {
-        cam->m_acqNewFrame = false;
-        return PyErr_Format(PyExc_RuntimeError, "%s", cam->m_acqCbError.c_str());
+        PyErr_Format(PyExc_RuntimeError, "%s", cam.m_acqCbError.c_str());
+        return false;
     }
-    if (cam->m_acqAbort)
+    if (cam.m_acqAbort)
     {
-        cam->m_acqAbort = false;
-        cam->m_acqNewFrame = false;
-        return PyErr_Format(PyExc_RuntimeError, "Acquisition aborted.");
+        cam.m_acqAbort = false;
+        PyErr_Format(PyExc_RuntimeError, "Acquisition aborted.");
+        return false;
     }
-    if (!cam->m_acqNewFrame)
+    return true;
+}
+
+/** Converts the frame header of any version to the version-independent record. */
+static void FillMdFrameHeaderRecord(const md_frame_header* pFrameHdr,
+        MdFrameHeaderRecord& record)
+{
+    memcpy(record.signature, &pFrameHdr->signature, sizeof(record.signature));
+    record.version = pFrameHdr->version;
+    record.frameNr = pFrameHdr->frameNr;
+    record.roiCount = pFrameHdr->roiCount;
+    if (pFrameHdr->version >= 3)
     {
-        cam->m_acqAbort = false;
-        return PyErr_Format(PyExc_RuntimeError, "Frame timeout."
-                " Verify the timeout exceeds the exposure time."
-                " If applicable, check external trigger source.");
+        auto pFrameHdrV3 = reinterpret_cast<const md_frame_header_v3*>(pFrameHdr);
+        record.timestampBofPs = pFrameHdrV3->timestampBOF;
+        record.timestampEofPs = pFrameHdrV3->timestampEOF;
+        record.exposureTimePs = pFrameHdrV3->exposureTime;
     }
-
-    Frame frame;
-    if (oldestFrame)
+    else
+    {
+        record.timestampBofPs = 1000ULL * pFrameHdr->timestampResNs    * pFrameHdr->timestampBOF;
+        record.timestampEofPs = 1000ULL * pFrameHdr->timestampResNs    * pFrameHdr->timestampEOF;
+        record.exposureTimePs = 1000ULL * pFrameHdr->exposureTimeResNs * pFrameHdr->exposureTime;
+    }
+    record.bitDepth = pFrameHdr->bitDepth;
+    record.colorMask = pFrameHdr->colorMask;
+    record.flags = pFrameHdr->flags;
+    record.extendedMdSize = pFrameHdr->extendedMdSize;
+    if (pFrameHdr->version >= 2)
     {
-        frame = cam->m_acqQueue.front();
-        cam->m_acqQueue.pop();
+        record.imageFormat = pFrameHdr->imageFormat;
+        record.imageCompression = pFrameHdr->imageCompression;
     }
     else
     {
-        frame = cam->m_acqQueue.back();
+        record.imageFormat = (uns8)PL_IMAGE_FORMAT_MONO16;
+        record.imageCompression = (uns8)PL_IMAGE_COMPRESSION_NONE;
     }
+}
 
-    cam->m_acqNewFrame = !cam->m_acqQueue.empty();
+/**
+ * Returns new NumPy dtype of MdFrameHeaderRecord, created once per module and
+ * kept in its state. Returns NULL with Python error set on failure.
+ */
+static PyArray_Descr* GetNewMdFrameHeaderDescr()
+{
+    PyObject* fields = Py_BuildValue(
+            "[(ss),(ss),(ss),(ss),(ss),(ss),(ss),(ss),(ss),(ss),(ss),(ss),(ss)]",
+            "signature", "S4",
+            "version", "u1",
+            "frameNr", "<u4",
+            "roiCount", "<u2",
+            "timestampBofPs", "<u8",
+            "timestampEofPs", "<u8",
+            "exposureTimePs", "<u8",
+            "bitDepth", "u1",
+            "colorMask", "u1",
+            "flags", "u1",
+            "extendedMdSize", "<u2",
+            "imageFormat", "u1",
+            "imageCompression", "u1");
+    if (!fields)
+        return NULL;
+    PyArray_Descr* descr = NULL;
+    const int converted = PyArray_DescrConverter(fields, &descr);
+    Py_DECREF(fields);
+    if (!converted)
+        return NULL;
+    return descr;
+}
 
-    //printf("New Data - FPS: %.1f, Cnt: %u, Nr: %u\n",
-    //        cam->m_fps, frame.count, frame.nr);
+/** Same as GetNewMdFrameHeaderDescr for MdRoiHeaderRecord. */
+static PyArray_Descr* GetNewMdRoiHeaderDescr()
+{
+    PyObject* fields = Py_BuildValue(
+            "[(ss),(ss),(ss),(ss),(ss),(ss),(ss),(ss),(ss),(ss),(ss),(ss)]",
+            "roiNr", "<u2",
+            "timestampBOR", "<u4",
+            "timestampEOR", "<u4",
+            "s1", "<u2",
+            "s2", "<u2",
+            "sbin", "<u2",
+            "p1", "<u2",
+            "p2", "<u2",
+            "pbin", "<u2",
+            "flags", "u1",
+            "extendedMdSize", "<u2",
+            "roiDataSize", "<u4");
+    if (!fields)
+        return NULL;
+    PyArray_Descr* descr = NULL;
+    const int converted = PyArray_DescrConverter(fields, &descr);
+    Py_DECREF(fields);
+    if (!converted)
+        return NULL;
+    return descr;
+}
 
-    // Build Python object for new frame
+/** Returns 0-D structured array with the frame header. */
+static PyObject* GetNewPyArrayFrameHdr(const ModuleState& moduleState,
+        const md_frame_header* pFrameHdr)
+{
+    PyArray_Descr* descr = moduleState.mdFrameHeaderDescr;
+    Py_INCREF(descr); // Stolen by PyArray_NewFromDescr
+    PyObject* pyArray = PyArray_NewFromDescr(&PyArray_Type, descr, 0, NULL, NULL, NULL,
+            0, NULL);
+    if (!pyArray)
+        return NULL;
+    auto* record = (MdFrameHeaderRecord*)PyArray_DATA((PyArrayObject*)pyArray);
+    FillMdFrameHeaderRecord(pFrameHdr, *record);
+    return pyArray;
+}
 
-    auto GetNewPyArrayRoiData = [typenum](const rgn_type& roi, void* data,
-                                          std::shared_ptr<AcqBuffer> acqBuffer) -> PyObject*
+/** Returns 1-D structured array with headers of all ROIs in decoded frame. */
+static PyObject* GetNewPyArrayRoiHdrs(const ModuleState& moduleState, const md_frame* mdFrame)
+{
+    PyArray_Descr* descr = moduleState.mdRoiHeaderDescr;
+    npy_intp dims[1] = { (npy_intp)mdFrame->header->roiCount };
+    Py_INCREF(descr); // Stolen by PyArray_NewFromDescr
+    PyObject* pyArray = PyArray_NewFromDescr(&PyArray_Type, descr, 1, dims, NULL, NULL,
+            0, NULL);
+    if (!pyArray)
+        return NULL;
+    auto* records = (MdRoiHeaderRecord*)PyArray_DATA((PyArrayObject*)pyArray);
+    for (npy_intp i = 0; i < dims[0]; i++)
     {
-        // Make heap copy of shared_ptr
-        auto* owner = new(std::nothrow) std::shared_ptr<AcqBuffer>(acqBuffer);
-        if (!owner)
-            return PyErr_Format(PyExc_MemoryError, "Unable to allocate capsule owner");
-
-        npy_intp w = (roi.s2 - roi.s1 + 1) / roi.sbin;
-        npy_intp h = (roi.p2 - roi.p1 + 1) / roi.pbin;
-        constexpr int NUM_DIMS = 2;
-        npy_intp dims[NUM_DIMS] = { h, w };
-        PyObject* pyArray = PyArray_SimpleNewFromData(NUM_DIMS, dims, typenum, data);
-        if (!pyArray)
-        {
-            delete owner;
-            return NULL;
-        }
-
-        static constexpr const char* CAPSULE_NAME = "pvc.AcqBuffer";
-
-        auto capsuleDtor = [](PyObject* capsule)
-        {
-            void* ptr = PyCapsule_GetPointer(capsule, CAPSULE_NAME);
-            if (ptr)
-            {
-                auto* sp = reinterpret_cast<std::shared_ptr<AcqBuffer>*>(ptr);
-                delete sp; // Drops refcount, maybe frees buffer if last
-            }
-        };
-
-        PyObject* capsule = PyCapsule_New((void*)owner, CAPSULE_NAME, capsuleDtor);
-        if (!capsule)
-        {
-            Py_DECREF(pyArray);
-            delete owner;
-            return NULL;
-        }
-
-        if (PyArray_SetBaseObject((PyArrayObject*)pyArray, capsule) < 0)
-        {
-            Py_DECREF(capsule); // Calls owner's destructor, drops refcount
-            Py_DECREF(pyArray);
-            return NULL;
-        }
+        const md_frame_roi_header* pRoiHdr = mdFrame->roiArray[i].header;
+        MdRoiHeaderRecord& record = records[i];
+        record.roiNr = pRoiHdr->roiNr;
+        record.timestampBOR = pRoiHdr->timestampBOR;
+        record.timestampEOR = pRoiHdr->timestampEOR;
+        record.s1 = pRoiHdr->roi.s1;
+        record.s2 = pRoiHdr->roi.s2;
+        record.sbin = pRoiHdr->roi.sbin;
+        record.p1 = pRoiHdr->roi.p1;
+        record.p2 = pRoiHdr->roi.p2;
+        record.pbin = pRoiHdr->roi.pbin;
+        record.flags = pRoiHdr->flags;
+        record.extendedMdSize = pRoiHdr->extendedMdSize;
+        record.roiDataSize = pRoiHdr->roiDataSize;
+    }
+    return pyArray;
+}
 
-        return pyArray;
-    };
-    auto GetNewPyDictRoiHdr = [](const md_frame_roi_header* pRoiHdr) -> PyObject*
-    {
-        PyObject* pyRoi = Py_BuildValue("{s:H,s:H,s:H,s:H,s:H,s:H}", // dict
-                "s1",   pRoiHdr->roi.s1,
-                "s2",   pRoiHdr->roi.s2,
-                "sbin", pRoiHdr->roi.sbin,
-                "p1",   pRoiHdr->roi.p1,
-                "p2",   pRoiHdr->roi.p2,
-                "pbin", pRoiHdr->roi.pbin);
-        if (!pyRoi)
-            return NULL;
+/**
+ * Returns a 2D array with pixel data of given ROI. Compressed pixels are
+ * unpacked to a new array, others are not copied and the array keeps
+ * the acquisition buffer alive.
+ */
+static PyObject* GetNewPyArrayRoiData(const npy_intp (&roiDims)[2], int typenum, void* data,
+        size_t dataBytes, uns8 compression, const std::shared_ptr<AcqBuffer>& acqBuffer,
+        const std::shared_ptr<FrameSlotPin>& pin = std::shared_ptr<FrameSlotPin>())
+{
+    constexpr int NUM_DIMS = 2;
+    npy_intp dims[NUM_DIMS] = { roiDims[0], roiDims[1] };
+    // Frame might have been copied out of its slot, stays where it is from now on
+    const FrameSlotExport frameExport(pin);
+    data = frameExport.Resolve(data);
+    if (compression != PL_IMAGE_COMPRESSION_NONE)
+        return GetNewPyArrayUnpacked(NUM_DIMS, dims, data, dataBytes, compression);
+
+    PyObject* pyArray = PyArray_SimpleNewFromData(NUM_DIMS, dims, typenum, data);
+    if (!pyArray)
+        return NULL;
 
-        PyObject* pyDict = Py_BuildValue("{s:H,s:I,s:I,s:N,s:B,s:H,s:I}", // dict
-                "roiNr", pRoiHdr->roiNr,
-                "timestampBOR", pRoiHdr->timestampBOR,
-                "timestampEOR", pRoiHdr->timestampEOR,
-                "roi", pyRoi,
-                "flags", pRoiHdr->flags,
-                "extendedMdSize", pRoiHdr->extendedMdSize,
-                "roiDataSize", pRoiHdr->roiDataSize);
-        if (!pyDict)
-        {
-            Py_DECREF(pyRoi);
-            return NULL;
-        }
-        return pyDict;
-    };
-    auto GetNewPyDictFrameHdr = [](const md_frame_header* pFrameHdr) -> PyObject*
+    if (!SetAcqBufferAsArrayBase(pyArray, acqBuffer, pin))
     {
-        ulong64 timestampBofPs;
-        ulong64 timestampEofPs;
-        ulong64 exposureTimePs;
-        if (pFrameHdr->version >= 3)
-        {
-            auto pFrameHdrV3 = reinterpret_cast<const md_frame_header_v3*>(pFrameHdr);
-            timestampBofPs = pFrameHdrV3->timestampBOF;
-            timestampEofPs = pFrameHdrV3->timestampEOF;
-            exposureTimePs = pFrameHdrV3->exposureTime;
-        }
-        else
-        {
-            timestampBofPs = 1000ULL * pFrameHdr->timestampResNs    * pFrameHdr->timestampBOF;
-            timestampEofPs = 1000ULL * pFrameHdr->timestampResNs    * pFrameHdr->timestampEOF;
-            exposureTimePs = 1000ULL * pFrameHdr->exposureTimeResNs * pFrameHdr->exposureTime;
-        }
+        Py_DECREF(pyArray);
+        return NULL;
+    }
 
-        uns8 imageFormat;
-        uns8 imageCompression;
-        if (pFrameHdr->version >= 2)
-        {
-            imageFormat = pFrameHdr->imageFormat;
-            imageCompression = pFrameHdr->imageCompression;
-        }
-        else
-        {
-            imageFormat = (uns8)PL_IMAGE_FORMAT_MONO16;
-            imageCompression = (uns8)PL_IMAGE_COMPRESSION_NONE;
-        }
-
-        PyObject* pyDict = Py_BuildValue(
-                "{s:s,s:B,s:I,s:H,s:K,s:K,s:K,s:B,s:B,s:B,s:H,s:B,s:B}", // dict
-                "signature", reinterpret_cast<const char*>(&pFrameHdr->signature),
-                "version", pFrameHdr->version,
-                "frameNr", pFrameHdr->frameNr,
-                "roiCount", pFrameHdr->roiCount,
-                "timestampBofPs", timestampBofPs,
-                "timestampEofPs", timestampEofPs,
-                "exposureTimePs", exposureTimePs,
-                "bitDepth", pFrameHdr->bitDepth,
-                "colorMask", pFrameHdr->colorMask,
-                "flags", pFrameHdr->flags,
-                "extendedMdSize", pFrameHdr->extendedMdSize,
-                "imageFormat", imageFormat,
-                "imageCompression", imageCompression);
-        return pyDict;
-    };
+    return pyArray;
+}
 
-    // Ensure the typenum is valid Numpy type
-    PyArray_Descr* descr = PyArray_DescrFromType(typenum);
-    if (!descr)
-        return PyErr_Format(PyExc_ValueError, "Invalid NumPy type number: %d", typenum);
-    Py_DECREF(descr);
+/** Same as above, with the array shape of given region. */
+static PyObject* GetNewPyArrayRoiData(const rgn_type& roi, int typenum, void* data,
+        size_t dataBytes, uns8 compression, const std::shared_ptr<AcqBuffer>& acqBuffer,
+        const std::shared_ptr<FrameSlotPin>& pin = std::shared_ptr<FrameSlotPin>())
+{
+    const npy_intp dims[2] = {
+        (roi.p2 - roi.p1 + 1) / roi.pbin,
+        (roi.s2 - roi.s1 + 1) / roi.sbin };
+    return GetNewPyArrayRoiData(dims, typenum, data, dataBytes, compression, acqBuffer, pin);
+}
 
-    PyObject* pyFrameDict = PyDict_New();
-    if (!pyFrameDict)
+static PyObject* GetNewPyDictRoiHdr(const md_frame_roi_header* pRoiHdr)
+{
+    PyObject* pyRoi = Py_BuildValue("{s:H,s:H,s:H,s:H,s:H,s:H}", // dict
+            "s1",   pRoiHdr->roi.s1,
+            "s2",   pRoiHdr->roi.s2,
+            "sbin", pRoiHdr->roi.sbin,
+            "p1",   pRoiHdr->roi.p1,
+            "p2",   pRoiHdr->roi.p2,
+            "pbin", pRoiHdr->roi.pbin);
+    if (!pyRoi)
         return NULL;
-    PyObject* pyRoiDataList = NULL;
 
-    if (cam->m_metadataEnabled)
+    PyObject* pyDict = Py_BuildValue("{s:H,s:I,s:I,s:N,s:B,s:H,s:I}", // dict
+            "roiNr", pRoiHdr->roiNr,
+            "timestampBOR", pRoiHdr->timestampBOR,
+            "timestampEOR", pRoiHdr->timestampEOR,
+            "roi", pyRoi,
+            "flags", pRoiHdr->flags,
+            "extendedMdSize", pRoiHdr->extendedMdSize,
+            "roiDataSize", pRoiHdr->roiDataSize);
+    if (!pyDict)
     {
-        md_frame* mdFrame = cam->m_mdFrame;
-        uns32 frameBytes = cam->m_frameBytes;
-
-        lock.unlock();
-
-        const rs_bool frameDecodeResult =
-            pl_md_frame_decode(mdFrame, frame.address, frameBytes);
-
-        lock.lock();
-
-        if (!frameDecodeResult)
-        {
-            Py_DECREF(pyFrameDict);
-            return PvcamError();
-        }
+        Py_DECREF(pyRoi);
+        return NULL;
+    }
+    return pyDict;
+}
 
-        const md_frame_header* pFrameHdr = cam->m_mdFrame->header;
+static PyObject* GetNewPyDictFrameHdr(const md_frame_header* pFrameHdr)
+{
+    MdFrameHeaderRecord hdr;
+    FillMdFrameHeaderRecord(pFrameHdr, hdr);
+    PyObject* pyDict = Py_BuildValue(
+            "{s:s,s:B,s:I,s:H,s:K,s:K,s:K,s:B,s:B,s:B,s:H,s:B,s:B}", // dict
+            "signature", reinterpret_cast<const char*>(&pFrameHdr->signature),
+            "version", hdr.version,
+            "frameNr", hdr.frameNr,
+            "roiCount", hdr.roiCount,
+            "timestampBofPs", hdr.timestampBofPs,
+            "timestampEofPs", hdr.timestampEofPs,
+            "exposureTimePs", hdr.exposureTimePs,
+            "bitDepth", hdr.bitDepth,
+            "colorMask", hdr.colorMask,
+            "flags", hdr.flags,
+            "extendedMdSize", hdr.extendedMdSize,
+            "imageFormat", hdr.imageFormat,
+            "imageCompression", hdr.imageCompression);
+    return pyDict;
+}
 
-        PyObject* pyFrameHdrDict = GetNewPyDictFrameHdr(pFrameHdr);
-        if (!pyFrameHdrDict)
-        {
-            Py_DECREF(pyFrameDict);
-            return NULL;
-        }
+/** Returns the header of decoded frame as dict or structured array. */
+static PyObject* GetNewPyFrameHdr(const ModuleState& moduleState, const md_frame* mdFrame,
+        MetadataFormat format)
+{
+    return (format == MetadataFormat::NumPy)
+        ? GetNewPyArrayFrameHdr(moduleState, mdFrame->header)
+        : GetNewPyDictFrameHdr(mdFrame->header);
+}
 
-        PyObject* pyRoiHdrList = PyList_New(pFrameHdr->roiCount);
-        if (!pyRoiHdrList)
-        {
-            Py_DECREF(pyFrameHdrDict);
-            Py_DECREF(pyFrameDict);
-            return NULL;
-        }
+/** Returns headers of all ROIs in decoded frame as list of dicts or structured array. */
+static PyObject* GetNewPyRoiHdrs(const ModuleState& moduleState, const md_frame* mdFrame,
+        MetadataFormat format)
+{
+    if (format == MetadataFormat::NumPy)
+        return GetNewPyArrayRoiHdrs(moduleState, mdFrame);
 
-        pyRoiDataList = PyList_New(pFrameHdr->roiCount);
-        if (!pyRoiDataList)
+    const uns16 roiCount = mdFrame->header->roiCount;
+    PyObject* pyRoiHdrList = PyList_New(roiCount);
+    if (!pyRoiHdrList)
+        return NULL;
+    for (uns16 i = 0; i < roiCount; i++)
+    {
+        PyObject* pyRoiHdr = GetNewPyDictRoiHdr(mdFrame->roiArray[i].header);
+        if (!pyRoiHdr)
         {
             Py_DECREF(pyRoiHdrList);
-            Py_DECREF(pyFrameHdrDict);
-            Py_DECREF(pyFrameDict);
             return NULL;
         }
+        PyList_SET_ITEM(pyRoiHdrList, (Py_ssize_t)i, pyRoiHdr);
+    }
+    return pyRoiHdrList;
+}
 
-        for (uns32 i = 0; i < pFrameHdr->roiCount; i++)
-        {
-            const md_frame_roi_header* pRoiHdr = cam->m_mdFrame->roiArray[i].header;
-            void* pRoiData = cam->m_mdFrame->roiArray[i].data;
-
-            PyObject* pyRoiHdr = GetNewPyDictRoiHdr(pRoiHdr);
-            if (!pyRoiHdr)
-            {
-                Py_DECREF(pyRoiDataList);
-                Py_DECREF(pyRoiHdrList);
-                Py_DECREF(pyFrameHdrDict);
-                Py_DECREF(pyFrameDict);
-                return NULL;
-            }
-            PyList_SET_ITEM(pyRoiHdrList, (Py_ssize_t)i, pyRoiHdr);
-
-            PyObject* pyRoiData =
-                GetNewPyArrayRoiData(pRoiHdr->roi, pRoiData, cam->m_acqBuffer);
-            if (!pyRoiData)
-            {
-                Py_DECREF(pyRoiDataList);
-                Py_DECREF(pyRoiHdrList);
-                Py_DECREF(pyFrameHdrDict);
-                Py_DECREF(pyFrameDict);
-                return NULL;
-            }
-            PyList_SET_ITEM(pyRoiDataList, (Py_ssize_t)i, pyRoiData);
-        }
+/** Returns a list with pixel data of all ROIs in decoded frame. */
+static PyObject* GetNewPyRoiDataList(const md_frame* mdFrame, int typenum,
+        const std::shared_ptr<AcqBuffer>& acqBuffer,
+        const std::shared_ptr<FrameSlotPin>& pin = std::shared_ptr<FrameSlotPin>())
+{
+    const md_frame_header* pFrameHdr = mdFrame->header;
+    const uns8 compression = (pFrameHdr->version >= 2)
+        ? pFrameHdr->imageCompression
+        : (uns8)PL_IMAGE_COMPRESSION_NONE;
 
-        PyObject* pyMetaDict = Py_BuildValue("{s:N,s:N}", // dict
-                "frame_header", pyFrameHdrDict,
-                "roi_headers", pyRoiHdrList);
-        if (!pyMetaDict)
+    PyObject* pyRoiDataList = PyList_New(pFrameHdr->roiCount);
+    if (!pyRoiDataList)
+        return NULL;
+    for (uns16 i = 0; i < pFrameHdr->roiCount; i++)
+    {
+        const md_frame_roi& mdRoi = mdFrame->roiArray[i];
+        PyObject* pyRoiData = GetNewPyArrayRoiData(mdRoi.header->roi, typenum, mdRoi.data,
+                mdRoi.dataSize, compression, acqBuffer, pin);
+        if (!pyRoiData)
         {
             Py_DECREF(pyRoiDataList);
-            Py_DECREF(pyRoiHdrList);
-            Py_DECREF(pyFrameHdrDict);
-            Py_DECREF(pyFrameDict);
             return NULL;
         }
+        PyList_SET_ITEM(pyRoiDataList, (Py_ssize_t)i, pyRoiData);
+    }
+    return pyRoiDataList;
+}
 
-        if (PyDict_SetItemString(pyFrameDict, "meta_data", pyMetaDict) < 0)
-        {
-            Py_DECREF(pyMetaDict);
-            Py_DECREF(pyRoiDataList);
-            Py_DECREF(pyFrameDict);
-            return NULL;
-        }
-        Py_DECREF(pyMetaDict);
+/** Converts value of extended metadata item, vectors are returned as tuples. */
+static PyObject* GetNewPyExtMdValue(const md_ext_item& item)
+{
+    const uns16 type = item.tagInfo->type;
+    size_t elemSize;
+    switch (type)
+    {
+    case TYPE_INT8:
+    case TYPE_UNS8:
+    case TYPE_BOOLEAN:
+        elemSize = 1;
+        break;
+    case TYPE_INT16:
+    case TYPE_UNS16:
+        elemSize = 2;
+        break;
+    case TYPE_INT32:
+    case TYPE_UNS32:
+    case TYPE_ENUM:
+    case TYPE_FLT32:
+        elemSize = 4;
+        break;
+    case TYPE_INT64:
+    case TYPE_UNS64:
+    case TYPE_FLT64:
+        elemSize = 8;
+        break;
+    default:
+        return PyBytes_FromStringAndSize((const char*)item.value, item.tagInfo->size);
     }
-    else
+
+    auto GetNewPyElem = [type](const uns8* p) -> PyObject*
     {
-        // Construct ROI list with 1 region only, because metadata is disabled
-        const std::vector<rgn_type> rois = PopulateRegions(roiListObj);
-        if (rois.empty())
+        switch (type)
         {
-            Py_DECREF(pyFrameDict);
-            return NULL;
+        case TYPE_INT8: { int8 v; memcpy(&v, p, sizeof(v)); return PyLong_FromLong(v); }
+        case TYPE_UNS8: { uns8 v; memcpy(&v, p, sizeof(v)); return PyLong_FromUnsignedLong(v); }
+        case TYPE_BOOLEAN: { rs_bool v; memcpy(&v, p, sizeof(v)); return PyBool_FromLong(v); }
+        case TYPE_INT16: { int16 v; memcpy(&v, p, sizeof(v)); return PyLong_FromLong(v); }
+        case TYPE_UNS16: { uns16 v; memcpy(&v, p, sizeof(v)); return PyLong_FromUnsignedLong(v); }
+        case TYPE_INT32:
+        case TYPE_ENUM: { int32 v; memcpy(&v, p, sizeof(v)); return PyLong_FromLong(v); }
+        case TYPE_UNS32: { uns32 v; memcpy(&v, p, sizeof(v)); return PyLong_FromUnsignedLong(v); }
+        case TYPE_FLT32: { flt32 v; memcpy(&v, p, sizeof(v)); return PyFloat_FromDouble(v); }
+        case TYPE_INT64: { long64 v; memcpy(&v, p, sizeof(v)); return PyLong_FromLongLong(v); }
+        case TYPE_UNS64:
+            { ulong64 v; memcpy(&v, p, sizeof(v)); return PyLong_FromUnsignedLongLong(v); }
+        default: { flt64 v; memcpy(&v, p, sizeof(v)); return PyFloat_FromDouble(v); }
         }
+    };
 
-        pyRoiDataList = PyList_New(1);
-        if (!pyRoiDataList)
+    const uns8* value = (const uns8*)item.value;
+    const size_t count = item.tagInfo->size / elemSize;
+    if (count == 1)
+        return GetNewPyElem(value);
+
+    PyObject* pyTuple = PyTuple_New((Py_ssize_t)count);
+    if (!pyTuple)
+        return NULL;
+    for (size_t n = 0; n < count; n++)
+    {
+        PyObject* pyElem = GetNewPyElem(value + n * elemSize);
+        if (!pyElem)
         {
-            Py_DECREF(pyFrameDict);
+            Py_DECREF(pyTuple);
             return NULL;
         }
+        PyTuple_SET_ITEM(pyTuple, (Py_ssize_t)n, pyElem);
+    }
+    return pyTuple;
+}
 
-        PyObject* pyRoiData =
-            GetNewPyArrayRoiData(rois[0], frame.address, cam->m_acqBuffer);
-        if (!pyRoiData)
+/** Returns a dict with extended metadata items by tag name. */
+static PyObject* GetNewPyDictExtMd(void* extMdData, uns16 extMdDataSize)
+{
+    PyObject* pyDict = PyDict_New();
+    if (!pyDict || !extMdData || extMdDataSize == 0)
+        return pyDict;
+
+    md_ext_item_collection collection;
+    if (!pl_md_read_extended(&collection, extMdData, extMdDataSize))
+    {
+        Py_DECREF(pyDict);
+        return PvcamError();
+    }
+    for (uns16 n = 0; n < collection.count; n++)
+    {
+        const md_ext_item& item = collection.list[n];
+        PyObject* pyValue = GetNewPyExtMdValue(item);
+        if (!pyValue || PyDict_SetItemString(pyDict, item.tagInfo->name, pyValue) < 0)
         {
-            Py_DECREF(pyRoiDataList);
-            Py_DECREF(pyFrameDict);
+            Py_XDECREF(pyValue);
+            Py_DECREF(pyDict);
             return NULL;
         }
-        PyList_SET_ITEM(pyRoiDataList, 0, pyRoiData);
+        Py_DECREF(pyValue);
     }
+    return pyDict;
+}
 
-    if (PyDict_SetItemString(pyFrameDict, "pixel_data", pyRoiDataList) < 0)
+/**
+ * Returns a dict with particle IDs and M0 and M2 moments of all ROIs in decoded
+ * frame as columnar uint32 arrays, with one row per ROI like the ROI headers.
+ * The 'valid' array tells which ROIs carried any of the particle tags.
+ * Returns None if no ROI has extended metadata, e.g. with centroids disabled.
+ */
+static PyObject* GetNewPyParticles(const md_frame* mdFrame)
+{
+    if (!HasParticleExtMd(mdFrame))
+        Py_RETURN_NONE;
+
+    npy_intp dims[1] = { (npy_intp)mdFrame->header->roiCount };
+    PyObject* pyIds = PyArray_ZEROS(1, dims, NPY_UINT32, 0);
+    PyObject* pyM0 = PyArray_ZEROS(1, dims, NPY_UINT32, 0);
+    PyObject* pyM2 = PyArray_ZEROS(1, dims, NPY_UINT32, 0);
+    PyObject* pyValid = PyArray_ZEROS(1, dims, NPY_BOOL, 0);
+    auto Cleanup = [&]()
     {
-        Py_DECREF(pyRoiDataList);
-        Py_DECREF(pyFrameDict);
-        return NULL;
+        Py_XDECREF(pyIds);
+        Py_XDECREF(pyM0);
+        Py_XDECREF(pyM2);
+        Py_XDECREF(pyValid);
+    };
+    if (!pyIds || !pyM0 || !pyM2 || !pyValid)
+    {
+        Cleanup();
+        return NULL;
+    }
+    ParticleColumns columns;
+    columns.ids = (uns32*)PyArray_DATA((PyArrayObject*)pyIds);
+    columns.m0 = (uns32*)PyArray_DATA((PyArrayObject*)pyM0);
+    columns.m2 = (uns32*)PyArray_DATA((PyArrayObject*)pyM2);
+    static_assert(sizeof(npy_bool) == sizeof(uns8), "NumPy bool is one byte");
+    columns.valid = (uns8*)PyArray_DATA((PyArrayObject*)pyValid);
+    if (!DecodeParticles(mdFrame, columns))
+    {
+        Cleanup();
+        return PvcamError();
+    }
+
+    return Py_BuildValue("{s:N,s:N,s:N,s:N}", // dict
+            "id", pyIds,
+            "m0", pyM0,
+            "m2", pyM2,
+            "valid", pyValid);
+}
+
+/**
+ * Returns the metadata dict of decoded frame with frame header, ROI headers
+ * and particles, the latter only if ROIs carry extended metadata.
+ */
+static PyObject* GetNewPyMetaDict(const ModuleState& moduleState, const md_frame* mdFrame,
+        MetadataFormat format)
+{
+    PyObject* pyFrameHdr = GetNewPyFrameHdr(moduleState, mdFrame, format);
+    if (!pyFrameHdr)
+        return NULL;
+
+    PyObject* pyRoiHdrs = GetNewPyRoiHdrs(moduleState, mdFrame, format);
+    if (!pyRoiHdrs)
+    {
+        Py_DECREF(pyFrameHdr);
+        return NULL;
+    }
+
+    PyObject* pyParticles = GetNewPyParticles(mdFrame);
+    if (!pyParticles)
+    {
+        Py_DECREF(pyRoiHdrs);
+        Py_DECREF(pyFrameHdr);
+        return NULL;
+    }
+
+    PyObject* pyMetaDict = Py_BuildValue("{s:N,s:N}", // dict
+            "frame_header", pyFrameHdr,
+            "roi_headers", pyRoiHdrs);
+    if (!pyMetaDict)
+    {
+        Py_DECREF(pyParticles);
+        return NULL;
+    }
+
+    if (pyParticles != Py_None
+            && PyDict_SetItemString(pyMetaDict, "particles", pyParticles) < 0)
+    {
+        Py_DECREF(pyParticles);
+        Py_DECREF(pyMetaDict);
+        return NULL;
+    }
+    Py_DECREF(pyParticles);
+    return pyMetaDict;
+}
+
+/**
+ * Waits for a frame and takes the oldest one off the queue or peeks at the
+ * latest one. Returns false with Python error set on failure, the lock is
+ * held on success.
+ */
+static bool GetQueuedFrame(int16 hcam, Camera& cam, std::unique_lock<std::mutex>& lock,
+        int timeoutMs, bool oldestFrame, Frame& frame)
+{
+    if (!WaitForFrame(hcam, cam, lock, timeoutMs))
+        return false;
+
+    // Only the oldest frame is popped off the queue, the latest one stays there
+    const bool frameAvail = (oldestFrame)
+        ? cam.m_acqQueue.PopOldest(frame)
+        : cam.m_acqQueue.PeekLatest(frame);
+    if (!frameAvail)
+    {
+        PyErr_Format(PyExc_RuntimeError, "Frame timeout."
+                " Verify the timeout exceeds the exposure time."
+                " If applicable, check external trigger source.");
+        return false;
+    }
+    return true;
+}
+
+/**
+ * Pins given frame so PVCAM doesn't overwrite it while objects point to it.
+ * Without pinning enabled at setup, the frame stays where it is, not copied.
+ * If it's enabled but the frame can't be pinned anymore, it is copied to a new
+ * buffer instead. The copy is best effort only, the frame is not locked then
+ * and PVCAM may have started to overwrite it already. Expects locked camera
+ * mutex. Returns false with Python error set on failure.
+ */
+static bool PinOrCopyFrame(Camera& cam, Frame& frame, std::shared_ptr<AcqBuffer>& acqBuffer,
+        std::shared_ptr<FrameSlotPin>& pin)
+{
+    if (!cam.m_frameSlots->IsEnabled())
+        return true;
+    pin = cam.m_frameSlots->Pin(frame.address, frame.count);
+    if (pin)
+        return true;
+
+    // Too late to pin, copy before PVCAM overwrites it, if not done yet
+    try
+    {
+        acqBuffer = AcqBufferPool::Instance().Acquire(cam.m_frameBytes, AcqBufferPolicy());
+    }
+    catch (const std::bad_alloc& /*ex*/)
+    {
+        PyErr_Format(PyExc_MemoryError, "Unable to allocate frame copy");
+        return false;
+    }
+    memcpy(acqBuffer->data, frame.address, cam.m_frameBytes);
+    frame.address = acqBuffer->data;
+    cam.m_frameSlots->CountForcedCopy();
+    return true;
+}
+
+static PyObject* pvc_get_frame(PyObject* self, PyObject* const* args, Py_ssize_t nargs)
+{
+    int16 hcam;
+    int timeoutMs; // Poll frame timeout in ms, negative values will wait forever
+    int oldestFrameInt; // Any int, not only bool
+    int pinInt = 0; // Pins the frame or copies it if the buffer is reused
+    if (nargs < 3 || nargs > 4 || !ArgAsInt16(args[0], hcam) || !ArgAsInt(args[1], timeoutMs)
+            || !ArgAsInt(args[2], oldestFrameInt) || (nargs > 3 && !ArgAsInt(args[3], pinInt)))
+        return ParamParseError();
+    bool oldestFrame = (bool)oldestFrameInt;
+
+    std::shared_ptr<Camera> cam = GetCamera(self, hcam);
+    if (!cam)
+        return NULL;
+
+    std::unique_lock<std::mutex> lock(cam->m_mutex, std::defer_lock);
+    Frame frame;
+    if (!GetQueuedFrame(hcam, *cam, lock, timeoutMs, oldestFrame, frame))
+        return NULL;
+
+    // Take a snapshot of everything needed below and unlock, so the callback
+    // is never blocked while Python objects are created.
+    std::shared_ptr<AcqBuffer> acqBuffer = cam->GetAcqBufferOf(frame.address);
+    std::shared_ptr<FrameSlotPin> pin;
+    if (pinInt && !PinOrCopyFrame(*cam, frame, acqBuffer, pin))
+        return NULL;
+    const bool metadataEnabled = cam->m_metadataEnabled;
+    Camera::MdFramePtr mdFrameLent; // Used by this thread only
+    if (metadataEnabled)
+    {
+        mdFrameLent = cam->LendMdFrame();
+        if (!mdFrameLent)
+            return PvcamError();
+    }
+    md_frame* mdFrame = mdFrameLent.get();
+    const MetadataFormat metadataFormat = cam->m_metadataFormat;
+    const uns32 frameBytes = cam->m_frameBytes;
+    const uns8 imageCompression = cam->m_imageCompression;
+    const npy_intp frameDims[2] = { cam->m_frameDims[0], cam->m_frameDims[1] };
+    const int typenum = cam->m_typenum;
+    const double fps = cam->m_fps;
+
+    lock.unlock();
+
+    // Keeps the frame in place while decoded and until the arrays export it
+    const FrameSlotExport frameExport(pin);
+    frame.address = frameExport.Resolve(frame.address);
+
+    //printf("New Data - FPS: %.1f, Cnt: %u, Nr: %u\n",
+    //        fps, frame.count, frame.nr);
+
+    // Build Python object for new frame
+
+    PyObject* pyFrameDict = PyDict_New();
+    if (!pyFrameDict)
+        return NULL;
+    PyObject* pyRoiDataList = NULL;
+
+    if (metadataEnabled)
+    {
+        if (!pl_md_frame_decode(mdFrame, frame.address, frameBytes))
+        {
+            Py_DECREF(pyFrameDict);
+            return PvcamError();
+        }
+
+        PyObject* pyMetaDict = GetNewPyMetaDict(*GetModuleState(self), mdFrame, metadataFormat);
+        if (!pyMetaDict)
+        {
+            Py_DECREF(pyFrameDict);
+            return NULL;
+        }
+
+        pyRoiDataList = GetNewPyRoiDataList(mdFrame, typenum, acqBuffer, pin);
+        if (!pyRoiDataList)
+        {
+            Py_DECREF(pyMetaDict);
+            Py_DECREF(pyFrameDict);
+            return NULL;
+        }
+
+        if (PyDict_SetItemString(pyFrameDict, "meta_data", pyMetaDict) < 0)
+        {
+            Py_DECREF(pyMetaDict);
+            Py_DECREF(pyRoiDataList);
+            Py_DECREF(pyFrameDict);
+            return NULL;
+        }
+        Py_DECREF(pyMetaDict);
+    }
+    else
+    {
+        // Construct ROI list with 1 region only, because metadata is disabled
+        pyRoiDataList = PyList_New(1);
+        if (!pyRoiDataList)
+        {
+            Py_DECREF(pyFrameDict);
+            return NULL;
+        }
+
+        PyObject* pyRoiData = GetNewPyArrayRoiData(frameDims, typenum, frame.address,
+                frameBytes, imageCompression, acqBuffer, pin);
+        if (!pyRoiData)
+        {
+            Py_DECREF(pyRoiDataList);
+            Py_DECREF(pyFrameDict);
+            return NULL;
+        }
+        PyList_SET_ITEM(pyRoiDataList, 0, pyRoiData);
+    }
+
+    if (PyDict_SetItemString(pyFrameDict, "pixel_data", pyRoiDataList) < 0)
+    {
+        Py_DECREF(pyRoiDataList);
+        Py_DECREF(pyFrameDict);
+        return NULL;
     }
     Py_DECREF(pyRoiDataList);
 
-    // Create final tuple (takes ownership of pyFrameDict)
-    PyObject* pyResultTuple = Py_BuildValue("NdI", pyFrameDict, cam->m_fps, frame.count);
-    if (!pyResultTuple)
+    // Create final tuple (takes ownership of pyFrameDict)
+    PyObject* pyResultTuple = Py_BuildValue("NdI", pyFrameDict, fps, frame.count);
+    if (!pyResultTuple)
+    {
+        Py_DECREF(pyFrameDict);
+        return NULL;
+    }
+
+    return pyResultTuple;
+}
+
+/**
+ * Pixel data of one ROI exported via the buffer protocol and DLPack without
+ * copying. It keeps the acquisition buffer alive and, if pinned, also keeps
+ * PVCAM from overwriting the frame until the object and all its exports
+ * are released.
+ */
+struct FrameBufferObject
+{
+    PyObject_HEAD
+    struct State
+    {
+        std::shared_ptr<AcqBuffer> acqBuffer{};
+        std::shared_ptr<FrameSlotPin> pin{};
+        void* data{ NULL };
+        Py_ssize_t shape[2]{ 0, 0 };
+        Py_ssize_t strides[2]{ 0, 0 }; // In bytes
+        Py_ssize_t itemsize{ 0 };
+        int typenum{ NPY_UINT16 };
+        char format[2]{ 'H', '\0' };
+        uint8_t dlpackCode{ kDLUInt };
+    } state;
+};
+
+/**
+ * DLPack tensor exported by FrameBuffer, keeps the FrameBuffer alive and
+ * a pinned frame in its slot.
+ */
+struct DlpackExport
+{
+    DLManagedTensor managed{};
+    DLManagedTensorVersioned versioned{};
+    int64_t shape[2]{ 0, 0 };
+    int64_t strides[2]{ 0, 0 }; // In elements
+    PyObject* owner{ NULL };
+    FrameSlotExport pinExport{};
+};
+
+/**
+ * Gets buffer format and DLPack type of given NumPy type, returns false with
+ * Python error set for types other than integers and floats.
+ */
+static bool GetTypenumFormat(int typenum, Py_ssize_t& itemsize, char& format,
+        uint8_t& dlpackCode)
+{
+    switch (typenum)
+    {
+    case NPY_UBYTE: itemsize = 1; format = 'B'; dlpackCode = kDLUInt; break;
+    case NPY_BYTE: itemsize = 1; format = 'b'; dlpackCode = kDLInt; break;
+    case NPY_USHORT: itemsize = sizeof(unsigned short); format = 'H'; dlpackCode = kDLUInt; break;
+    case NPY_SHORT: itemsize = sizeof(short); format = 'h'; dlpackCode = kDLInt; break;
+    case NPY_UINT: itemsize = sizeof(unsigned int); format = 'I'; dlpackCode = kDLUInt; break;
+    case NPY_INT: itemsize = sizeof(int); format = 'i'; dlpackCode = kDLInt; break;
+    case NPY_ULONG: itemsize = sizeof(unsigned long); format = 'L'; dlpackCode = kDLUInt; break;
+    case NPY_LONG: itemsize = sizeof(long); format = 'l'; dlpackCode = kDLInt; break;
+    case NPY_ULONGLONG:
+        itemsize = sizeof(unsigned long long); format = 'Q'; dlpackCode = kDLUInt; break;
+    case NPY_LONGLONG: itemsize = sizeof(long long); format = 'q'; dlpackCode = kDLInt; break;
+    case NPY_FLOAT: itemsize = sizeof(float); format = 'f'; dlpackCode = kDLFloat; break;
+    case NPY_DOUBLE: itemsize = sizeof(double); format = 'd'; dlpackCode = kDLFloat; break;
+    default:
+        PyErr_Format(PyExc_ValueError, "Unsupported NumPy type number: %d", typenum);
+        return false;
+    }
+    return true;
+}
+
+static void FrameBuffer_dealloc(FrameBufferObject* self)
+{
+    self->state.~State(); // Releases the pin and the buffer
+    PyTypeObject* type = Py_TYPE(self);
+    type->tp_free((PyObject*)self);
+    Py_DECREF(type); // Instances of heap types own a reference to it
+}
+
+static int FrameBuffer_getbuffer(FrameBufferObject* self, Py_buffer* view, int flags)
+{
+    const FrameBufferObject::State& state = self->state;
+    const Py_ssize_t len = state.shape[0] * state.shape[1] * state.itemsize;
+    // Without format the consumer assumes unsigned bytes, the shape in pixels
+    // would not match then
+    if (!(flags & PyBUF_FORMAT) && (flags & PyBUF_ND))
+    {
+        PyErr_Format(PyExc_BufferError,
+                "Frame buffer with shape can be exported only with format.");
+        view->obj = NULL;
+        return -1;
+    }
+    // Pinned frame might have been copied out of the acquisition buffer, it
+    // stays where it is until the view is released
+    FrameSlotExport* viewExport = NULL;
+    if (state.pin)
+    {
+        viewExport = new(std::nothrow) FrameSlotExport(state.pin);
+        if (!viewExport)
+        {
+            PyErr_NoMemory();
+            view->obj = NULL;
+            return -1;
+        }
+    }
+    void* data = (viewExport) ? viewExport->Resolve(state.data) : state.data;
+    // Fills a 1D byte buffer, the pixel layout is set below if requested
+    if (PyBuffer_FillInfo(view, (PyObject*)self, data, len, 0, flags) < 0)
+    {
+        delete viewExport;
+        return -1;
+    }
+    view->internal = viewExport;
+    if (!(flags & PyBUF_FORMAT))
+        return 0;
+    view->itemsize = state.itemsize;
+    view->format = self->state.format;
+    if (flags & PyBUF_ND)
+    {
+        view->ndim = 2;
+        view->shape = self->state.shape;
+    }
+    if ((flags & PyBUF_STRIDES) == PyBUF_STRIDES)
+        view->strides = self->state.strides;
+    return 0;
+}
+
+static void FrameBuffer_releasebuffer(FrameBufferObject* self, Py_buffer* view)
+{
+    delete static_cast<FrameSlotExport*>(view->internal); // Last one lets PVCAM reuse the slot
+}
+
+static void DlpackDeleteExport(DlpackExport* exp)
+{
+    // Consumers may release the tensor from any thread
+    if (Py_IsInitialized())
+    {
+        PyGILState_STATE gilState = PyGILState_Ensure();
+        Py_DECREF(exp->owner);
+        PyGILState_Release(gilState);
+    }
+    delete exp;
+}
+
+/** Deletes the tensor if the capsule hasn't been consumed. */
+static void DlpackCapsuleDestructor(PyObject* capsule)
+{
+    PyObject* type;
+    PyObject* value;
+    PyObject* traceback;
+    PyErr_Fetch(&type, &value, &traceback);
+    if (PyCapsule_IsValid(capsule, DLPACK_VERSIONED_CAPSULE_NAME))
+    {
+        auto* versioned = static_cast<DLManagedTensorVersioned*>(
+                PyCapsule_GetPointer(capsule, DLPACK_VERSIONED_CAPSULE_NAME));
+        versioned->deleter(versioned);
+    }
+    else if (PyCapsule_IsValid(capsule, DLPACK_CAPSULE_NAME))
+    {
+        auto* managed = static_cast<DLManagedTensor*>(
+                PyCapsule_GetPointer(capsule, DLPACK_CAPSULE_NAME));
+        managed->deleter(managed);
+    }
+    PyErr_Restore(type, value, traceback);
+}
+
+static PyObject* FrameBuffer_dlpack(FrameBufferObject* self, PyObject* args, PyObject* kwargs)
+{
+    static const char* kwlist[] = { "stream", "max_version", "dl_device", "copy", NULL };
+    PyObject* streamObj = Py_None;
+    PyObject* maxVersionObj = Py_None;
+    PyObject* dlDeviceObj = Py_None;
+    PyObject* copyObj = Py_None;
+    if (!PyArg_ParseTupleAndKeywords(args, kwargs, "|$OOOO", (char**)kwlist,
+                &streamObj, &maxVersionObj, &dlDeviceObj, &copyObj))
+        return NULL;
+
+    // Host memory has no stream and no other device
+    if (streamObj != Py_None)
+        return PyErr_Format(PyExc_BufferError, "Stream must be None for CPU tensors.");
+    if (dlDeviceObj != Py_None)
+    {
+        int32_t deviceType;
+        int32_t deviceId;
+        if (!PyArg_ParseTuple(dlDeviceObj, "ii", &deviceType, &deviceId))
+            return NULL;
+        if (deviceType != kDLCPU || deviceId != 0)
+            return PyErr_Format(PyExc_BufferError, "Frames can be exported to CPU only.");
+    }
+    if (copyObj != Py_None && PyObject_IsTrue(copyObj))
+        return PyErr_Format(PyExc_BufferError, "Frames are exported without copy only.");
+
+    bool versioned = false;
+    if (maxVersionObj != Py_None)
+    {
+        unsigned int major;
+        unsigned int minor;
+        if (!PyArg_ParseTuple(maxVersionObj, "II", &major, &minor))
+            return NULL;
+        versioned = major >= DLPACK_MAJOR_VERSION;
+    }
+
+    auto* exp = new(std::nothrow) DlpackExport();
+    if (!exp)
+        return PyErr_NoMemory();
+
+    const FrameBufferObject::State& state = self->state;
+    exp->shape[0] = state.shape[0];
+    exp->shape[1] = state.shape[1];
+    exp->strides[0] = state.shape[1];
+    exp->strides[1] = 1;
+    exp->owner = (PyObject*)self;
+    // Keeps the frame in place until the consumer deletes the tensor
+    exp->pinExport = FrameSlotExport(state.pin);
+
+    DLTensor tensor{};
+    tensor.data = exp->pinExport.Resolve(state.data);
+    tensor.device.device_type = kDLCPU;
+    tensor.device.device_id = 0;
+    tensor.ndim = 2;
+    tensor.dtype.code = state.dlpackCode;
+    tensor.dtype.bits = (uint8_t)(state.itemsize * 8);
+    tensor.dtype.lanes = 1;
+    tensor.shape = exp->shape;
+    tensor.strides = exp->strides;
+    tensor.byte_offset = 0;
+
+    PyObject* capsule;
+    if (versioned)
+    {
+        exp->versioned.version.major = DLPACK_MAJOR_VERSION;
+        exp->versioned.version.minor = DLPACK_MINOR_VERSION;
+        exp->versioned.manager_ctx = exp;
+        exp->versioned.deleter = [](DLManagedTensorVersioned* self)
+        {
+            DlpackDeleteExport(static_cast<DlpackExport*>(self->manager_ctx));
+        };
+        exp->versioned.flags = 0;
+        exp->versioned.dl_tensor = tensor;
+        capsule = PyCapsule_New(&exp->versioned, DLPACK_VERSIONED_CAPSULE_NAME,
+                DlpackCapsuleDestructor);
+    }
+    else
+    {
+        exp->managed.dl_tensor = tensor;
+        exp->managed.manager_ctx = exp;
+        exp->managed.deleter = [](DLManagedTensor* self)
+        {
+            DlpackDeleteExport(static_cast<DlpackExport*>(self->manager_ctx));
+        };
+        capsule = PyCapsule_New(&exp->managed, DLPACK_CAPSULE_NAME, DlpackCapsuleDestructor);
+    }
+    if (!capsule)
+    {
+        delete exp;
+        return NULL;
+    }
+    Py_INCREF(exp->owner); // Released by the deleter
+    return capsule;
+}
+
+static PyObject* FrameBuffer_dlpack_device(FrameBufferObject* self, PyObject* args)
+{
+    return Py_BuildValue("ii", (int)kDLCPU, 0);
+}
+
+static PyObject* FrameBuffer_get_shape(FrameBufferObject* self, void* closure)
+{
+    return Py_BuildValue("nn", self->state.shape[0], self->state.shape[1]);
+}
+
+static PyObject* FrameBuffer_get_dtype(FrameBufferObject* self, void* closure)
+{
+    return (PyObject*)PyArray_DescrFromType(self->state.typenum);
+}
+
+static PyObject* FrameBuffer_get_nbytes(FrameBufferObject* self, void* closure)
+{
+    const FrameBufferObject::State& state = self->state;
+    return PyLong_FromSsize_t(state.shape[0] * state.shape[1] * state.itemsize);
+}
+
+static PyObject* FrameBuffer_get_pinned(FrameBufferObject* self, void* closure)
+{
+    return PyBool_FromLong(self->state.pin != NULL);
+}
+
+static PyMethodDef FrameBuffer_methods[] = {
+    { "__dlpack__", (PyCFunction)(void(*)(void))FrameBuffer_dlpack,
+        METH_VARARGS | METH_KEYWORDS, "Exports the pixel data as DLPack capsule." },
+    { "__dlpack_device__", (PyCFunction)FrameBuffer_dlpack_device, METH_NOARGS,
+        "Returns DLPack device type and ID, always CPU." },
+    { NULL, NULL, 0, NULL } // Sentinel
+};
+
+static PyGetSetDef FrameBuffer_getset[] = {
+    { "shape", (getter)FrameBuffer_get_shape, NULL,
+        "Height and width of the ROI in pixels.", NULL },
+    { "dtype", (getter)FrameBuffer_get_dtype, NULL,
+        "NumPy data type of pixels.", NULL },
+    { "nbytes", (getter)FrameBuffer_get_nbytes, NULL,
+        "Size of pixel data in bytes.", NULL },
+    { "pinned", (getter)FrameBuffer_get_pinned, NULL,
+        "True if PVCAM doesn't overwrite the frame until released.", NULL },
+    { NULL, NULL, NULL, NULL, NULL } // Sentinel
+};
+
+static PyType_Slot FrameBuffer_slots[] = {
+    { Py_tp_dealloc, (void*)FrameBuffer_dealloc },
+    { Py_tp_doc, (void*)"Pixel data of one ROI shared via buffer protocol and DLPack." },
+    { Py_tp_methods, (void*)FrameBuffer_methods },
+    { Py_tp_getset, (void*)FrameBuffer_getset },
+    { Py_bf_getbuffer, (void*)FrameBuffer_getbuffer },
+    { Py_bf_releasebuffer, (void*)FrameBuffer_releasebuffer },
+    { 0, NULL } // Sentinel
+};
+
+// Heap type created per module, instances are created by FrameView only
+static PyType_Spec FrameBuffer_spec = {
+    "pyvcam.pvc.FrameBuffer",
+    sizeof(FrameBufferObject),
+    0,
+    Py_TPFLAGS_DEFAULT | Py_TPFLAGS_DISALLOW_INSTANTIATION,
+    FrameBuffer_slots
+};
+
+/**
+ * Returns a FrameBuffer with pixel data of given ROI. Compressed pixels are
+ * unpacked to a new buffer, others are shared with the acquisition buffer.
+ */
+static PyObject* GetNewPyFrameBuffer(PyTypeObject* type, const rgn_type& roi, int typenum,
+        void* data, size_t dataBytes, uns8 compression,
+        const std::shared_ptr<AcqBuffer>& acqBuffer, const std::shared_ptr<FrameSlotPin>& pin)
+{
+    const size_t w = (size_t)((roi.s2 - roi.s1 + 1) / roi.sbin);
+    const size_t h = (size_t)((roi.p2 - roi.p1 + 1) / roi.pbin);
+    if (compression != PL_IMAGE_COMPRESSION_NONE)
+    {
+        typenum = GetUnpackedTypenum(compression, w * h, dataBytes);
+        if (typenum == NPY_NOTYPE)
+            return NULL;
+    }
+
+    Py_ssize_t itemsize;
+    char format;
+    uint8_t dlpackCode;
+    if (!GetTypenumFormat(typenum, itemsize, format, dlpackCode))
+        return NULL;
+    if (compression == PL_IMAGE_COMPRESSION_NONE && w * h * (size_t)itemsize > dataBytes)
+        return PyErr_Format(PyExc_RuntimeError, "ROI pixel data are incomplete.");
+
+    auto* buffer = (FrameBufferObject*)type->tp_alloc(type, 0);
+    if (!buffer)
+        return NULL;
+    new(&buffer->state) FrameBufferObject::State();
+    FrameBufferObject::State& state = buffer->state;
+    state.shape[0] = (Py_ssize_t)h;
+    state.shape[1] = (Py_ssize_t)w;
+    state.strides[0] = (Py_ssize_t)w * itemsize;
+    state.strides[1] = itemsize;
+    state.itemsize = itemsize;
+    state.typenum = typenum;
+    state.format[0] = format;
+    state.dlpackCode = dlpackCode;
+
+    if (compression == PL_IMAGE_COMPRESSION_NONE)
+    {
+        state.acqBuffer = acqBuffer;
+        state.pin = pin;
+        state.data = data;
+        return (PyObject*)buffer;
+    }
+
+    try
+    {
+        state.acqBuffer = AcqBufferPool::Instance().Acquire(w * h * (size_t)itemsize,
+                AcqBufferPolicy());
+    }
+    catch (const std::bad_alloc& /*ex*/)
+    {
+        Py_DECREF(buffer);
+        return PyErr_NoMemory();
+    }
+    state.data = state.acqBuffer->data;
+    if (pin)
+        data = pin->Resolve(data);
+    Py_BEGIN_ALLOW_THREADS
+    BitUnpack(data, w * h, compression, state.data);
+    Py_END_ALLOW_THREADS
+    return (PyObject*)buffer;
+}
+
+/**
+ * Frame returned by get_frame_view. It keeps the acquisition buffer alive and
+ * decodes the metadata only once a metadata attribute is accessed, then
+ * the decoded structure and every attribute built so far are cached.
+ * The pixel data are not copied like with get_frame. A pinned view keeps
+ * PVCAM from overwriting the frame until the view and all arrays and buffers
+ * taken from it are released.
+ */
+struct FrameViewObject
+{
+    PyObject_HEAD
+    struct State
+    {
+        std::shared_ptr<AcqBuffer> acqBuffer{};
+        std::shared_ptr<FrameSlotPin> pin{};
+        Frame frame{};
+        double fps{ 0.0 };
+        uns32 frameBytes{ 0 };
+        rgn_type roi{}; // The only ROI of frames without metadata
+        int typenum{ NPY_UINT16 };
+        bool metadataEnabled{ false };
+        MetadataFormat metadataFormat{ MetadataFormat::Dict };
+        uns8 imageCompression{ (uns8)PL_IMAGE_COMPRESSION_NONE };
+        md_frame* mdFrame{ NULL }; // Decoded on first use
+        const void* mdFrameData{ NULL }; // Frame data decoded, moves if copied out of slot
+        PyObject* pixelData{ NULL };
+        PyObject* buffers{ NULL };
+        PyObject* frameHeader{ NULL };
+        PyObject* roiHeaders{ NULL };
+        PyObject* extMetadata{ NULL };
+        PyObject* particles{ NULL };
+    } state;
+};
+
+static void FrameView_dealloc(FrameViewObject* self)
+{
+    FrameViewObject::State& state = self->state;
+    Py_XDECREF(state.pixelData);
+    Py_XDECREF(state.buffers);
+    Py_XDECREF(state.frameHeader);
+    Py_XDECREF(state.roiHeaders);
+    Py_XDECREF(state.extMetadata);
+    Py_XDECREF(state.particles);
+    if (state.mdFrame)
+        pl_md_release_frame_struct(state.mdFrame); // Ignore PVCAM errors
+    state.~State();
+    PyTypeObject* type = Py_TYPE(self);
+    type->tp_free((PyObject*)self);
+    Py_DECREF(type); // Instances of heap types own a reference to it
+}
+
+/**
+ * Decodes the metadata once, again only if the pinned frame was copied out
+ * of its slot since. Expects the frame kept in place by given export.
+ * Returns false with Python error set on failure.
+ */
+static bool FrameView_Decode(FrameViewObject* self, const FrameSlotExport& frameExport)
+{
+    FrameViewObject::State& state = self->state;
+    void* frameData = frameExport.Resolve(state.frame.address);
+    if (state.mdFrame && state.mdFrameData == frameData)
+        return true;
+
+    if (!state.mdFrame && !pl_md_create_frame_struct_cont(&state.mdFrame, MAX_ROIS))
+    {
+        state.mdFrame = NULL;
+        PvcamError();
+        return false;
+    }
+    // Decoded ROI pointers are resolved by the pin again when used later
+    if (!pl_md_frame_decode(state.mdFrame, frameData, state.frameBytes))
+    {
+        state.mdFrameData = NULL;
+        PvcamError();
+        return false;
+    }
+    state.mdFrameData = frameData;
+    return true;
+}
+
+/** Same as FrameView_GetCached, expects the critical section on the view. */
+template<typename Builder>
+static PyObject* FrameView_GetCachedLocked(FrameViewObject* self, PyObject*& cached,
+        bool needsMetadata, Builder build)
+{
+    if (!cached)
+    {
+        if (needsMetadata && !self->state.metadataEnabled)
+            Py_RETURN_NONE;
+        // The frame is copied out of its slot only while no attribute is built
+        const FrameSlotExport frameExport(self->state.pin);
+        if (needsMetadata && !FrameView_Decode(self, frameExport))
+            return NULL;
+        PyObject* built = build(self->state);
+        if (!built)
+            return NULL;
+        // The critical section is suspended while the builder releases the GIL
+        if (cached)
+            Py_DECREF(built);
+        else
+            cached = built;
+    }
+    Py_INCREF(cached);
+    return cached;
+}
+
+/**
+ * Returns new reference to cached attribute, builds it first if not cached
+ * yet. Metadata attributes are None with metadata disabled. Threads sharing
+ * the view decode the metadata only once also without the GIL.
+ */
+template<typename Builder>
+static PyObject* FrameView_GetCached(FrameViewObject* self, PyObject*& cached,
+        bool needsMetadata, Builder build)
+{
+    PyObject* result;
+    Py_BEGIN_CRITICAL_SECTION(self);
+    result = FrameView_GetCachedLocked(self, cached, needsMetadata, build);
+    Py_END_CRITICAL_SECTION();
+    return result;
+}
+
+/** Returns the state of module the view type belongs to. */
+static const ModuleState& FrameView_GetModuleState(FrameViewObject* self)
+{
+    return *static_cast<ModuleState*>(PyType_GetModuleState(Py_TYPE(self)));
+}
+
+static PyObject* FrameView_get_pixel_data(FrameViewObject* self, void* closure)
+{
+    FrameViewObject::State& state = self->state;
+    // ROI positions are known only from metadata if enabled
+    return FrameView_GetCached(self, state.pixelData, state.metadataEnabled,
+            [](FrameViewObject::State& state) -> PyObject*
+            {
+                if (state.metadataEnabled)
+                    return GetNewPyRoiDataList(state.mdFrame, state.typenum, state.acqBuffer,
+                            state.pin);
+
+                PyObject* pyRoiData = GetNewPyArrayRoiData(state.roi, state.typenum,
+                        state.frame.address, state.frameBytes, state.imageCompression,
+                        state.acqBuffer, state.pin);
+                if (!pyRoiData)
+                    return NULL;
+                PyObject* pyRoiDataList = PyList_New(1);
+                if (!pyRoiDataList)
+                {
+                    Py_DECREF(pyRoiData);
+                    return NULL;
+                }
+                PyList_SET_ITEM(pyRoiDataList, 0, pyRoiData);
+                return pyRoiDataList;
+            });
+}
+
+static PyObject* FrameView_get_buffers(FrameViewObject* self, void* closure)
+{
+    FrameViewObject::State& state = self->state;
+    PyTypeObject* bufferType = FrameView_GetModuleState(self).frameBufferType;
+    return FrameView_GetCached(self, state.buffers, state.metadataEnabled,
+            [bufferType](FrameViewObject::State& state) -> PyObject*
+            {
+                if (!state.metadataEnabled)
+                {
+                    PyObject* pyBuffer = GetNewPyFrameBuffer(bufferType, state.roi, state.typenum,
+                            state.frame.address, state.frameBytes, state.imageCompression,
+                            state.acqBuffer, state.pin);
+                    if (!pyBuffer)
+                        return NULL;
+                    return Py_BuildValue("[N]", pyBuffer);
+                }
+
+                const md_frame_header* pFrameHdr = state.mdFrame->header;
+                const uns8 compression = (pFrameHdr->version >= 2)
+                    ? pFrameHdr->imageCompression
+                    : (uns8)PL_IMAGE_COMPRESSION_NONE;
+                PyObject* pyBufferList = PyList_New(pFrameHdr->roiCount);
+                if (!pyBufferList)
+                    return NULL;
+                for (uns16 i = 0; i < pFrameHdr->roiCount; i++)
+                {
+                    const md_frame_roi& mdRoi = state.mdFrame->roiArray[i];
+                    PyObject* pyBuffer = GetNewPyFrameBuffer(bufferType, mdRoi.header->roi,
+                            state.typenum, mdRoi.data, mdRoi.dataSize, compression,
+                            state.acqBuffer, state.pin);
+                    if (!pyBuffer)
+                    {
+                        Py_DECREF(pyBufferList);
+                        return NULL;
+                    }
+                    PyList_SET_ITEM(pyBufferList, (Py_ssize_t)i, pyBuffer);
+                }
+                return pyBufferList;
+            });
+}
+
+static PyObject* FrameView_get_pinned(FrameViewObject* self, void* closure)
+{
+    return PyBool_FromLong(self->state.pin != NULL);
+}
+
+static PyObject* FrameView_get_frame_header(FrameViewObject* self, void* closure)
+{
+    const ModuleState& moduleState = FrameView_GetModuleState(self);
+    return FrameView_GetCached(self, self->state.frameHeader, true,
+            [&moduleState](FrameViewObject::State& state)
+            {
+                return GetNewPyFrameHdr(moduleState, state.mdFrame, state.metadataFormat);
+            });
+}
+
+static PyObject* FrameView_get_roi_headers(FrameViewObject* self, void* closure)
+{
+    const ModuleState& moduleState = FrameView_GetModuleState(self);
+    return FrameView_GetCached(self, self->state.roiHeaders, true,
+            [&moduleState](FrameViewObject::State& state)
+            {
+                return GetNewPyRoiHdrs(moduleState, state.mdFrame, state.metadataFormat);
+            });
+}
+
+static PyObject* FrameView_get_ext_metadata(FrameViewObject* self, void* closure)
+{
+    return FrameView_GetCached(self, self->state.extMetadata, true,
+            [](FrameViewObject::State& state) -> PyObject*
+            {
+                const md_frame* mdFrame = state.mdFrame;
+                PyObject* pyFrameExtMd = GetNewPyDictExtMd(mdFrame->extMdData,
+                        mdFrame->extMdDataSize);
+                if (!pyFrameExtMd)
+                    return NULL;
+                const uns16 roiCount = mdFrame->header->roiCount;
+                PyObject* pyRoiExtMdList = PyList_New(roiCount);
+                if (!pyRoiExtMdList)
+                {
+                    Py_DECREF(pyFrameExtMd);
+                    return NULL;
+                }
+                for (uns16 i = 0; i < roiCount; i++)
+                {
+                    PyObject* pyRoiExtMd = GetNewPyDictExtMd(mdFrame->roiArray[i].extMdData,
+                            mdFrame->roiArray[i].extMdDataSize);
+                    if (!pyRoiExtMd)
+                    {
+                        Py_DECREF(pyRoiExtMdList);
+                        Py_DECREF(pyFrameExtMd);
+                        return NULL;
+                    }
+                    PyList_SET_ITEM(pyRoiExtMdList, (Py_ssize_t)i, pyRoiExtMd);
+                }
+                return Py_BuildValue("{s:N,s:N}", // dict
+                        "frame", pyFrameExtMd,
+                        "rois", pyRoiExtMdList);
+            });
+}
+
+static PyObject* FrameView_get_particles(FrameViewObject* self, void* closure)
+{
+    return FrameView_GetCached(self, self->state.particles, true,
+            [](FrameViewObject::State& state)
+            {
+                return GetNewPyParticles(state.mdFrame);
+            });
+}
+
+static PyObject* FrameView_get_metadata_decoded(FrameViewObject* self, void* closure)
+{
+    bool decoded;
+    Py_BEGIN_CRITICAL_SECTION(self);
+    decoded = self->state.mdFrame != NULL;
+    Py_END_CRITICAL_SECTION();
+    return PyBool_FromLong(decoded);
+}
+
+static PyObject* FrameView_get_frame_count(FrameViewObject* self, void* closure)
+{
+    return PyLong_FromUnsignedLong(self->state.frame.count);
+}
+
+static PyObject* FrameView_get_frame_nr(FrameViewObject* self, void* closure)
+{
+    return PyLong_FromUnsignedLong(self->state.frame.nr);
+}
+
+static PyObject* FrameView_get_timestamp(FrameViewObject* self, void* closure)
+{
+    return PyLong_FromLongLong(self->state.frame.timeStamp);
+}
+
+static PyObject* FrameView_get_timestamp_bof(FrameViewObject* self, void* closure)
+{
+    return PyLong_FromLongLong(self->state.frame.timeStampBof);
+}
+
+static PyObject* FrameView_get_fps(FrameViewObject* self, void* closure)
+{
+    return PyFloat_FromDouble(self->state.fps);
+}
+
+static PyGetSetDef FrameView_getset[] = {
+    { "pixel_data", (getter)FrameView_get_pixel_data, NULL,
+        "List with 2D pixel data array of every ROI.", NULL },
+    { "buffers", (getter)FrameView_get_buffers, NULL,
+        "List with FrameBuffer of every ROI for zero-copy export.", NULL },
+    { "pinned", (getter)FrameView_get_pinned, NULL,
+        "True if PVCAM doesn't overwrite the frame until released.", NULL },
+    { "frame_header", (getter)FrameView_get_frame_header, NULL,
+        "Frame header in the camera's metadata format, None without metadata.", NULL },
+    { "roi_headers", (getter)FrameView_get_roi_headers, NULL,
+        "ROI headers in the camera's metadata format, None without metadata.", NULL },
+    { "ext_metadata", (getter)FrameView_get_ext_metadata, NULL,
+        "Dict with extended metadata of the frame and list of dicts for ROIs.", NULL },
+    { "particles", (getter)FrameView_get_particles, NULL,
+        "Dict with particle IDs, M0 and M2 arrays of all ROIs, None if not available.",
+        NULL },
+    { "metadata_decoded", (getter)FrameView_get_metadata_decoded, NULL,
+        "True once the metadata has been decoded.", NULL },
+    { "frame_count", (getter)FrameView_get_frame_count, NULL,
+        "Frame number that resets with every setup.", NULL },
+    { "frame_nr", (getter)FrameView_get_frame_nr, NULL,
+        "Hardware frame number.", NULL },
+    { "timestamp", (getter)FrameView_get_timestamp, NULL,
+        "EOF timestamp.", NULL },
+    { "timestamp_bof", (getter)FrameView_get_timestamp_bof, NULL,
+        "BOF timestamp.", NULL },
+    { "fps", (getter)FrameView_get_fps, NULL,
+        "Frames per second at the time the frame was taken.", NULL },
+    { NULL, NULL, NULL, NULL, NULL } // Sentinel
+};
+
+static PyType_Slot FrameView_slots[] = {
+    { Py_tp_dealloc, (void*)FrameView_dealloc },
+    { Py_tp_doc, (void*)"Frame with metadata decoded on first access." },
+    { Py_tp_getset, (void*)FrameView_getset },
+    { 0, NULL } // Sentinel
+};
+
+// Heap type created per module, instances are created by get_frame_view only
+static PyType_Spec FrameView_spec = {
+    "pyvcam.pvc.FrameView",
+    sizeof(FrameViewObject),
+    0,
+    Py_TPFLAGS_DEFAULT | Py_TPFLAGS_DISALLOW_INSTANTIATION,
+    FrameView_slots
+};
+
+/**
+ * Same as get_frame, but returns a FrameView instead of a dict, thus
+ * the metadata are not decoded unless accessed.
+ * With pinning requested and live acquisition set up with pinning, the frame
+ * stays untouched until the view is released. If the frame cannot be pinned
+ * anymore and the buffer is reused, the view gets a copy of the frame instead.
+ */
+static PyObject* pvc_get_frame_view(PyObject* self, PyObject* args)
+{
+    int16 hcam;
+    int timeoutMs; // Poll frame timeout in ms, negative values will wait forever
+    int oldestFrameInt; // Must be int, "p" format for bool breaks other args
+    int pinInt = 0;
+    if (!PyArg_ParseTuple(args, "hii|i", &hcam, &timeoutMs, &oldestFrameInt, &pinInt))
+        return ParamParseError();
+
+    std::shared_ptr<Camera> cam = GetCamera(self, hcam);
+    if (!cam)
+        return NULL;
+
+    PyTypeObject* viewType = GetModuleState(self)->frameViewType;
+    auto* view = (FrameViewObject*)viewType->tp_alloc(viewType, 0);
+    if (!view)
+        return NULL;
+    new(&view->state) FrameViewObject::State();
+    FrameViewObject::State& state = view->state;
+
+    {
+        std::unique_lock<std::mutex> lock(cam->m_mutex, std::defer_lock);
+        if (!GetQueuedFrame(hcam, *cam, lock, timeoutMs, (bool)oldestFrameInt, state.frame))
+        {
+            Py_DECREF(view);
+            return NULL;
+        }
+        if (cam->m_rois.empty())
+        {
+            Py_DECREF(view);
+            return PyErr_Format(PyExc_RuntimeError, "Acquisition not set up.");
+        }
+
+        state.acqBuffer = cam->GetAcqBufferOf(state.frame.address);
+        state.fps = cam->m_fps;
+        state.frameBytes = cam->m_frameBytes;
+        state.roi = cam->m_rois[0];
+        state.typenum = cam->m_typenum;
+        state.metadataEnabled = cam->m_metadataEnabled;
+        state.metadataFormat = cam->m_metadataFormat;
+        state.imageCompression = cam->m_imageCompression;
+
+        if (pinInt && !PinOrCopyFrame(*cam, state.frame, state.acqBuffer, state.pin))
+        {
+            Py_DECREF(view);
+            return NULL;
+        }
+    }
+
+    return Py_BuildValue("NdI", (PyObject*)view, state.fps, state.frame.count);
+}
+
+/**
+ * Returns a writable C-contiguous 2D canvas of given shape and type, either
+ * the one given by caller or a new one from the acquisition buffer pool.
+ */
+static PyObject* GetNewPyArrayCanvas(PyObject* canvasObj, npy_intp* dims, int typenum,
+        size_t pixelBytes)
+{
+    if (canvasObj == Py_None)
+    {
+        const size_t bytes = (size_t)(dims[0] * dims[1]) * pixelBytes;
+        std::shared_ptr<AcqBuffer> canvasBuffer;
+        try
+        {
+            canvasBuffer = AcqBufferPool::Instance().Acquire(bytes, AcqBufferPolicy());
+        }
+        catch (const std::bad_alloc& /*ex*/)
+        {
+            return PyErr_Format(PyExc_MemoryError, "Unable to allocate canvas");
+        }
+        PyObject* pyArray = PyArray_SimpleNewFromData(2, dims, typenum, canvasBuffer->data);
+        if (!pyArray)
+            return NULL;
+        if (!SetAcqBufferAsArrayBase(pyArray, canvasBuffer))
+        {
+            Py_DECREF(pyArray);
+            return NULL;
+        }
+        return pyArray;
+    }
+
+    if (!PyArray_Check(canvasObj))
+        return PyErr_Format(PyExc_TypeError, "Canvas must be a NumPy array.");
+    auto* canvasArr = (PyArrayObject*)canvasObj;
+    if (PyArray_NDIM(canvasArr) != 2 || PyArray_DIM(canvasArr, 0) != dims[0]
+            || PyArray_DIM(canvasArr, 1) != dims[1])
+        return PyErr_Format(PyExc_ValueError, "Canvas shape must be (%zd, %zd).",
+                (Py_ssize_t)dims[0], (Py_ssize_t)dims[1]);
+    if (PyArray_TYPE(canvasArr) != typenum)
+        return PyErr_Format(PyExc_ValueError, "Canvas type must be NumPy type number %d.",
+                typenum);
+    if (!PyArray_IS_C_CONTIGUOUS(canvasArr) || !PyArray_ISWRITEABLE(canvasArr))
+        return PyErr_Format(PyExc_ValueError, "Canvas must be C-contiguous and writable.");
+    Py_INCREF(canvasObj);
+    return canvasObj;
+}
+
+/**
+ * Same as get_frame, but copies all ROIs to their positions in one full-sensor
+ * image. The background is filled with given value. Binned frames are
+ * recomposed to an image of sensor size divided by the binning factors.
+ */
+static PyObject* pvc_get_frame_recomposed(PyObject* self, PyObject* args)
+{
+    int16 hcam;
+    int timeoutMs; // Poll frame timeout in ms, negative values will wait forever
+    int oldestFrameInt; // Must be int, "p" format for bool breaks other args
+    uns16 sensorWidth;
+    uns16 sensorHeight;
+    PyObject* fillObj;
+    PyObject* canvasObj;
+    if (!PyArg_ParseTuple(args, "hiiHHOO", &hcam, &timeoutMs, &oldestFrameInt,
+                &sensorWidth, &sensorHeight, &fillObj, &canvasObj))
+        return ParamParseError();
+
+    std::shared_ptr<Camera> cam = GetCamera(self, hcam);
+    if (!cam)
+        return NULL;
+
+    std::unique_lock<std::mutex> lock(cam->m_mutex, std::defer_lock);
+    Frame frame;
+    if (!GetQueuedFrame(hcam, *cam, lock, timeoutMs, (bool)oldestFrameInt, frame))
+        return NULL;
+
+    // Take a snapshot like get_frame does
+    std::shared_ptr<AcqBuffer> acqBuffer = cam->GetAcqBufferOf(frame.address);
+    const bool metadataEnabled = cam->m_metadataEnabled;
+    Camera::MdFramePtr mdFrameLent; // Used by this thread only
+    if (metadataEnabled)
+    {
+        mdFrameLent = cam->LendMdFrame();
+        if (!mdFrameLent)
+            return PvcamError();
+    }
+    md_frame* mdFrame = mdFrameLent.get();
+    const MetadataFormat metadataFormat = cam->m_metadataFormat;
+    const uns32 frameBytes = cam->m_frameBytes;
+    uns8 imageCompression = cam->m_imageCompression;
+    const int typenum = cam->m_typenum;
+    const double fps = cam->m_fps;
+    const std::vector<rgn_type> setupRois = cam->m_rois;
+
+    lock.unlock();
+
+    if (setupRois.empty())
+        return PyErr_Format(PyExc_RuntimeError, "Acquisition not set up.");
+
+    // Collect ROIs so the metadata structure is not touched without the GIL
+    std::vector<RecomposeRoi> rois;
+    std::vector<const rgn_type*> roiRegions;
+    PyObject* pyMetaDict = NULL;
+    if (metadataEnabled)
+    {
+        if (!pl_md_frame_decode(mdFrame, frame.address, frameBytes))
+            return PvcamError();
+
+        const md_frame_header* pFrameHdr = mdFrame->header;
+        imageCompression = (pFrameHdr->version >= 2)
+            ? pFrameHdr->imageCompression
+            : (uns8)PL_IMAGE_COMPRESSION_NONE;
+        for (uns16 i = 0; i < pFrameHdr->roiCount; i++)
+        {
+            const md_frame_roi& mdRoi = mdFrame->roiArray[i];
+            RecomposeRoi roi;
+            roi.data = mdRoi.data;
+            roi.dataBytes = mdRoi.dataSize;
+            rois.push_back(roi);
+            roiRegions.push_back(&mdRoi.header->roi);
+        }
+
+        pyMetaDict = GetNewPyMetaDict(*GetModuleState(self), mdFrame, metadataFormat);
+        if (!pyMetaDict)
+            return NULL;
+    }
+    else
+    {
+        RecomposeRoi roi;
+        roi.data = frame.address;
+        roi.dataBytes = frameBytes;
+        rois.push_back(roi);
+        roiRegions.push_back(&setupRois[0]);
+    }
+
+    // All ROIs share the same binning
+    const rgn_type& firstRegion = (roiRegions.empty()) ? setupRois[0] : *roiRegions[0];
+    const uns16 sbin = (std::max)(firstRegion.sbin, (uns16)1);
+    const uns16 pbin = (std::max)(firstRegion.pbin, (uns16)1);
+    for (size_t n = 0; n < rois.size(); n++)
+    {
+        const rgn_type& region = *roiRegions[n];
+        rois[n].x = region.s1 / sbin;
+        rois[n].y = region.p1 / pbin;
+        rois[n].width = (region.s2 - region.s1 + 1) / sbin;
+        rois[n].height = (region.p2 - region.p1 + 1) / pbin;
+    }
+
+    unsigned compressionBits = 0;
+    int pixelTypenum = typenum;
+    if (imageCompression != PL_IMAGE_COMPRESSION_NONE)
+    {
+        pixelTypenum = GetUnpackedTypenum(imageCompression, 0, 0);
+        if (pixelTypenum == NPY_NOTYPE)
+        {
+            Py_XDECREF(pyMetaDict);
+            return NULL;
+        }
+        compressionBits = imageCompression;
+    }
+
+    // Convert the fill value to canvas type, e.g. 0 to 0.0 for float canvas
+    PyObject* pyFill = PyArray_FromAny(fillObj, PyArray_DescrFromType(pixelTypenum), 0, 0,
+            NPY_ARRAY_FORCECAST, NULL);
+    if (!pyFill || PyArray_SIZE((PyArrayObject*)pyFill) != 1)
+    {
+        Py_XDECREF(pyFill);
+        Py_XDECREF(pyMetaDict);
+        if (!PyErr_Occurred())
+            PyErr_Format(PyExc_ValueError, "Fill value must be a scalar.");
+        return NULL;
+    }
+
+    RecomposeCanvas canvas;
+    canvas.width = sensorWidth / sbin;
+    canvas.height = sensorHeight / pbin;
+    canvas.pixelBytes = (size_t)PyArray_ITEMSIZE((PyArrayObject*)pyFill);
+    canvas.rowStride = canvas.width * canvas.pixelBytes;
+    uint64_t fill = 0;
+    if (canvas.pixelBytes <= sizeof(fill))
+        memcpy(&fill, PyArray_DATA((PyArrayObject*)pyFill), canvas.pixelBytes);
+    Py_DECREF(pyFill);
+    if (canvas.pixelBytes != 1 && canvas.pixelBytes != 2 && canvas.pixelBytes != 4
+            && canvas.pixelBytes != 8)
+    {
+        Py_XDECREF(pyMetaDict);
+        return PyErr_Format(PyExc_ValueError,
+                "Unsupported canvas pixel size %zu.", canvas.pixelBytes);
+    }
+    for (const RecomposeRoi& roi : rois)
+    {
+        if (!RecomposeRoiIsValid(roi, canvas.pixelBytes, compressionBits))
+        {
+            Py_XDECREF(pyMetaDict);
+            return PyErr_Format(PyExc_RuntimeError,
+                    "Pixel data size does not match ROI size.");
+        }
+    }
+
+    npy_intp dims[2] = { (npy_intp)canvas.height, (npy_intp)canvas.width };
+    PyObject* pyCanvas = GetNewPyArrayCanvas(canvasObj, dims, pixelTypenum,
+            canvas.pixelBytes);
+    if (!pyCanvas)
+    {
+        Py_XDECREF(pyMetaDict);
+        return NULL;
+    }
+    canvas.data = PyArray_DATA((PyArrayObject*)pyCanvas);
+
+    Py_BEGIN_ALLOW_THREADS
+    RecomposeFrame(canvas, rois, compressionBits, &fill);
+    Py_END_ALLOW_THREADS
+
+    PyObject* pyFrameDict = (pyMetaDict)
+        ? Py_BuildValue("{s:N,s:N}", "pixel_data", pyCanvas, "meta_data", pyMetaDict)
+        : Py_BuildValue("{s:N}", "pixel_data", pyCanvas);
+    if (!pyFrameDict)
+        return NULL;
+
+    return Py_BuildValue("NdI", pyFrameDict, fps, frame.count);
+}
+
+/**
+ * Drains up to given number of queued frames in one call. The pixel data of
+ * the first ROI is returned in one 3D array. It points directly to the
+ * acquisition buffer if the frames lie there back to back and frame pinning
+ * is disabled, otherwise the frames are copied. Per-frame counters and
+ * timestamps are returned in parallel 1D arrays.
+ */
+static PyObject* pvc_get_frames(PyObject* self, PyObject* args)
+{
+    int16 hcam;
+    uns32 maxCount;
+    int timeoutMs = 0; // Negative values will wait forever, zero doesn't wait at all
+    int copyInt = 0; // Must be int, copies the frames before PVCAM may overwrite them
+    if (!PyArg_ParseTuple(args, "hI|ii", &hcam, &maxCount, &timeoutMs, &copyInt))
+        return ParamParseError();
+
+    std::shared_ptr<Camera> cam = GetCamera(self, hcam);
+    if (!cam)
+        return NULL;
+
+    std::unique_lock<std::mutex> lock(cam->m_mutex, std::defer_lock);
+    if (!WaitForFrame(hcam, *cam, lock, timeoutMs))
+        return NULL;
+
+    std::vector<Frame> frames;
+    frames.reserve((std::min)((size_t)maxCount, cam->m_acqQueue.Size()));
+    Frame frame;
+    while (frames.size() < maxCount && cam->m_acqQueue.PopOldest(frame))
+    {
+        frames.push_back(frame);
+    }
+
+    if (frames.empty() && timeoutMs != 0)
+    {
+        return PyErr_Format(PyExc_RuntimeError, "Frame timeout."
+                " Verify the timeout exceeds the exposure time."
+                " If applicable, check external trigger source.");
+    }
+    if (cam->m_rois.empty())
+        return PyErr_Format(PyExc_RuntimeError, "Acquisition not set up.");
+
+    // Take a snapshot of everything needed below and unlock. Frames may come
+    // from two laps of a segmented sequence, both buffers are kept alive.
+    std::shared_ptr<AcqBuffer> acqBuffer = (frames.empty())
+        ? cam->m_acqBuffer
+        : cam->GetAcqBufferOf(frames[0].address);
+    const std::shared_ptr<AcqBuffer> prevBuffer = cam->m_seqPrevBuffer;
+    // Frames tracked for pinning get unlocked soon after being dequeued. They
+    // are pinned while copied and never returned without copy. Those unlocked
+    // already may be overwritten, these are dropped like those from a full queue.
+    const bool frameSlotsEnabled = cam->m_frameSlots->IsEnabled();
+    std::vector<FrameSlotExport> frameExports;
+    if (frameSlotsEnabled)
+    {
+        frameExports.reserve(frames.size());
+        size_t kept = 0;
+        for (size_t n = 0; n < frames.size(); n++)
+        {
+            std::shared_ptr<FrameSlotPin> pin =
+                cam->m_frameSlots->Pin(frames[n].address, frames[n].count);
+            if (!pin)
+            {
+                cam->m_statQueueDropped++;
+                continue;
+            }
+            frameExports.emplace_back(std::move(pin));
+            frames[kept] = frames[n];
+            frames[kept].address = frameExports.back().Resolve(frames[n].address);
+            kept++;
+        }
+        frames.resize(kept);
+    }
+    const bool metadataEnabled = cam->m_metadataEnabled;
+    Camera::MdFramePtr mdFrameLent; // Used by this thread only
+    if (metadataEnabled)
+    {
+        mdFrameLent = cam->LendMdFrame();
+        if (!mdFrameLent)
+            return PvcamError();
+    }
+    md_frame* mdFrame = mdFrameLent.get();
+    const uns32 frameBytes = cam->m_frameBytes;
+    const uns8 imageCompression = cam->m_imageCompression;
+    const rgn_type roi = cam->m_rois[0];
+    int typenum = cam->m_typenum;
+    const double fps = cam->m_fps;
+    // Pinned frames are never overwritten, others once PVCAM gets a lap ahead
+    const uns32 overwriteLag = (cam->IsBufferReused() && !frameSlotsEnabled)
+        ? cam->m_frameCount
+        : 0;
+
+    lock.unlock();
+
+    npy_intp count = (npy_intp)frames.size();
+    constexpr int NUM_DIMS = 3;
+    npy_intp dims[NUM_DIMS] = {
+        count,
+        (roi.p2 - roi.p1 + 1) / roi.pbin,
+        (roi.s2 - roi.s1 + 1) / roi.sbin
+    };
+
+    // Compressed frames are always unpacked to a new array
+    const bool compressed = imageCompression != PL_IMAGE_COMPRESSION_NONE;
+    const size_t pixelCount = (size_t)(dims[1] * dims[2]);
+    size_t packedBytes = 0;
+    if (compressed)
+    {
+        typenum = GetUnpackedTypenum(imageCompression, pixelCount, (size_t)frameBytes);
+        if (typenum == NPY_NOTYPE)
+            return NULL;
+        packedBytes = BitPackPackedBytes(pixelCount, imageCompression);
+    }
+
+    // With copy requested, the frames are copied right away below
+    bool contiguous = !copyInt && !frameSlotsEnabled && !metadataEnabled && !compressed
+        && count > 0;
+    for (npy_intp n = 1; contiguous && n < count; n++)
+    {
+        contiguous = (uns8*)frames[n].address
+            == (uns8*)frames[n - 1].address + frameBytes;
+    }
+
+    PyObject* pyFrames = NULL;
+    if (contiguous)
+    {
+        pyFrames = PyArray_New(&PyArray_Type, NUM_DIMS, dims, typenum, NULL,
+                frames[0].address, 0, NPY_ARRAY_CARRAY, NULL);
+        if (!pyFrames)
+            return NULL;
+        // Frames do not lie back to back if the frame has more than pixels
+        if (PyArray_STRIDE((PyArrayObject*)pyFrames, 0) != (npy_intp)frameBytes)
+        {
+            Py_DECREF(pyFrames);
+            pyFrames = NULL;
+        }
+        else if (!SetAcqBufferAsArrayBase(pyFrames, acqBuffer))
+        {
+            Py_DECREF(pyFrames);
+            return NULL;
+        }
+    }
+    if (!pyFrames)
+    {
+        pyFrames = PyArray_SimpleNew(NUM_DIMS, dims, typenum);
+        if (!pyFrames)
+            return NULL;
+
+        uns8* dst = (uns8*)PyArray_DATA((PyArrayObject*)pyFrames);
+        const size_t imageBytes = (size_t)PyArray_STRIDE((PyArrayObject*)pyFrames, 0);
+
+        if (metadataEnabled)
+        {
+            for (npy_intp n = 0; n < count; n++)
+            {
+                if (!pl_md_frame_decode(mdFrame, frames[n].address, frameBytes))
+                {
+                    Py_DECREF(pyFrames);
+                    return PvcamError();
+                }
+                const size_t dataBytes = (compressed) ? packedBytes : imageBytes;
+                if (mdFrame->roiArray[0].dataSize != dataBytes)
+                {
+                    Py_DECREF(pyFrames);
+                    return PyErr_Format(PyExc_RuntimeError,
+                            "ROI size in metadata does not match acquisition setup.");
+                }
+                if (compressed)
+                    BitUnpack(mdFrame->roiArray[0].data, pixelCount, imageCompression,
+                            dst + n * imageBytes);
+                else
+                    memcpy(dst + n * imageBytes, mdFrame->roiArray[0].data, imageBytes);
+            }
+        }
+        else
+        {
+            if (!compressed && imageBytes > frameBytes)
+            {
+                Py_DECREF(pyFrames);
+                return PyErr_Format(PyExc_ValueError,
+                        "Data type does not match frame size of %u bytes.", frameBytes);
+            }
+
+            Py_BEGIN_ALLOW_THREADS
+            for (npy_intp n = 0; n < count; n++)
+            {
+                if (compressed)
+                    BitUnpack(frames[n].address, pixelCount, imageCompression,
+                            dst + n * imageBytes);
+                else
+                    memcpy(dst + n * imageBytes, frames[n].address, imageBytes);
+            }
+            Py_END_ALLOW_THREADS
+        }
+
+        // PVCAM starts rewriting a frame with the exposure of the frame that comes
+        // a lap later, right after EOF of the previous one. The oldest frames
+        // may have been torn before or while copied, these are dropped like
+        // those dropped from a full queue.
+        if (overwriteLag > 0)
+        {
+            const uns32 lastCount = cam->m_acqFrameCnt.load();
+            npy_intp torn = 0;
+            while (torn < count && frames[torn].count <= lastCount
+                    && lastCount - frames[torn].count + 1 >= overwriteLag)
+            {
+                torn++;
+            }
+            if (torn > 0)
+            {
+                PyObject* pyValidFrames = PySequence_GetSlice(pyFrames, torn, count);
+                Py_DECREF(pyFrames);
+                if (!pyValidFrames)
+                    return NULL;
+                pyFrames = pyValidFrames;
+                frames.erase(frames.begin(), frames.begin() + torn);
+                count -= torn;
+                cam->m_statQueueDropped += (uint64_t)torn;
+            }
+        }
+    }
+
+    npy_intp countDims[1] = { count };
+    PyObject* pyCounts = PyArray_SimpleNew(1, countDims, NPY_UINT32);
+    PyObject* pyFrameNrs = PyArray_SimpleNew(1, countDims, NPY_UINT32);
+    PyObject* pyTimeStamps = PyArray_SimpleNew(1, countDims, NPY_INT64);
+    PyObject* pyTimeStampsBof = PyArray_SimpleNew(1, countDims, NPY_INT64);
+    if (!pyCounts || !pyFrameNrs || !pyTimeStamps || !pyTimeStampsBof)
+    {
+        Py_XDECREF(pyTimeStampsBof);
+        Py_XDECREF(pyTimeStamps);
+        Py_XDECREF(pyFrameNrs);
+        Py_XDECREF(pyCounts);
+        Py_DECREF(pyFrames);
+        return NULL;
+    }
+    auto* counts = (npy_uint32*)PyArray_DATA((PyArrayObject*)pyCounts);
+    auto* frameNrs = (npy_uint32*)PyArray_DATA((PyArrayObject*)pyFrameNrs);
+    auto* timeStamps = (npy_int64*)PyArray_DATA((PyArrayObject*)pyTimeStamps);
+    auto* timeStampsBof = (npy_int64*)PyArray_DATA((PyArrayObject*)pyTimeStampsBof);
+    for (npy_intp n = 0; n < count; n++)
+    {
+        counts[n] = frames[n].count;
+        frameNrs[n] = frames[n].nr;
+        timeStamps[n] = frames[n].timeStamp;
+        timeStampsBof[n] = frames[n].timeStampBof;
+    }
+
+    PyObject* pyFramesDict = Py_BuildValue("{s:N,s:N,s:N,s:N,s:N}", // dict
+            "pixel_data", pyFrames,
+            "frame_count", pyCounts,
+            "frame_nr", pyFrameNrs,
+            "timestamp", pyTimeStamps,
+            "timestamp_bof", pyTimeStampsBof);
+    if (!pyFramesDict)
+        return NULL; // References already stolen by N format
+
+    // Create final tuple (takes ownership of pyFramesDict)
+    return Py_BuildValue("Nd", pyFramesDict, fps);
+}
+
+static PyObject* pvc_finish_seq(PyObject* self, PyObject* args)
+{
+    int16 hcam;
+    if (!PyArg_ParseTuple(args, "h", &hcam))
+        return ParamParseError();
+
+    std::shared_ptr<Camera> cam = GetCamera(self, hcam);
+    if (!cam)
+        return NULL;
+
+    void* acqBuffer = NULL;
+    {
+        std::lock_guard<std::mutex> lock(cam->m_mutex);
+        acqBuffer = cam->m_acqBuffer->data;
+    }
+
+    cam->m_seqRearm = false; // Let no next segment start
+    cam->m_seqRearmThread.Cancel(); // Segment being started is stopped below
+    cam->m_frameSlots->Stop(); // Pinned frames stay intact, no more unlocking
+
+    // Also internally aborts the acquisition if necessary
+    if (!pl_exp_finish_seq(hcam, acqBuffer, 0))
+        return PvcamError();
+
+    if (!pl_cam_deregister_callback(hcam, PL_CALLBACK_EOF))
+        return PvcamError();
+
+    // Flushes the stream without holding m_mutex, the callback doesn't run anymore
+    std::string streamError;
+    const bool streamOk = cam->UnsetStreamToDisk(streamError);
+
+    {
+        std::lock_guard<std::mutex> lock(cam->m_mutex);
+
+        cam->m_acqAbort = true;
+        if (!streamOk)
+            cam->m_acqCbError = streamError;
+
+        cam->m_acqCond.notify_all(); // Wakeup get_frame if anybody waits
+    }
+
+    Py_RETURN_NONE;
+}
+
+static PyObject* pvc_abort(PyObject* self, PyObject* args)
+{
+    int16 hcam;
+    if (!PyArg_ParseTuple(args, "h", &hcam))
+        return ParamParseError();
+
+    std::shared_ptr<Camera> cam = GetCamera(self, hcam);
+    if (!cam)
+        return NULL;
+
+    cam->m_seqRearm = false; // Let no next segment start
+    cam->m_seqRearmThread.Cancel(); // Segment being started is stopped below
+    cam->m_frameSlots->Stop(); // Pinned frames stay intact, no more unlocking
+
+    if (!pl_exp_abort(hcam, CCS_HALT))
+        return PvcamError();
+
+    if (!pl_cam_deregister_callback(hcam, PL_CALLBACK_EOF))
+        return PvcamError();
+
+    // Flushes the stream without holding m_mutex, the callback doesn't run anymore
+    std::string streamError;
+    const bool streamOk = cam->UnsetStreamToDisk(streamError);
+
+    {
+        std::lock_guard<std::mutex> lock(cam->m_mutex);
+
+        cam->m_acqAbort = true;
+        if (!streamOk)
+            cam->m_acqCbError = streamError;
+
+        cam->m_acqCond.notify_all(); // Wakeup get_frame if anybody waits
+    }
+
+    Py_RETURN_NONE;
+}
+
+// TODO: Deprecated, remove in next major release.
+static PyObject* pvc_stop_live(PyObject* self, PyObject* args)
+{
+    return pvc_abort(self, args);
+}
+
+/**
+ * Waits for the oldest queued frame and pops it without touching Python, thus
+ * can run with the GIL released. Expects locked camera mutex. Returns false
+ * with error message set if the frame doesn't come in time or the acquisition
+ * fails or is aborted.
+ */
+static bool PopQueuedFrameNoGil(int16 hcam, Camera& cam, std::unique_lock<std::mutex>& lock,
+        int timeoutMs, Frame& frame, std::string& error)
+{
+    constexpr auto timeStep = std::chrono::milliseconds(5000);
+    const auto timeEnd = std::chrono::high_resolution_clock::now()
+        + ((timeoutMs >= 0)
+            ? std::chrono::milliseconds(timeoutMs)
+            : std::chrono::hours(24 * 365 * 100)); // WAIT_FOREVER ~ 100 years
+
+    cam.m_acqWaiters++;
+    while (!cam.m_acqQueue.PopOldest(frame))
+    {
+        if (cam.m_acqAbort)
+            error = "Acquisition aborted.";
+        else if (!cam.m_acqCbError.empty())
+            error = cam.m_acqCbError;
+        else if (std::chrono::high_resolution_clock::now() >= timeEnd)
+            error = "Frame timeout."
+                " Verify the timeout exceeds the exposure time."
+                " If applicable, check external trigger source.";
+        if (!error.empty())
+            break;
+
+        const auto timeNext =
+            (std::min)(std::chrono::high_resolution_clock::now() + timeStep, timeEnd);
+        cam.m_acqCond.wait_until(lock, timeNext);
+        if (!cam.m_acqQueue.Empty())
+            continue;
+
+        // Every so often check if readout failed
+        lock.unlock();
+        int16 status;
+        uns32 dummy;
+        const rs_bool checkStatusResult = pl_exp_check_status(hcam, &status, &dummy);
+        char errMsg[ERROR_MSG_LEN] = "<UNKNOWN ERROR>";
+        if (!checkStatusResult)
+            pl_error_message(pl_error_code(), errMsg); // Ignore PVCAM error
+        lock.lock();
+        if (!checkStatusResult)
+            error = errMsg;
+        else if (status == READOUT_FAILED)
+            error = "Frame readout failed.";
+        if (!error.empty())
+            break;
+    }
+    cam.m_acqWaiters--;
+    return error.empty();
+}
+
+/**
+ * Acquires a stack of frames with the first ROI in one sequence and copies
+ * them to a 3D array as they arrive, either the one given by caller or a new
+ * one. The GIL is released until all frames are acquired.
+ * With an interval given, exposures are started every interval milliseconds,
+ * by software trigger in software edge trigger mode, otherwise by restarting
+ * one-frame sequence set up only once. Software triggers are sent as needed
+ * also without interval.
+ * With VTM exposure times given, the callback starts every frame with the next
+ * time from the list as a one-frame segment, thus Python never runs between
+ * frames. With an interval, frames are restarted here with the next time.
+ */
+static PyObject* pvc_acquire_stack(PyObject* self, PyObject* args)
+{
+    int16 hcam;
+    PyObject* roiListObj;
+    uns32 expTime;
+    int16 expMode;
+    uns32 frameCount;
+    int timeoutMs = -1; // Timeout per frame in ms, negative values will wait forever
+    int intervalMs = 0; // Time between exposure starts, zero for back to back frames
+    PyObject* outObj = Py_None;
+    PyObject* expTimesObj = Py_None; // None, or VTM exposure times applied in turn
+    if (!PyArg_ParseTuple(args, "hO!IhI|iiOO", &hcam, &PyList_Type, &roiListObj,
+                &expTime, &expMode, &frameCount, &timeoutMs, &intervalMs, &outObj,
+                &expTimesObj))
+        return ParamParseError();
+    if (frameCount == 0 || intervalMs < 0)
+        return ParamParseError();
+    if (PyList_Size(roiListObj) != 1)
+        return PyErr_Format(PyExc_ValueError, "Stack acquisition supports one ROI only.");
+
+    std::shared_ptr<Camera> cam = GetCamera(self, hcam);
+    if (!cam)
+        return NULL;
+
+    // Software triggers start exposures, the extended trigger mode is in upper byte
+    const int32 trigMode = (int32)expMode & 0xFF00;
+    const bool swTriggerEach = trigMode == EXT_TRIG_SOFTWARE_EDGE;
+    const bool swTriggerFirst = trigMode == EXT_TRIG_SOFTWARE_FIRST;
+    const bool restartEach = intervalMs > 0 && !swTriggerEach;
+
+    // Sets up the sequence as usual, just one frame long if restarted for every frame
+    PyObject* setupArgs = Py_BuildValue("hOIhIzzO", hcam, roiListObj, expTime, expMode,
+            (restartEach) ? 1u : frameCount, NULL, NULL, expTimesObj);
+    if (!setupArgs)
+        return NULL;
+    PyObject* frameBytesObj = pvc_setup_seq(self, setupArgs);
+    Py_DECREF(setupArgs);
+    if (!frameBytesObj)
+        return NULL;
+    Py_DECREF(frameBytesObj);
+
+    std::unique_lock<std::mutex> lock(cam->m_mutex);
+    const rgn_type roi = cam->m_rois[0];
+    const bool metadataEnabled = cam->m_metadataEnabled;
+    const uns8 imageCompression = cam->m_imageCompression;
+    const uns32 frameBytes = cam->m_frameBytes;
+    int typenum = cam->m_typenum;
+    lock.unlock();
+
+    npy_intp dims[3] = {
+        (npy_intp)frameCount,
+        (roi.p2 - roi.p1 + 1) / roi.pbin,
+        (roi.s2 - roi.s1 + 1) / roi.sbin
+    };
+    const bool compressed = imageCompression != PL_IMAGE_COMPRESSION_NONE;
+    const size_t pixelCount = (size_t)(dims[1] * dims[2]);
+    if (compressed)
+    {
+        typenum = GetUnpackedTypenum(imageCompression, pixelCount, (size_t)frameBytes);
+        if (typenum == NPY_NOTYPE)
+            return NULL;
+    }
+
+    PyObject* pyStack;
+    if (outObj == Py_None)
+    {
+        pyStack = PyArray_SimpleNew(3, dims, typenum);
+        if (!pyStack)
+            return NULL;
+    }
+    else
+    {
+        if (!PyArray_Check(outObj))
+            return PyErr_Format(PyExc_TypeError, "Output must be a NumPy array.");
+        auto* outArr = (PyArrayObject*)outObj;
+        if (PyArray_NDIM(outArr) != 3 || PyArray_DIM(outArr, 0) != dims[0]
+                || PyArray_DIM(outArr, 1) != dims[1] || PyArray_DIM(outArr, 2) != dims[2])
+            return PyErr_Format(PyExc_ValueError, "Output shape must be (%zd, %zd, %zd).",
+                    (Py_ssize_t)dims[0], (Py_ssize_t)dims[1], (Py_ssize_t)dims[2]);
+        if (PyArray_TYPE(outArr) != typenum)
+            return PyErr_Format(PyExc_ValueError,
+                    "Output type must be NumPy type number %d.", typenum);
+        if (!PyArray_IS_C_CONTIGUOUS(outArr) || !PyArray_ISWRITEABLE(outArr))
+            return PyErr_Format(PyExc_ValueError,
+                    "Output must be C-contiguous and writable.");
+        Py_INCREF(outObj);
+        pyStack = outObj;
+    }
+    uns8* dst = (uns8*)PyArray_DATA((PyArrayObject*)pyStack);
+    const size_t imageBytes = pixelCount * (size_t)PyArray_ITEMSIZE((PyArrayObject*)pyStack);
+    if (!metadataEnabled && !compressed && imageBytes > frameBytes)
+    {
+        Py_DECREF(pyStack);
+        return PyErr_Format(PyExc_ValueError,
+                "Data type does not match frame size of %u bytes.", frameBytes);
+    }
+
+    md_frame* mdFrame = NULL;
+    if (metadataEnabled && !pl_md_create_frame_struct_cont(&mdFrame, 1))
+    {
+        Py_DECREF(pyStack);
+        return PvcamError();
+    }
+
+    std::string error;
+    uns32 acquired = 0;
+
+    Py_BEGIN_ALLOW_THREADS
+
+    auto SetPvcamError = [&error]()
+    {
+        char errMsg[ERROR_MSG_LEN] = "<UNKNOWN ERROR>";
+        pl_error_message(pl_error_code(), errMsg); // Ignore PVCAM error
+        error = errMsg;
+    };
+    auto Trigger = [&]() -> bool
+    {
+        uns32 flags = 0;
+        if (!pl_exp_trigger(hcam, &flags, 0))
+        {
+            SetPvcamError();
+            return false;
+        }
+        if (flags != PL_SW_TRIG_STATUS_TRIGGERED)
+        {
+            error = "Software trigger ignored by camera.";
+            return false;
+        }
+        return true;
+    };
+    auto Start = [&]() -> bool
+    {
+        if (!StartSeq(hcam, *cam, acquired > 0))
+        {
+            SetPvcamError();
+            return false;
+        }
+        return true;
+    };
+
+    // Start times are derived from the first one, thus delays don't accumulate
+    const auto firstStart = std::chrono::steady_clock::now();
+    while (acquired < frameCount)
+    {
+        if (intervalMs > 0 && acquired > 0)
+            std::this_thread::sleep_until(firstStart
+                    + std::chrono::milliseconds((int64_t)intervalMs * acquired));
+        if ((acquired == 0 || restartEach) && !Start())
+            break;
+        if ((swTriggerEach || (swTriggerFirst && acquired == 0)) && !Trigger())
+            break;
+
+        Frame frame;
+        lock.lock();
+        const bool frameAvail =
+            PopQueuedFrameNoGil(hcam, *cam, lock, timeoutMs, frame, error);
+        lock.unlock();
+        if (!frameAvail)
+            break;
+
+        // Nobody else pops frames, the sequence buffer is not reused before the copy
+        const void* data = frame.address;
+        size_t dataBytes = frameBytes;
+        if (metadataEnabled)
+        {
+            if (!pl_md_frame_decode(mdFrame, frame.address, frameBytes))
+            {
+                SetPvcamError();
+                break;
+            }
+            data = mdFrame->roiArray[0].data;
+            dataBytes = mdFrame->roiArray[0].dataSize;
+        }
+        uns8* dstImage = dst + (size_t)acquired * imageBytes;
+        if (compressed)
+        {
+            if (dataBytes < BitPackPackedBytes(pixelCount, imageCompression))
+            {
+                error = "ROI size in metadata does not match acquisition setup.";
+                break;
+            }
+            BitUnpack(data, pixelCount, imageCompression, dstImage);
+        }
+        else
+        {
+            if (dataBytes < imageBytes)
+            {
+                error = "ROI size in metadata does not match acquisition setup.";
+                break;
+            }
+            memcpy(dstImage, data, imageBytes);
+        }
+        acquired++;
+    }
+
+    Py_END_ALLOW_THREADS
+
+    if (mdFrame)
+        pl_md_release_frame_struct(mdFrame); // Ignore PVCAM errors
+
+    // Finishes or aborts the sequence either way
+    PyObject* finishArgs = Py_BuildValue("(h)", hcam);
+    PyObject* finishResult = (finishArgs) ? pvc_finish_seq(self, finishArgs) : NULL;
+    Py_XDECREF(finishArgs);
+    if (!error.empty())
+    {
+        Py_XDECREF(finishResult);
+        Py_DECREF(pyStack);
+        PyErr_Clear(); // Report the first error
+        PyErr_SetString(PyExc_RuntimeError, error.c_str());
+        return NULL;
+    }
+    if (!finishResult)
+    {
+        Py_DECREF(pyStack);
+        return NULL;
+    }
+    Py_DECREF(finishResult);
+    return pyStack;
+}
+
+static PyObject* pvc_reset_frame_counter(PyObject* self, PyObject* args)
+{
+    int16 hcam;
+    if (!PyArg_ParseTuple(args, "h", &hcam))
+        return ParamParseError();
+
+    std::shared_ptr<Camera> cam = GetCamera(self, hcam);
+    if (!cam)
+        return NULL;
+
+    {
+        std::lock_guard<std::mutex> lock(cam->m_mutex);
+        cam->m_acqFrameCnt = 0;
+    }
+
+    Py_RETURN_NONE;
+}
+
+/** Returns statistics of the last or ongoing acquisition, safe to call any time. */
+static PyObject* pvc_get_acq_stats(PyObject* self, PyObject* args)
+{
+    int16 hcam;
+    if (!PyArg_ParseTuple(args, "h", &hcam))
+        return ParamParseError();
+
+    std::shared_ptr<Camera> cam = GetCamera(self, hcam);
+    if (!cam)
+        return NULL;
+
+    const FrameSlots::Stats slotStats = cam->m_frameSlots->GetStats();
+    return Py_BuildValue( // dict
+            "{s:I,s:K,s:K,s:K,s:K,s:K,s:K,s:K,s:K,s:z,s:K,s:n,s:K,s:K,s:K,s:K,s:K,s:K,s:K,s:K,s:I,s:I}",
+            "frames_received", cam->m_acqFrameCnt.load(),
+            "queue_dropped", (unsigned long long)cam->m_statQueueDropped.load(),
+            "frame_nr_gaps", (unsigned long long)cam->m_statFrameNrGaps.load(),
+            "frames_lost", (unsigned long long)cam->m_statFramesLost.load(),
+            "max_queue_depth", (unsigned long long)cam->m_statMaxQueueDepth.load(),
+            "callback_errors", (unsigned long long)cam->m_statCbErrors.load(),
+            "stream_frames_at_risk", (unsigned long long)cam->m_statStreamAtRisk.load(),
+            "stream_frames_overwritten",
+                (unsigned long long)cam->m_statStreamOverwritten.load(),
+            "stream_queue_full", (unsigned long long)cam->m_statStreamQueueFull.load(),
+            "stream_backend", cam->m_streamBackend.load(),
+            "queue_depth", (unsigned long long)cam->m_acqQueue.Size(),
+            "queue_capacity", (Py_ssize_t)cam->m_acqQueue.Capacity(),
+            "seq_rearm_count", (unsigned long long)cam->m_statRearmCount.load(),
+            "seq_rearm_latency_max_us",
+                (unsigned long long)cam->m_statRearmLatencyMaxUs.load(),
+            "seq_rearm_latency_total_us",
+                (unsigned long long)cam->m_statRearmLatencyTotalUs.load(),
+            "seq_cycle_time_max_us", (unsigned long long)cam->m_statCycleTimeMaxUs.load(),
+            "seq_cycle_time_total_us",
+                (unsigned long long)cam->m_statCycleTimeTotalUs.load(),
+            "pinned_frames", (unsigned long long)slotStats.pins,
+            "forced_copies", (unsigned long long)slotStats.forcedCopies,
+            "pin_dropped_frames", (unsigned long long)slotStats.droppedFrames,
+            "pinned_slots", slotStats.pinnedSlots,
+            "locked_slots", slotStats.lockedSlots);
+}
+
+/** Returns hit and miss counters of the parameter attribute cache. */
+static PyObject* pvc_get_param_cache_stats(PyObject* self, PyObject* args)
+{
+    int16 hcam;
+    if (!PyArg_ParseTuple(args, "h", &hcam))
+        return ParamParseError();
+
+    std::shared_ptr<Camera> cam = GetCamera(self, hcam);
+    if (!cam)
+        return NULL;
+
+    const ParamCache<ParamValue>::Stats stats = cam->m_paramCache.GetStats();
+    return Py_BuildValue("{s:O,s:K,s:K,s:K,s:n}", // dict
+            "enabled", (cam->m_paramCache.IsEnabled()) ? Py_True : Py_False,
+            "hits", (unsigned long long)stats.hits,
+            "misses", (unsigned long long)stats.misses,
+            "invalidations", (unsigned long long)stats.invalidations,
+            "entries", (Py_ssize_t)stats.entries);
+}
+
+/** Enables or disables the parameter attribute cache, either way it is emptied. */
+static PyObject* pvc_set_param_cache_enabled(PyObject* self, PyObject* args)
+{
+    int16 hcam;
+    int enabled;
+    if (!PyArg_ParseTuple(args, "hp", &hcam, &enabled))
+        return ParamParseError();
+
+    std::shared_ptr<Camera> cam = GetCamera(self, hcam);
+    if (!cam)
+        return NULL;
+
+    cam->m_paramCache.SetEnabled(enabled != 0);
+    cam->m_paramCache.ResetStats();
+
+    Py_RETURN_NONE;
+}
+
+static const char* const g_hugePagesNames[] = { "none", "transparent", "2m", "1g" };
+static const char* const g_prefaultNames[] = { "none", "populate", "touch" };
+
+/** Sets the allocation policy for acquisition buffers of next setups. */
+static PyObject* pvc_set_acq_buffer_policy(PyObject* self, PyObject* args)
+{
+    int16 hcam;
+    const char* hugePagesName;
+    const char* prefaultName;
+    int lock;
+    if (!PyArg_ParseTuple(args, "hssp", &hcam, &hugePagesName, &prefaultName, &lock))
+        return ParamParseError();
+
+    AcqBufferPolicy policy;
+    auto FindName = [](const char* name, const char* const* names, size_t count) {
+        for (size_t n = 0; n < count; n++)
+            if (strcmp(name, names[n]) == 0)
+                return (int)n;
+        return -1;
+    };
+    const int hugePages = FindName(hugePagesName, g_hugePagesNames,
+            sizeof(g_hugePagesNames) / sizeof(g_hugePagesNames[0]));
+    if (hugePages < 0)
+        return PyErr_Format(PyExc_ValueError,
+                "Unknown huge pages option '%s'.", hugePagesName);
+    const int prefault = FindName(prefaultName, g_prefaultNames,
+            sizeof(g_prefaultNames) / sizeof(g_prefaultNames[0]));
+    if (prefault < 0)
+        return PyErr_Format(PyExc_ValueError,
+                "Unknown prefault option '%s'.", prefaultName);
+    policy.hugePages = (AcqBufferHugePages)hugePages;
+    policy.prefault = (AcqBufferPrefault)prefault;
+    policy.lock = lock != 0;
+
+    std::shared_ptr<Camera> cam = GetCamera(self, hcam);
+    if (!cam)
+        return NULL;
+
     {
-        Py_DECREF(pyFrameDict);
-        return NULL;
+        std::lock_guard<std::mutex> lock(cam->m_mutex);
+        cam->m_acqBufferPolicy = policy;
     }
 
-    return pyResultTuple;
+    Py_RETURN_NONE;
 }
 
-static PyObject* pvc_finish_seq(PyObject* self, PyObject* args)
+/**
+ * Returns requested allocation policy and the policy effective for current
+ * acquisition buffer, that may differ if some option is not supported.
+ */
+static PyObject* pvc_get_acq_buffer_policy(PyObject* self, PyObject* args)
 {
     int16 hcam;
     if (!PyArg_ParseTuple(args, "h", &hcam))
         return ParamParseError();
 
-    std::shared_ptr<Camera> cam = GetCamera(hcam);
+    std::shared_ptr<Camera> cam = GetCamera(self, hcam);
     if (!cam)
         return NULL;
 
-    void* acqBuffer = NULL;
+    AcqBufferPolicy policy;
+    std::shared_ptr<AcqBuffer> acqBuffer;
     {
         std::lock_guard<std::mutex> lock(cam->m_mutex);
-        acqBuffer = cam->m_acqBuffer->data;
+        policy = cam->m_acqBufferPolicy;
+        acqBuffer = cam->m_acqBuffer;
     }
 
-    // Also internally aborts the acquisition if necessary
-    if (!pl_exp_finish_seq(hcam, acqBuffer, 0))
-        return PvcamError();
+    PyObject* bufferObj;
+    if (!acqBuffer)
+    {
+        Py_INCREF(Py_None);
+        bufferObj = Py_None;
+    }
+    else
+    {
+        const AcqBufferPolicy& effective = acqBuffer->effective;
+        bufferObj = Py_BuildValue("{s:K,s:s,s:s,s:O}", // dict
+                "bytes", (unsigned long long)acqBuffer->size,
+                "hugepages", g_hugePagesNames[(int)effective.hugePages],
+                "prefault", g_prefaultNames[(int)effective.prefault],
+                "mlock", (effective.lock) ? Py_True : Py_False);
+        if (!bufferObj)
+            return NULL;
+    }
 
-    if (!pl_cam_deregister_callback(hcam, PL_CALLBACK_EOF))
-        return PvcamError();
+    return Py_BuildValue("{s:s,s:s,s:O,s:N}", // dict
+            "hugepages", g_hugePagesNames[(int)policy.hugePages],
+            "prefault", g_prefaultNames[(int)policy.prefault],
+            "mlock", (policy.lock) ? Py_True : Py_False,
+            "buffer", bufferObj);
+}
 
-    {
-        std::lock_guard<std::mutex> lock(cam->m_mutex);
+static const char* const g_metadataFormatNames[] = { "dict", "numpy" };
 
-        cam->m_acqAbort = true;
+/** Selects whether get_frame returns metadata headers in dicts or NumPy arrays. */
+static PyObject* pvc_set_metadata_format(PyObject* self, PyObject* args)
+{
+    int16 hcam;
+    const char* formatName;
+    if (!PyArg_ParseTuple(args, "hs", &hcam, &formatName))
+        return ParamParseError();
+
+    int format = -1;
+    for (size_t n = 0; n < sizeof(g_metadataFormatNames) / sizeof(g_metadataFormatNames[0]); n++)
+    {
+        if (strcmp(formatName, g_metadataFormatNames[n]) == 0)
+            format = (int)n;
+    }
+    if (format < 0)
+        return PyErr_Format(PyExc_ValueError, "Unknown metadata format '%s'.", formatName);
 
-        cam->UnsetStreamToDisk();
+    std::shared_ptr<Camera> cam = GetCamera(self, hcam);
+    if (!cam)
+        return NULL;
 
-        cam->m_acqCond.notify_all(); // Wakeup get_frame if anybody waits
+    {
+        std::lock_guard<std::mutex> lock(cam->m_mutex);
+        cam->m_metadataFormat = (MetadataFormat)format;
     }
 
     Py_RETURN_NONE;
 }
 
-static PyObject* pvc_abort(PyObject* self, PyObject* args)
+/** Returns the name of the metadata format used by get_frame. */
+static PyObject* pvc_get_metadata_format(PyObject* self, PyObject* args)
 {
     int16 hcam;
     if (!PyArg_ParseTuple(args, "h", &hcam))
         return ParamParseError();
 
-    std::shared_ptr<Camera> cam = GetCamera(hcam);
+    std::shared_ptr<Camera> cam = GetCamera(self, hcam);
     if (!cam)
         return NULL;
 
-    if (!pl_exp_abort(hcam, CCS_HALT))
-        return PvcamError();
-
-    if (!pl_cam_deregister_callback(hcam, PL_CALLBACK_EOF))
-        return PvcamError();
-
+    MetadataFormat format;
     {
         std::lock_guard<std::mutex> lock(cam->m_mutex);
-
-        cam->m_acqAbort = true;
-
-        cam->UnsetStreamToDisk();
-
-        cam->m_acqCond.notify_all(); // Wakeup get_frame if anybody waits
+        format = cam->m_metadataFormat;
     }
 
-    Py_RETURN_NONE;
+    return PyUnicode_FromString(g_metadataFormatNames[(int)format]);
 }
 
-// TODO: Deprecated, remove in next major release.
-static PyObject* pvc_stop_live(PyObject* self, PyObject* args)
+/** Returns hit, miss and memory statistics of the process-wide buffer pool. */
+static PyObject* pvc_get_acq_buffer_pool_stats(PyObject* self, PyObject* args)
 {
-    return pvc_abort(self, args);
+    const AcqBufferPool::Stats stats = AcqBufferPool::Instance().GetStats();
+    return Py_BuildValue("{s:K,s:K,s:K,s:n,s:K}", // dict
+            "hits", (unsigned long long)stats.hits,
+            "misses", (unsigned long long)stats.misses,
+            "resident_bytes", (unsigned long long)stats.residentBytes,
+            "idle_buffers", (Py_ssize_t)stats.idleBuffers,
+            "limit_bytes", (unsigned long long)stats.limitBytes);
 }
 
-static PyObject* pvc_reset_frame_counter(PyObject* self, PyObject* args)
+/** Sets max. bytes of idle buffers kept by the pool, zero disables the pool. */
+static PyObject* pvc_set_acq_buffer_pool_limit(PyObject* self, PyObject* args)
 {
-    int16 hcam;
-    if (!PyArg_ParseTuple(args, "h", &hcam))
+    unsigned long long limitBytes;
+    if (!PyArg_ParseTuple(args, "K", &limitBytes))
         return ParamParseError();
 
-    std::shared_ptr<Camera> cam = GetCamera(hcam);
-    if (!cam)
-        return NULL;
+    AcqBufferPool::Instance().SetLimit((size_t)limitBytes);
+
+    Py_RETURN_NONE;
+}
 
+/**
+ * Unpacks given number of pixels from a buffer compressed with one of
+ * the PL_IMAGE_COMPRESSION_BITPACK* modes. Returns a new 1D array of uint16
+ * or uint32 pixels.
+ */
+static PyObject* pvc_unpack_bits(PyObject* self, PyObject* args)
+{
+    Py_buffer data;
+    uns8 compression;
+    Py_ssize_t count;
+    if (!PyArg_ParseTuple(args, "y*bn", &data, &compression, &count))
+        return ParamParseError();
+    if (count < 0)
     {
-        std::lock_guard<std::mutex> lock(cam->m_mutex);
-        cam->m_acqFrameCnt = 0;
+        PyBuffer_Release(&data);
+        return PyErr_Format(PyExc_ValueError, "Pixel count must not be negative.");
     }
 
-    Py_RETURN_NONE;
+    npy_intp dims[1] = { (npy_intp)count };
+    PyObject* pyArray = GetNewPyArrayUnpacked(1, dims, data.buf, (size_t)data.len,
+            compression);
+    PyBuffer_Release(&data);
+    return pyArray;
 }
 
 /**
@@ -1707,17 +5069,19 @@ static PyObject* pvc_read_enum(PyObject* self, PyObject* args)
     if (!PyArg_ParseTuple(args, "hI", &hcam, &paramId))
         return ParamParseError();
 
-    rs_bool avail;
-    if (!pl_get_param(hcam, paramId, ATTR_AVAIL, &avail))
+    std::shared_ptr<Camera> cam = GetCamera(self, hcam, false);
+
+    ParamValue attrValue;
+    if (!GetParamCached(hcam, cam.get(), paramId, ATTR_AVAIL, attrValue))
         return PvcamError();
-    if (!avail)
+    if (!attrValue.val_bool)
         return PyErr_Format(PyExc_AttributeError,
                 "Invalid setting for this camera. Parameter ID 0x%08X is not available.",
                 paramId);
 
-    uns32 count;
-    if (!pl_get_param(hcam, paramId, ATTR_COUNT, &count))
+    if (!GetParamCached(hcam, cam.get(), paramId, ATTR_COUNT, attrValue))
         return PvcamError();
+    const uns32 count = attrValue.val_uns32;
 
     std::vector<std::pair<std::vector<char>, int32>> items(count);
     for (uns32 i = 0; i < count; i++)
@@ -1760,6 +5124,481 @@ static PyObject* pvc_read_enum(PyObject* self, PyObject* args)
     return pyResultDict;
 }
 
+/** Stores integer value to the union according to given param type, returns false for others. */
+static bool Int64ToParamValue(uns16 type, long long value, ParamValue& paramValue)
+{
+    switch (type)
+    {
+    case TYPE_ENUM: paramValue.val_enum = (int32)value; break;
+    case TYPE_INT8: paramValue.val_int8 = (int8)value; break;
+    case TYPE_UNS8: paramValue.val_uns8 = (uns8)value; break;
+    case TYPE_INT16: paramValue.val_int16 = (int16)value; break;
+    case TYPE_UNS16: paramValue.val_uns16 = (uns16)value; break;
+    case TYPE_INT32: paramValue.val_int32 = (int32)value; break;
+    case TYPE_UNS32: paramValue.val_uns32 = (uns32)value; break;
+    case TYPE_INT64: paramValue.val_long64 = (long64)value; break;
+    case TYPE_UNS64: paramValue.val_ulong64 = (ulong64)value; break;
+    case TYPE_BOOLEAN: paramValue.val_bool = (rs_bool)value; break;
+    default: return false;
+    }
+    return true;
+}
+
+/** Reads integer value from the union according to given param type, returns false for others. */
+static bool ParamValueToInt64(uns16 type, const ParamValue& paramValue, long long& value)
+{
+    switch (type)
+    {
+    case TYPE_ENUM: value = paramValue.val_enum; break;
+    case TYPE_INT8: value = paramValue.val_int8; break;
+    case TYPE_UNS8: value = paramValue.val_uns8; break;
+    case TYPE_INT16: value = paramValue.val_int16; break;
+    case TYPE_UNS16: value = paramValue.val_uns16; break;
+    case TYPE_INT32: value = paramValue.val_int32; break;
+    case TYPE_UNS32: value = paramValue.val_uns32; break;
+    case TYPE_INT64: value = paramValue.val_long64; break;
+    case TYPE_UNS64: value = (long long)paramValue.val_ulong64; break;
+    case TYPE_BOOLEAN: value = paramValue.val_bool; break;
+    default: return false;
+    }
+    return true;
+}
+
+/**
+ * Camera capabilities learned by walking all speed table and post-processing
+ * entries. Collected without the GIL, converted to Python objects afterwards.
+ */
+struct Capabilities
+{
+    struct Gain
+    {
+        long long index{ 0 };
+        std::string name{};
+        long long bitDepth{ 0 };
+    };
+    struct Speed
+    {
+        long long index{ 0 };
+        std::string name{};
+        long long pixTime{ 0 };
+        std::vector<Gain> gains{};
+    };
+    struct Port
+    {
+        std::string name{};
+        int32 value{ 0 };
+        std::vector<Speed> speeds{};
+    };
+    struct PpParam
+    {
+        long long index{ 0 };
+        std::string name{};
+        long long id{ 0 };
+        long long min{ 0 };
+        long long max{ 0 };
+    };
+    struct PpFeature
+    {
+        long long index{ 0 };
+        std::string name{};
+        long long id{ 0 };
+        std::vector<PpParam> params{};
+    };
+
+    std::vector<Port> ports{};
+    std::vector<PpFeature> ppFeatures{};
+};
+
+/** Helper for capabilities discovery, reads an integer attribute. */
+static bool DiscoverGetInt(int16 hcam, Camera* cam, uns32 paramId, int16 attr,
+        long long& value, ParamAccess& access)
+{
+    access = ParamAccess();
+    access.paramId = paramId;
+    access.attr = attr;
+    if (!GetParamAccess(hcam, cam, access))
+        return false;
+    uns16 type = access.type;
+    switch (attr)
+    {
+    case ATTR_TYPE:
+    case ATTR_ACCESS:
+        type = TYPE_UNS16;
+        break;
+    case ATTR_COUNT:
+        type = TYPE_UNS32;
+        break;
+    case ATTR_AVAIL:
+    case ATTR_LIVE:
+        type = TYPE_BOOLEAN;
+        break;
+    default:
+        break;
+    }
+    if (!ParamValueToInt64(type, access.value, value))
+    {
+        access.error = ParamAccess::Error::TypeMismatch;
+        return false;
+    }
+    return true;
+}
+
+/** Helper for capabilities discovery, reads current value of a string parameter. */
+static bool DiscoverGetStr(int16 hcam, Camera* cam, uns32 paramId, std::string& value,
+        ParamAccess& access)
+{
+    access = ParamAccess();
+    access.paramId = paramId;
+    if (!GetParamAccess(hcam, cam, access))
+        return false;
+    if (access.type != TYPE_CHAR_PTR)
+    {
+        access.error = ParamAccess::Error::TypeMismatch;
+        return false;
+    }
+    access.value.val_str[sizeof(access.value.val_str) - 1] = '\0';
+    value = access.value.val_str;
+    return true;
+}
+
+/** Helper for capabilities discovery, sets an integer parameter. */
+static bool DiscoverSetInt(int16 hcam, Camera* cam, uns32 paramId, long long value,
+        ParamAccess& access)
+{
+    access = ParamAccess();
+    access.paramId = paramId;
+    access.type = (uns16)((paramId >> 24) & 0xFF);
+    if (!Int64ToParamValue(access.type, value, access.value))
+    {
+        access.error = ParamAccess::Error::TypeMismatch;
+        return false;
+    }
+    return SetParamAccess(hcam, cam, access);
+}
+
+/** Helper for capabilities discovery, reads items of an enum parameter. */
+static bool DiscoverGetEnum(int16 hcam, Camera* cam, uns32 paramId,
+        std::vector<std::pair<std::string, int32>>& items, ParamAccess& access)
+{
+    long long count;
+    if (!DiscoverGetInt(hcam, cam, paramId, ATTR_COUNT, count, access))
+        return false;
+    items.clear();
+    for (uns32 i = 0; i < (uns32)count; i++)
+    {
+        uns32 strLen;
+        if (!pl_enum_str_length(hcam, paramId, i, &strLen))
+            return access.SetPvcamError();
+        std::vector<char> strBuf(strLen + 1, '\0');
+        int32 value;
+        if (!pl_get_enum_param(hcam, paramId, i, &value, strBuf.data(), strLen))
+            return access.SetPvcamError();
+        items.emplace_back(strBuf.data(), value);
+    }
+    return true;
+}
+
+/**
+ * Walks all readout ports, speeds and gains and all post-processing features
+ * and their parameters. Doesn't touch Python objects, may be called without
+ * the GIL. The speed table and post-processing selection are left modified,
+ * the caller restores them.
+ */
+static bool DiscoverCapabilities(int16 hcam, Camera* cam, Capabilities& caps,
+        ParamAccess& access)
+{
+    long long hasSpeedName;
+    long long hasGainName;
+    if (!DiscoverGetInt(hcam, cam, PARAM_SPDTAB_NAME, ATTR_AVAIL, hasSpeedName, access)
+            || !DiscoverGetInt(hcam, cam, PARAM_GAIN_NAME, ATTR_AVAIL, hasGainName, access))
+        return false;
+
+    std::vector<std::pair<std::string, int32>> portItems;
+    if (!DiscoverGetEnum(hcam, cam, PARAM_READOUT_PORT, portItems, access))
+        return false;
+    for (const auto& portItem : portItems)
+    {
+        Capabilities::Port port;
+        port.name = portItem.first;
+        port.value = portItem.second;
+        if (!DiscoverSetInt(hcam, cam, PARAM_READOUT_PORT, port.value, access))
+            return false;
+
+        long long speedCount;
+        if (!DiscoverGetInt(hcam, cam, PARAM_SPDTAB_INDEX, ATTR_COUNT, speedCount, access))
+            return false;
+        for (long long speedIndex = 0; speedIndex < speedCount; speedIndex++)
+        {
+            Capabilities::Speed speed;
+            speed.index = speedIndex;
+            if (!DiscoverSetInt(hcam, cam, PARAM_SPDTAB_INDEX, speedIndex, access))
+                return false;
+            if (hasSpeedName)
+            {
+                if (!DiscoverGetStr(hcam, cam, PARAM_SPDTAB_NAME, speed.name, access))
+                    return false;
+            }
+            else
+            {
+                speed.name = "Speed_" + std::to_string(speedIndex);
+            }
+
+            long long gainMin;
+            long long gainMax;
+            long long gainInc;
+            if (!DiscoverGetInt(hcam, cam, PARAM_GAIN_INDEX, ATTR_MIN, gainMin, access)
+                    || !DiscoverGetInt(hcam, cam, PARAM_GAIN_INDEX, ATTR_MAX, gainMax, access)
+                    || !DiscoverGetInt(hcam, cam, PARAM_GAIN_INDEX, ATTR_INCREMENT, gainInc,
+                        access)
+                    || !DiscoverGetInt(hcam, cam, PARAM_PIX_TIME, ATTR_CURRENT, speed.pixTime,
+                        access))
+                return false;
+            const long long gainCount = (gainInc > 0) ? (gainMax - gainMin) / gainInc + 1 : 1;
+
+            for (long long n = 0; n < gainCount; n++)
+            {
+                Capabilities::Gain gain;
+                gain.index = gainMin + n * gainInc;
+                if (!DiscoverSetInt(hcam, cam, PARAM_GAIN_INDEX, gain.index, access))
+                    return false;
+                if (hasGainName)
+                {
+                    if (!DiscoverGetStr(hcam, cam, PARAM_GAIN_NAME, gain.name, access))
+                        return false;
+                }
+                else
+                {
+                    gain.name = "Gain_" + std::to_string(gain.index);
+                }
+                if (!DiscoverGetInt(hcam, cam, PARAM_BIT_DEPTH, ATTR_CURRENT, gain.bitDepth,
+                            access))
+                    return false;
+                speed.gains.push_back(std::move(gain));
+            }
+            port.speeds.push_back(std::move(speed));
+        }
+        caps.ports.push_back(std::move(port));
+    }
+
+    // Cameras without post-processing or with incomplete support end up with
+    // whatever was learned so far, like before
+    long long featureCount;
+    if (!DiscoverGetInt(hcam, cam, PARAM_PP_INDEX, ATTR_COUNT, featureCount, access))
+        return access.error == ParamAccess::Error::NotAvailable;
+    for (long long featureIndex = 0; featureIndex < featureCount; featureIndex++)
+    {
+        caps.ppFeatures.emplace_back();
+        Capabilities::PpFeature& feature = caps.ppFeatures.back();
+        feature.index = featureIndex;
+        long long paramCount;
+        if (!DiscoverSetInt(hcam, cam, PARAM_PP_INDEX, featureIndex, access)
+                || !DiscoverGetInt(hcam, cam, PARAM_PP_FEAT_ID, ATTR_CURRENT, feature.id,
+                    access)
+                || !DiscoverGetStr(hcam, cam, PARAM_PP_FEAT_NAME, feature.name, access)
+                || !DiscoverGetInt(hcam, cam, PARAM_PP_PARAM_INDEX, ATTR_COUNT, paramCount,
+                    access))
+        {
+            if (feature.name.empty())
+                caps.ppFeatures.pop_back();
+            return access.error == ParamAccess::Error::NotAvailable;
+        }
+
+        for (long long paramIndex = 0; paramIndex < paramCount; paramIndex++)
+        {
+            Capabilities::PpParam param;
+            param.index = paramIndex;
+            if (!DiscoverSetInt(hcam, cam, PARAM_PP_PARAM_INDEX, paramIndex, access)
+                    || !DiscoverGetInt(hcam, cam, PARAM_PP_PARAM_ID, ATTR_CURRENT, param.id,
+                        access)
+                    || !DiscoverGetStr(hcam, cam, PARAM_PP_PARAM_NAME, param.name, access)
+                    || !DiscoverGetInt(hcam, cam, PARAM_PP_PARAM, ATTR_MIN, param.min, access)
+                    || !DiscoverGetInt(hcam, cam, PARAM_PP_PARAM, ATTR_MAX, param.max, access))
+                return access.error == ParamAccess::Error::NotAvailable;
+            feature.params.push_back(std::move(param));
+        }
+    }
+    return true;
+}
+
+/** Sets int64 value to a dict under given key, returns false with Python error set. */
+static bool SetDictItemInt64(PyObject* dict, const char* key, long long value)
+{
+    PyObject* pyValue = PyLong_FromLongLong(value);
+    if (!pyValue)
+        return false;
+    const int res = PyDict_SetItemString(dict, key, pyValue);
+    Py_DECREF(pyValue);
+    return res == 0;
+}
+
+/** Sets a value to a dict under given key and steals the value reference. */
+static bool SetDictItemSteal(PyObject* dict, const char* key, PyObject* pyValue)
+{
+    if (!pyValue)
+        return false;
+    const int res = PyDict_SetItemString(dict, key, pyValue);
+    Py_DECREF(pyValue);
+    return res == 0;
+}
+
+/** Converts the speed table to the format of Camera.port_speed_gain_table. */
+static PyObject* GetNewPyPortSpeedGainTable(const Capabilities& caps)
+{
+    PyObject* pyTable = PyDict_New();
+    if (!pyTable)
+        return NULL;
+    for (const Capabilities::Port& port : caps.ports)
+    {
+        PyObject* pyPort = PyDict_New();
+        if (!SetDictItemSteal(pyTable, port.name.c_str(), pyPort)
+                || !SetDictItemInt64(pyPort, "port_value", port.value))
+        {
+            Py_DECREF(pyTable);
+            return NULL;
+        }
+        for (const Capabilities::Speed& speed : port.speeds)
+        {
+            PyObject* pySpeed = PyDict_New();
+            if (!SetDictItemSteal(pyPort, speed.name.c_str(), pySpeed)
+                    || !SetDictItemInt64(pySpeed, "speed_index", speed.index)
+                    || !SetDictItemInt64(pySpeed, "pixel_time", speed.pixTime))
+            {
+                Py_DECREF(pyTable);
+                return NULL;
+            }
+            PyObject* pyGainRange = PyList_New((Py_ssize_t)speed.gains.size());
+            if (!SetDictItemSteal(pySpeed, "gain_range", pyGainRange))
+            {
+                Py_DECREF(pyTable);
+                return NULL;
+            }
+            for (size_t n = 0; n < speed.gains.size(); n++)
+            {
+                const Capabilities::Gain& gain = speed.gains[n];
+                PyObject* pyGainIndex = PyLong_FromLongLong(gain.index);
+                if (!pyGainIndex)
+                {
+                    Py_DECREF(pyTable);
+                    return NULL;
+                }
+                PyList_SET_ITEM(pyGainRange, (Py_ssize_t)n, pyGainIndex);
+
+                PyObject* pyGain = PyDict_New();
+                if (!SetDictItemSteal(pySpeed, gain.name.c_str(), pyGain)
+                        || !SetDictItemInt64(pyGain, "gain_index", gain.index)
+                        || !SetDictItemInt64(pyGain, "bit_depth", gain.bitDepth))
+                {
+                    Py_DECREF(pyTable);
+                    return NULL;
+                }
+            }
+        }
+    }
+    return pyTable;
+}
+
+/** Converts the post-processing features to the format of Camera.post_processing_table. */
+static PyObject* GetNewPyPostProcessingTable(const Capabilities& caps)
+{
+    PyObject* pyTable = PyDict_New();
+    if (!pyTable)
+        return NULL;
+    for (const Capabilities::PpFeature& feature : caps.ppFeatures)
+    {
+        PyObject* pyFeature = PyDict_New();
+        if (!SetDictItemSteal(pyTable, feature.name.c_str(), pyFeature))
+        {
+            Py_DECREF(pyTable);
+            return NULL;
+        }
+        for (const Capabilities::PpParam& param : feature.params)
+        {
+            PyObject* pyParam = PyDict_New();
+            if (!SetDictItemSteal(pyFeature, param.name.c_str(), pyParam)
+                    || !SetDictItemInt64(pyParam, "feature_index", feature.index)
+                    || !SetDictItemInt64(pyParam, "feature_id", feature.id)
+                    || !SetDictItemInt64(pyParam, "param_index", param.index)
+                    || !SetDictItemInt64(pyParam, "param_id", param.id)
+                    || !SetDictItemInt64(pyParam, "param_min", param.min)
+                    || !SetDictItemInt64(pyParam, "param_max", param.max))
+            {
+                Py_DECREF(pyTable);
+                return NULL;
+            }
+        }
+    }
+    return pyTable;
+}
+
+/**
+ * Learns the port/speed/gain table and the post-processing table in one pass
+ * with the GIL released. The selected port, speed, gain and post-processing
+ * feature and parameter are restored afterwards.
+ */
+static PyObject* pvc_discover_capabilities(PyObject* self, PyObject* args)
+{
+    int16 hcam;
+    if (!PyArg_ParseTuple(args, "h", &hcam))
+        return ParamParseError();
+
+    std::shared_ptr<Camera> cam = GetCamera(self, hcam, false);
+
+    Capabilities caps;
+    ParamAccess access;
+    ParamAccess restoreAccess;
+    bool ok;
+    bool restored = true;
+    Py_BEGIN_ALLOW_THREADS
+    // Remember the settings changed during discovery, PP selection is optional
+    const uns32 restoreIds[] = { PARAM_READOUT_PORT, PARAM_SPDTAB_INDEX, PARAM_GAIN_INDEX,
+        PARAM_PP_INDEX, PARAM_PP_PARAM_INDEX };
+    std::vector<std::pair<uns32, long long>> origValues;
+    ok = true;
+    for (const uns32 paramId : restoreIds)
+    {
+        long long value;
+        if (DiscoverGetInt(hcam, cam.get(), paramId, ATTR_CURRENT, value, access))
+        {
+            origValues.emplace_back(paramId, value);
+        }
+        else if (access.error != ParamAccess::Error::NotAvailable)
+        {
+            ok = false;
+            break;
+        }
+    }
+
+    if (ok)
+        ok = DiscoverCapabilities(hcam, cam.get(), caps, access);
+
+    // Restore in the order of dependency, i.e. the port first
+    for (const auto& origValue : origValues)
+    {
+        if (!DiscoverSetInt(hcam, cam.get(), origValue.first, origValue.second,
+                    restoreAccess))
+            restored = false;
+    }
+    Py_END_ALLOW_THREADS
+
+    if (!ok)
+        return ParamAccessError(access);
+    if (!restored)
+        return ParamAccessError(restoreAccess);
+
+    PyObject* pyPortSpeedGainTable = GetNewPyPortSpeedGainTable(caps);
+    if (!pyPortSpeedGainTable)
+        return NULL;
+    PyObject* pyPostProcessingTable = GetNewPyPostProcessingTable(caps);
+    if (!pyPostProcessingTable)
+    {
+        Py_DECREF(pyPortSpeedGainTable);
+        return NULL;
+    }
+    return Py_BuildValue("{s:N,s:N}", // dict
+            "port_speed_gain_table", pyPortSpeedGainTable,
+            "post_processing_table", pyPostProcessingTable);
+}
+
 /** Resets all prost-processing features of the open camera. */
 static PyObject* pvc_reset_pp(PyObject* self, PyObject* args)
 {
@@ -1770,6 +5609,10 @@ static PyObject* pvc_reset_pp(PyObject* self, PyObject* args)
     if (!pl_pp_reset(hcam))
         return PvcamError();
 
+    std::shared_ptr<Camera> cam = GetCamera(self, hcam, false);
+    if (cam)
+        cam->m_paramCache.Invalidate();
+
     Py_RETURN_NONE;
 }
 
@@ -1797,6 +5640,9 @@ static PyObject* pvc_sw_trigger(PyObject* self, PyObject* args)
 // Module definition
 
 #define PVC_ADD_METHOD_(name, args, docstring) { #name, pvc_##name, args, PyDoc_STR(docstring) }
+// Positional arguments only, passed as C array without packing them to a tuple
+#define PVC_ADD_FASTCALL_METHOD_(name, docstring) \
+    { #name, (PyCFunction)(void(*)(void))pvc_##name, METH_FASTCALL, PyDoc_STR(docstring) }
 static PyMethodDef pvcMethods[] = {
 
     PVC_ADD_METHOD_(init_pvcam, METH_NOARGS,
@@ -1817,9 +5663,13 @@ static PyMethodDef pvcMethods[] = {
     PVC_ADD_METHOD_(close_camera, METH_VARARGS,
             "Closes a specified camera."),
 
-    PVC_ADD_METHOD_(get_param, METH_VARARGS,
+    PVC_ADD_FASTCALL_METHOD_(get_param,
             "Returns the value of a camera associated with the specified parameter."),
-    PVC_ADD_METHOD_(set_param, METH_VARARGS,
+    PVC_ADD_METHOD_(get_params, METH_VARARGS,
+            "Returns values of multiple parameter attributes in one call."),
+    PVC_ADD_METHOD_(set_params, METH_VARARGS,
+            "Sets multiple parameters in one call."),
+    PVC_ADD_FASTCALL_METHOD_(set_param,
             "Sets a specified parameter to a specified value."),
     PVC_ADD_METHOD_(check_param, METH_VARARGS,
             "Checks if a specified setting of a camera is available."),
@@ -1836,10 +5686,18 @@ static PyMethodDef pvcMethods[] = {
             "Sets up and starts live mode acquisition."),
     PVC_ADD_METHOD_(start_seq, METH_VARARGS,
             "Sets up and starts sequence mode acquisition."),
-    PVC_ADD_METHOD_(check_frame_status, METH_VARARGS,
+    PVC_ADD_FASTCALL_METHOD_(check_frame_status,
             "Checks status of frame transfer."),
-    PVC_ADD_METHOD_(get_frame, METH_VARARGS,
+    PVC_ADD_FASTCALL_METHOD_(get_frame,
             "Gets oldest or latest frame."),
+    PVC_ADD_METHOD_(get_frame_view, METH_VARARGS,
+            "Gets the latest or oldest frame with metadata decoded on access."),
+    PVC_ADD_METHOD_(get_frame_recomposed, METH_VARARGS,
+            "Gets the latest or oldest frame with all ROIs in one full-sensor image."),
+    PVC_ADD_METHOD_(get_frames, METH_VARARGS,
+            "Gets up to given number of queued frames stacked in one array."),
+    PVC_ADD_METHOD_(acquire_stack, METH_VARARGS,
+            "Acquires a stack of frames in one sequence directly to a 3D array."),
     PVC_ADD_METHOD_(finish_seq, METH_VARARGS,
             "Finishes sequence mode acquisition. Must be called before another start_seq with different configuration."),
     PVC_ADD_METHOD_(abort, METH_VARARGS,
@@ -1849,10 +5707,32 @@ static PyMethodDef pvcMethods[] = {
 
     PVC_ADD_METHOD_(reset_frame_counter, METH_VARARGS,
             "Resets a frame counter returned by get_frame."),
+    PVC_ADD_METHOD_(get_acq_stats, METH_VARARGS,
+            "Returns dropped frames and queue statistics of the acquisition."),
+    PVC_ADD_METHOD_(get_param_cache_stats, METH_VARARGS,
+            "Returns hit and miss counters of the parameter attribute cache."),
+    PVC_ADD_METHOD_(set_param_cache_enabled, METH_VARARGS,
+            "Enables or disables the parameter attribute cache."),
+    PVC_ADD_METHOD_(set_acq_buffer_policy, METH_VARARGS,
+            "Sets huge pages, prefault and mlock policy of acquisition buffers."),
+    PVC_ADD_METHOD_(get_acq_buffer_policy, METH_VARARGS,
+            "Returns requested and effective acquisition buffer policy."),
+    PVC_ADD_METHOD_(set_metadata_format, METH_VARARGS,
+            "Selects dicts or NumPy structured arrays for metadata headers."),
+    PVC_ADD_METHOD_(get_metadata_format, METH_VARARGS,
+            "Returns the format of metadata headers returned by get_frame."),
+    PVC_ADD_METHOD_(get_acq_buffer_pool_stats, METH_NOARGS,
+            "Returns statistics of the pool of unused acquisition buffers."),
+    PVC_ADD_METHOD_(set_acq_buffer_pool_limit, METH_VARARGS,
+            "Sets max. bytes of unused acquisition buffers kept for reuse."),
+    PVC_ADD_METHOD_(unpack_bits, METH_VARARGS,
+            "Unpacks pixels compressed with a bit-packing image compression."),
     PVC_ADD_METHOD_(set_exp_modes, METH_VARARGS,
             "Sets a camera's exposure mode or expose out mode."),
     PVC_ADD_METHOD_(read_enum, METH_VARARGS,
             "Returns a list of all key-value pairs of a given enum type."),
+    PVC_ADD_METHOD_(discover_capabilities, METH_VARARGS,
+            "Returns port/speed/gain and post-processing tables of the camera."),
     PVC_ADD_METHOD_(reset_pp, METH_VARARGS,
             "Resets all post-processing modules to their default values."),
     PVC_ADD_METHOD_(sw_trigger, METH_VARARGS,
@@ -1860,20 +5740,123 @@ static PyMethodDef pvcMethods[] = {
 
     { NULL, NULL, 0, NULL }
 };
+#undef PVC_ADD_FASTCALL_METHOD_
 #undef PVC_ADD_METHOD_
 
+/** Creates module state, called once per module object. */
+static int ModuleExec(PyObject* module)
+{
+    import_array1(-1); // Import numpy API
+
+    ModuleState* state = GetModuleState(module);
+    try
+    {
+        state->cameraRegistry = new CameraRegistry();
+    }
+    catch (const std::bad_alloc& /*ex*/)
+    {
+        PyErr_NoMemory();
+        return -1;
+    }
+
+    state->frameViewType =
+        (PyTypeObject*)PyType_FromModuleAndSpec(module, &FrameView_spec, NULL);
+    if (!state->frameViewType)
+        return -1;
+    state->frameBufferType =
+        (PyTypeObject*)PyType_FromModuleAndSpec(module, &FrameBuffer_spec, NULL);
+    if (!state->frameBufferType)
+        return -1;
+#if PY_VERSION_HEX < 0x030A0000
+    // Py_TPFLAGS_DISALLOW_INSTANTIATION not supported yet
+    state->frameViewType->tp_new = NULL;
+    state->frameBufferType->tp_new = NULL;
+#endif
+    if (PyModule_AddType(module, state->frameViewType) < 0
+            || PyModule_AddType(module, state->frameBufferType) < 0)
+        return -1;
+
+    state->mdFrameHeaderDescr = GetNewMdFrameHeaderDescr();
+    if (!state->mdFrameHeaderDescr)
+        return -1;
+    state->mdRoiHeaderDescr = GetNewMdRoiHeaderDescr();
+    if (!state->mdRoiHeaderDescr)
+        return -1;
+
+    return 0;
+}
+
+static int ModuleTraverse(PyObject* module, visitproc visit, void* arg)
+{
+    ModuleState* state = GetModuleState(module);
+    if (!state)
+        return 0;
+    Py_VISIT(state->frameViewType);
+    Py_VISIT(state->frameBufferType);
+    Py_VISIT(state->mdFrameHeaderDescr);
+    Py_VISIT(state->mdRoiHeaderDescr);
+    return 0;
+}
+
+static int ModuleClear(PyObject* module)
+{
+    ModuleState* state = GetModuleState(module);
+    if (!state)
+        return 0;
+    Py_CLEAR(state->frameViewType);
+    Py_CLEAR(state->frameBufferType);
+    Py_CLEAR(state->mdFrameHeaderDescr);
+    Py_CLEAR(state->mdRoiHeaderDescr);
+    return 0;
+}
+
+/**
+ * Drops cameras left open. Acquisitions are aborted first, PVCAM must neither
+ * write to released buffers nor call back to deleted instances.
+ */
+static void ModuleFree(void* module)
+{
+    ModuleClear((PyObject*)module);
+
+    ModuleState* state = GetModuleState((PyObject*)module);
+    if (!state || !state->cameraRegistry)
+        return;
+    for (const auto& item : state->cameraRegistry->cameras)
+    {
+        pl_exp_abort(item.first, CCS_HALT); // Ignore PVCAM errors
+        pl_cam_deregister_callback(item.first, PL_CALLBACK_EOF); // Ignore PVCAM errors
+    }
+    delete state->cameraRegistry;
+    state->cameraRegistry = NULL;
+}
+
+static PyModuleDef_Slot pvcSlots[] = {
+    { Py_mod_exec, (void*)ModuleExec },
+#if PY_VERSION_HEX >= 0x030C0000
+    // PVCAM and the callbacks are process-wide
+    { Py_mod_multiple_interpreters, Py_MOD_MULTIPLE_INTERPRETERS_NOT_SUPPORTED },
+#endif
+#if PY_VERSION_HEX >= 0x030D0000
+    // Camera state is guarded by own mutexes, objects shared by threads by critical sections
+    { Py_mod_gil, Py_MOD_GIL_NOT_USED },
+#endif
+    { 0, NULL } // Sentinel
+};
+
 static struct PyModuleDef pvcModule = {
     PyModuleDef_HEAD_INIT,
     "pvc", // Name of module
     "Provides an interface to PVCAM cameras.", // Module documentation
-    -1, // Module keeps state in global variables
-    pvcMethods // Module functions
+    sizeof(ModuleState), // Module keeps state per module object
+    pvcMethods, // Module functions
+    pvcSlots, // Multi-phase initialization
+    ModuleTraverse,
+    ModuleClear,
+    ModuleFree
 };
 
 PyMODINIT_FUNC
 PyInit_pvc(void)
 {
-    import_array();  // Import numpy API (includes 'return NULL;' on error)
-
-    return PyModule_Create(&pvcModule);
+    return PyModuleDef_Init(&pvcModule);
 }
@@ -0,0 +1,200 @@
+#ifndef PYVCAM_STREAM_FILE_H
+#define PYVCAM_STREAM_FILE_H
+
+// PVCAM
+#include <master.h>
+#include <pvcam.h>
+
+// Local
+#include "acq_buffer.h"
+
+// System
+#include <cstdint>
+#include <vector>
+
+// Layout of files created by streaming to disk, read by pyvcam.StreamFile.
+//
+// The file starts with a header padded to whole pages, followed by raw data
+// as stored in the acquisition buffer, written lap by lap. Each lap of a
+// circular buffer is padded to whole pages, a sequence has one lap only and
+// its frames are stored back to back. The data of a frame is found
+// at the offset listed in the frame index that trails the data. The header
+// is rewritten with the index offset and frame count once streaming ends.
+// A file with zero index offset was not finalized, e.g. the process crashed.
+//
+// All integers are little-endian, the structures are packed.
+
+static constexpr char STREAM_FILE_MAGIC[8] = { 'P', 'V', 'C', 'S', 'T', 'R', 'M', '\0' };
+static constexpr uns32 STREAM_FILE_VERSION = 1;
+
+#pragma pack(push, 1)
+
+struct StreamFileHeader
+{                               /* TOTAL: 72 bytes + ROIs */
+    char magic[8];              // STREAM_FILE_MAGIC
+    uns32 version;              // STREAM_FILE_VERSION
+    uns32 headerBytes;          // Offset of the first lap, multiple of the page size
+    uns32 frameBytes;           // Frame size incl. metadata and alignment
+    uns32 bufferFrameCount;     // Frames per lap
+    uint64_t bufferBytes;       // Acquisition buffer size
+    uint64_t lapBytes;          // Bytes stored per lap incl. padding
+    uint64_t indexOffset;       // Offset of StreamFileIndexEntry array, 0 if not finalized
+    uint64_t frameCount;        // Number of index entries
+    char dtype[8];              // NumPy array-protocol type string, e.g. "<u2"
+    uns16 bitDepth;
+    uns8 metadataEnabled;       // Frames start with md_frame_header if non-zero
+    uns8 imageCompression;      // PL_IMAGE_COMPRESSIONS value at setup
+    uns32 roiCount;             // Number of rgn_type structures following the header
+};
+
+struct StreamFileIndexEntry
+{                               /* TOTAL: 24 bytes */
+    uint64_t offset;            // Position of the frame data in the file
+    uns32 frameNr;              // FrameNr from PVCAM's FRAME_INFO structure
+    uns32 flags;                // STREAM_FRAME_FLAG_* bits
+    long64 timeStamp;           // EOF timestamp from FRAME_INFO
+};
+
+#pragma pack(pop)
+
+static_assert(sizeof(StreamFileHeader) == 72, "Unexpected header size");
+static_assert(sizeof(StreamFileIndexEntry) == 24, "Unexpected index entry size");
+
+// The frame was overwritten in the acquisition buffer before written to disk
+static constexpr uns32 STREAM_FRAME_FLAG_OVERWRITTEN = 1u << 0;
+
+struct StreamSegment
+{
+    uns32 offset{ 0 }; // Position in AcqBuffer, aligned to ALIGNMENT_BOUNDARY
+    uns32 bytes{ 0 }; // Multiple of ALIGNMENT_BOUNDARY
+};
+
+/**
+ * Decides which part of the acquisition buffer is written to the file next
+ * and where every frame lands in the file.
+ *
+ * Writes must start and end at an alignment boundary. Since the frame may not
+ * be a multiple of the alignment boundary, only its aligned part is written,
+ * the residual goes with the next frame. At the end of a circular buffer the
+ * last frame is written with padding up to the next boundary, so every lap
+ * takes the same bytes in the file. A buffer filled once needs no padding,
+ * the residual of its last frame is written with GetFinalSegment.
+ */
+class StreamFileLayout
+{
+public:
+    /** Starts a new file with the first lap at given file offset. */
+    void Reset(uint64_t dataOffset, uns32 bufferBytes, uns32 lapBytes, uns32 frameBytes,
+            bool bufferReused, size_t indexReserve)
+    {
+        m_dataOffset = dataOffset;
+        m_bufferBytes = bufferBytes;
+        m_lapBytes = lapBytes;
+        m_frameBytes = frameBytes;
+        m_bufferReused = bufferReused;
+        m_readIndex = 0;
+        m_frameResidual = 0;
+        m_lap = 0;
+        m_lastFrameOffset = 0;
+        m_index.clear();
+        m_index.reserve(indexReserve);
+    }
+
+    /**
+     * Adds a frame at given offset in the buffer to the index and returns
+     * the segment of the buffer to write now, possibly empty. Frames come
+     * in buffer order, one by one. Also returns the bytes of the buffer not
+     * written so far including this frame.
+     */
+    StreamSegment AddFrame(uns32 frameOffset, uns32 frameNr, long64 timeStamp,
+            uns32& availableBytes)
+    {
+        availableBytes = m_frameResidual + m_frameBytes;
+
+        // This routine may fall behind writing the latest data, e.g. if
+        // the callback was not invoked for some frame. Catch up with the end
+        // of this frame when it is ahead of the read index by more than that.
+        if (frameOffset >= m_readIndex
+                && availableBytes < frameOffset + m_frameBytes - m_readIndex)
+        {
+            availableBytes = frameOffset + m_frameBytes - m_readIndex;
+        }
+
+        StreamSegment segment;
+        segment.offset = m_readIndex;
+        segment.bytes = (availableBytes / ALIGNMENT_BOUNDARY) * ALIGNMENT_BOUNDARY;
+        // Sequence buffer is filled only once, the residual of the last frame
+        // is written together with the padding when streaming ends.
+        const bool lastFrameInBuffer = m_bufferReused
+            && (m_bufferBytes - m_readIndex - segment.bytes) < ALIGNMENT_BOUNDARY;
+        if (lastFrameInBuffer)
+        {
+            segment.bytes += ALIGNMENT_BOUNDARY;
+        }
+
+        // Lower offset means PVCAM started next lap
+        if (!m_index.empty() && frameOffset <= m_lastFrameOffset)
+        {
+            m_lap++;
+        }
+        m_lastFrameOffset = frameOffset;
+
+        StreamFileIndexEntry entry;
+        entry.offset = m_dataOffset + m_lap * m_lapBytes + frameOffset;
+        entry.frameNr = frameNr;
+        entry.flags = 0;
+        entry.timeStamp = timeStamp;
+        m_index.push_back(entry);
+
+        // Store the count of frame bytes not written.
+        // Increment read index or reset to start of frame buffer if needed
+        m_frameResidual = (lastFrameInBuffer) ? 0 : availableBytes - segment.bytes;
+        m_readIndex = (lastFrameInBuffer) ? 0 : m_readIndex + segment.bytes;
+
+        return segment;
+    }
+
+    /** Flags the frame added last as overwritten before written to disk. */
+    void MarkLastOverwritten()
+    {
+        if (!m_index.empty())
+            m_index.back().flags |= STREAM_FRAME_FLAG_OVERWRITTEN;
+    }
+
+    /** Returns the segment with the rest of the last frame and padding, possibly empty. */
+    StreamSegment GetFinalSegment() const
+    {
+        StreamSegment segment;
+        if (m_frameResidual != 0)
+        {
+            segment.offset = m_readIndex;
+            segment.bytes = (uns32)ALIGNMENT_BOUNDARY;
+        }
+        return segment;
+    }
+
+    const std::vector<StreamFileIndexEntry>& GetIndex() const
+    {
+        return m_index;
+    }
+
+    /** Frees the memory of the index. */
+    void Clear()
+    {
+        m_index = std::vector<StreamFileIndexEntry>();
+    }
+
+private:
+    uint64_t m_dataOffset{ 0 }; // File offset of the first lap
+    uns32 m_bufferBytes{ 0 };
+    uns32 m_lapBytes{ 0 }; // File bytes per lap of a circular buffer
+    uns32 m_frameBytes{ 0 };
+    bool m_bufferReused{ false };
+    uns32 m_readIndex{ 0 }; // Position in the buffer to save data from
+    uns32 m_frameResidual{ 0 };
+    uint64_t m_lap{ 0 };
+    uint64_t m_lastFrameOffset{ 0 };
+    std::vector<StreamFileIndexEntry> m_index{};
+};
+
+#endif // PYVCAM_STREAM_FILE_H
@@ -0,0 +1,149 @@
+import struct
+
+import numpy as np
+
+from pyvcam import pvc
+
+
+class StreamFile:
+    """Reads files created by streaming to disk with random access to frames.
+
+    The file is memory-mapped, ``stream_file[i]`` returns a 2D np.array view
+    with pixel data of the first ROI of i-th frame without reading any other
+    frame. Negative indices count from the end like with lists. Frames
+    compressed with bit-packing are unpacked to a new array instead.
+
+    Attributes:
+        rois(list): List of dictionaries with ROIs the acquisition was set up with.
+        dtype(np.dtype): The pixel data type.
+        bit_depth(int): The pixel bit depth.
+        image_compression(int): The PL_IMAGE_COMPRESSIONS value, 0 if frames
+            are not compressed.
+        frame_bytes(int): The size of each frame including metadata in bytes.
+        metadata_enabled(bool): True if frames start with PVCAM metadata headers.
+        frame_nr(np.array): Hardware frame number of every frame.
+        timestamp(np.array): EOF timestamp of every frame.
+        overwritten(np.array): True for frames overwritten in the acquisition
+            buffer before they were written to disk, their data are not valid.
+    """
+
+    MAGIC = b'PVCSTRM\0'
+    _HEADER = struct.Struct('<8sIIIIQQQQ8sHBBI')
+    _ROI = struct.Struct('<6H')
+    _INDEX_DTYPE = np.dtype([('offset', '<u8'), ('frame_nr', '<u4'),
+                             ('flags', '<u4'), ('timestamp', '<i8')])
+    _FLAG_OVERWRITTEN = 1 << 0
+
+    # Offsets within PVCAM md_frame_header and md_frame_roi_header structures
+    _MD_FRAME_HEADER_SIZE = 48
+    _MD_FRAME_EXT_SIZE_OFFSET = 38
+    _MD_ROI_HEADER_SIZE = 32
+    _MD_ROI_EXT_SIZE_OFFSET = 23
+    _MD_ROI_DATA_SIZE_OFFSET = 25
+    _MD_VERSION_OFFSET = 4
+
+    def __init__(self, path):
+        self.__mmap = np.memmap(path, dtype=np.uint8, mode='r')
+        try:
+            self.__parse()
+        except Exception:
+            self.close()
+            raise
+
+    def __parse(self):
+        if len(self.__mmap) < self._HEADER.size:
+            raise ValueError('File too small to be a stream file')
+        (magic, version, _header_bytes, frame_bytes, buffer_frame_count,
+         _buffer_bytes, _lap_bytes, index_offset, frame_count, dtype,
+         bit_depth, metadata_enabled, image_compression, roi_count) = \
+            self._HEADER.unpack_from(self.__mmap, 0)
+        if magic != self.MAGIC:
+            raise ValueError('Not a stream file, invalid signature')
+        if version != 1:
+            raise ValueError(f'Unsupported stream file version {version}')
+        if index_offset == 0:
+            raise ValueError('Stream file was not finalized')
+
+        self.dtype = np.dtype(dtype.rstrip(b'\0').decode('ascii'))
+        self.bit_depth = bit_depth
+        self.image_compression = image_compression
+        self.frame_bytes = frame_bytes
+        self.buffer_frame_count = buffer_frame_count
+        self.metadata_enabled = bool(metadata_enabled)
+
+        self.rois = []
+        for i in range(roi_count):
+            s1, s2, sbin, p1, p2, pbin = self._ROI.unpack_from(
+                self.__mmap, self._HEADER.size + i * self._ROI.size)
+            self.rois.append({'s1': s1, 's2': s2, 'sbin': sbin,
+                              'p1': p1, 'p2': p2, 'pbin': pbin})
+
+        index_end = index_offset + frame_count * self._INDEX_DTYPE.itemsize
+        if index_end > len(self.__mmap):
+            raise ValueError('Stream file truncated, frame index incomplete')
+        self.__index = np.frombuffer(self.__mmap, dtype=self._INDEX_DTYPE,
+                                     count=frame_count, offset=index_offset)
+        self.frame_nr = self.__index['frame_nr']
+        self.timestamp = self.__index['timestamp']
+        self.overwritten = (self.__index['flags'] & self._FLAG_OVERWRITTEN) != 0
+
+        roi = self.rois[0]
+        self.__shape = ((roi['p2'] - roi['p1'] + 1) // roi['pbin'],
+                        (roi['s2'] - roi['s1'] + 1) // roi['sbin'])
+        pixel_count = self.__shape[0] * self.__shape[1]
+        if self.image_compression:
+            self.__data_size = (pixel_count * self.image_compression + 7) // 8
+            self.dtype = np.dtype('<u2' if self.image_compression <= 16 else '<u4')
+        else:
+            self.__data_size = pixel_count * self.dtype.itemsize
+
+    def close(self):
+        # The mapping is released once the arrays returned so far are deleted too
+        self.__index = None
+        self.__mmap = None
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, exc_type, exc_value, traceback):
+        self.close()
+
+    def __len__(self):
+        return len(self.__index)
+
+    def __iter__(self):
+        for i in range(len(self)):
+            yield self[i]
+
+    def raw(self, i):
+        """Returns all bytes of i-th frame, including metadata if enabled."""
+        offset = int(self.__index['offset'][i])
+        return self.__mmap[offset:offset + self.frame_bytes]
+
+    def __getitem__(self, i):
+        """Returns 2D pixel data of the first ROI of i-th frame."""
+        frame = self.raw(i)
+        offset = 0
+        if self.metadata_enabled:
+            offset = self._MD_FRAME_HEADER_SIZE + int.from_bytes(
+                frame[self._MD_FRAME_EXT_SIZE_OFFSET:self._MD_FRAME_EXT_SIZE_OFFSET + 2],
+                'little')
+            roi_ext_size = int.from_bytes(
+                frame[offset + self._MD_ROI_EXT_SIZE_OFFSET:
+                      offset + self._MD_ROI_EXT_SIZE_OFFSET + 2], 'little')
+            # The ROI size is in header since version 2, the first ROI keeps its shape
+            if frame[self._MD_VERSION_OFFSET] >= 2:
+                roi_data_size = int.from_bytes(
+                    frame[offset + self._MD_ROI_DATA_SIZE_OFFSET:
+                          offset + self._MD_ROI_DATA_SIZE_OFFSET + 4], 'little')
+                if roi_data_size != self.__data_size:
+                    raise ValueError(f'Frame {i} has ROI of unexpected size')
+            offset += self._MD_ROI_HEADER_SIZE + roi_ext_size
+        pixel_count = self.__shape[0] * self.__shape[1]
+        if self.image_compression:
+            # Bit-packing modes equal the number of bits per pixel
+            data = frame[offset:offset + self.__data_size]
+            return pvc.unpack_bits(data, self.image_compression, pixel_count) \
+                .reshape(self.__shape)
+        return frame[offset:offset + pixel_count * self.dtype.itemsize] \
+            .view(self.dtype).reshape(self.__shape)
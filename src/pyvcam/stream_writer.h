@@ -0,0 +1,399 @@
+#ifndef PYVCAM_STREAM_WRITER_H
+#define PYVCAM_STREAM_WRITER_H
+
+// PVCAM
+#include <master.h>
+
+// Local
+#include "acq_buffer.h"
+#include "io_uring_writer.h"
+#include "stream_file.h"
+
+// System
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <system_error>
+#include <thread>
+
+#ifdef _WIN32
+    #include <Windows.h>
+    using FileHandle = HANDLE;
+    const/*expr*/ auto cInvalidFileHandle = (FileHandle)INVALID_HANDLE_VALUE;
+#else
+    #include <sys/types.h> // open
+    #include <sys/stat.h> // open
+    #include <fcntl.h> // open
+    #include <unistd.h> // close, write, pwrite
+    using FileHandle = int;
+    constexpr auto cInvalidFileHandle = (FileHandle)-1;
+#endif
+
+// Local constants
+
+static constexpr size_t STREAM_QUEUE_CAPACITY = 64; // Max. segments waiting for disk
+static constexpr unsigned STREAM_URING_DEPTH = 8; // Max. io_uring writes in flight
+static constexpr uns32 STREAM_URING_CHUNK = 1024 * 1024; // Max. bytes per io_uring write
+
+// Local types
+
+/** Writes data at the file position, returns the number of bytes written. */
+inline uns32 WriteFileData(FileHandle file, const void* data, uns32 bytesToWrite)
+{
+    uns32 bytesWritten = 0;
+#ifdef _WIN32
+    ::WriteFile(file, data, (DWORD)bytesToWrite, (LPDWORD)&bytesWritten, NULL);
+#else
+    const ssize_t res = ::write(file, data, bytesToWrite);
+    if (res > 0)
+        bytesWritten = (uns32)res;
+#endif
+    return bytesWritten;
+}
+
+/** Writes data at given position, the file position is not changed. */
+inline uns32 WriteFileDataAt(FileHandle file, const void* data, uns32 bytesToWrite,
+        uint64_t fileOffset)
+{
+    uns32 bytesWritten = 0;
+#ifdef _WIN32
+    OVERLAPPED overlapped{};
+    overlapped.Offset = (DWORD)fileOffset;
+    overlapped.OffsetHigh = (DWORD)(fileOffset >> 32);
+    ::WriteFile(file, data, (DWORD)bytesToWrite, (LPDWORD)&bytesWritten, &overlapped);
+#else
+    const ssize_t res = ::pwrite(file, data, bytesToWrite, (off_t)fileOffset);
+    if (res > 0)
+        bytesWritten = (uns32)res;
+#endif
+    return bytesWritten;
+}
+
+inline std::string GetStreamWriteError(uns32 bytesToWrite, uns32 bytesWritten)
+{
+    return std::string("Streaming to disk failed, not all bytes written")
+        + " - expected " + std::to_string(bytesToWrite)
+        + " but written " + std::to_string(bytesWritten) + ".";
+}
+
+/**
+ * Background thread writing segments of the acquisition buffer to a file.
+ *
+ * The EOF callback hands segments over with TryQueue that never waits. If the
+ * queue is full, the segment is rejected and the caller keeps it for later,
+ * the rejections are counted. The bytes written are reported only once they
+ * landed on disk, so the caller knows which part of the buffer may be reused.
+ */
+class StreamWriter
+{
+public:
+    StreamWriter() = default;
+    StreamWriter(const StreamWriter&) = delete;
+    StreamWriter& operator=(const StreamWriter&) = delete;
+
+    ~StreamWriter()
+    {
+        Stop();
+    }
+
+    /**
+     * Starts writing to given file at its current position, the data offset
+     * is needed by the io_uring backend. Falls back to synchronous writes if
+     * io_uring is requested but not available.
+     */
+    bool Start(FileHandle file, std::shared_ptr<AcqBuffer> acqBuffer, uint64_t dataOffset,
+            bool useIoUring)
+    {
+        Stop();
+
+        m_file = file;
+        m_dataOffset = dataOffset;
+        m_queue.clear();
+        m_stop = false;
+        m_failed = false;
+        m_error.clear();
+        m_writtenBytes = 0;
+        m_queueFull = 0;
+
+#ifdef PYVCAM_HAS_IO_URING
+        if (useIoUring)
+        {
+            std::unique_ptr<IoUringWriter> uring(new(std::nothrow) IoUringWriter());
+            if (uring && uring->Open(file, acqBuffer->data, acqBuffer->paddedSize,
+                        STREAM_URING_DEPTH))
+            {
+                m_uring = std::move(uring);
+            }
+        }
+        m_backend = (m_uring) ? "io_uring" : "write";
+#else
+        (void)useIoUring; // Not available on this platform
+        m_backend = "write";
+#endif
+
+        try
+        {
+            m_thread = std::thread(&StreamWriter::Run, this, std::move(acqBuffer));
+        }
+        catch (const std::system_error& /*ex*/)
+        {
+#ifdef PYVCAM_HAS_IO_URING
+            m_uring.reset();
+#endif
+            m_backend = NULL;
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * Hands a segment over to the writer thread without waiting. A segment
+     * contiguous with the last queued one is merged into it, so the queue
+     * grows only when the circular buffer wraps. Returns false if the queue
+     * is full, the segment is not queued then.
+     */
+    bool TryQueue(const StreamSegment& segment)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_queue.empty()
+                    && m_queue.back().offset + m_queue.back().bytes == segment.offset)
+            {
+                m_queue.back().bytes += segment.bytes;
+            }
+            else if (m_queue.size() < STREAM_QUEUE_CAPACITY)
+            {
+                m_queue.push_back(segment);
+            }
+            else
+            {
+                m_queueFull++;
+                return false;
+            }
+        }
+        m_cond.notify_all();
+        return true;
+    }
+
+    /** Same as TryQueue, but waits for room in the queue. Not for the callback. */
+    void Queue(const StreamSegment& segment)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cond.wait(lock, [this, &segment]() {
+            return m_queue.size() < STREAM_QUEUE_CAPACITY || (!m_queue.empty()
+                && m_queue.back().offset + m_queue.back().bytes == segment.offset);
+        });
+        lock.unlock();
+        TryQueue(segment); // Can't fail, only this thread queues
+    }
+
+    /** Lets the writer flush all queued segments, waits until it's done. */
+    void Stop()
+    {
+        if (!m_thread.joinable())
+            return;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_cond.notify_all();
+        m_thread.join();
+#ifdef PYVCAM_HAS_IO_URING
+        m_uring.reset();
+#endif
+    }
+
+    /** Returns bytes written or skipped after failure, in queue order. */
+    uint64_t GetWrittenBytes() const
+    {
+        return m_writtenBytes.load();
+    }
+
+    /** Returns the number of segments rejected by TryQueue as the queue was full. */
+    uint64_t GetQueueFullCount() const
+    {
+        return m_queueFull.load();
+    }
+
+    /** Returns the name of the backend in use, or NULL if never started. */
+    const char* GetBackend() const
+    {
+        return m_backend.load();
+    }
+
+    bool HasFailed() const
+    {
+        return m_failed.load();
+    }
+
+    std::string GetError() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_error;
+    }
+
+private:
+    void SetWriteError(uns32 bytesToWrite, uns32 bytesWritten)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_failed)
+            return;
+        m_error = GetStreamWriteError(bytesToWrite, bytesWritten);
+        m_failed = true;
+    }
+
+    /**
+     * Takes the oldest segment from the queue. If asked to wait, returns false
+     * only when stopped and the queue is empty, otherwise also when empty.
+     */
+    bool Pop(StreamSegment& segment, bool wait)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            if (wait)
+            {
+                m_cond.wait(lock, [this]() {
+                    return !m_queue.empty() || m_stop;
+                });
+            }
+            if (m_queue.empty())
+                return false;
+            segment = m_queue.front();
+            m_queue.pop_front();
+        }
+        m_cond.notify_all(); // Room in the queue for Queue
+        return true;
+    }
+
+    /** Writes queued segments to disk until stopped and the queue is empty. */
+    void Run(std::shared_ptr<AcqBuffer> acqBuffer)
+    {
+#ifdef PYVCAM_HAS_IO_URING
+        if (m_uring)
+        {
+            RunIoUring(acqBuffer);
+            return;
+        }
+#endif
+
+        StreamSegment segment;
+        while (Pop(segment, true))
+        {
+            // Once failed, drain the queue without writing
+            if (!m_failed)
+            {
+                const void* data = reinterpret_cast<const uns8*>(acqBuffer->data)
+                    + segment.offset;
+                const uns32 bytesWritten = WriteFileData(m_file, data, segment.bytes);
+                if (bytesWritten != segment.bytes)
+                    SetWriteError(segment.bytes, bytesWritten);
+            }
+            m_writtenBytes += segment.bytes;
+        }
+    }
+
+#ifdef PYVCAM_HAS_IO_URING
+    /**
+     * Same as Run, but keeps up to STREAM_URING_DEPTH writes in flight. Bytes
+     * are reported as written, i.e. the part of the acquisition buffer as
+     * reusable, only once all writes submitted before have landed too.
+     */
+    void RunIoUring(const std::shared_ptr<AcqBuffer>& acqBuffer)
+    {
+        struct Write
+        {
+            uns32 bytes;
+            bool done;
+        };
+        std::deque<Write> writes{}; // In submission order
+        uint64_t firstTag = 0; // Tag of the write at the front
+        uint64_t fileOffset = m_dataOffset;
+        StreamSegment segment{}; // Part of the segment not submitted yet
+        IoUringWriter& uring = *m_uring;
+
+        for (;;)
+        {
+            bool flushed = false;
+            while (uring.InFlight() < uring.Depth())
+            {
+                if (segment.bytes == 0 && !Pop(segment, uring.InFlight() == 0))
+                {
+                    flushed = uring.InFlight() == 0; // Stopped and the queue is empty
+                    break;
+                }
+
+                const uns32 bytes = (std::min)(segment.bytes, STREAM_URING_CHUNK);
+                const void* data = reinterpret_cast<const uns8*>(acqBuffer->data)
+                    + segment.offset;
+                // Once failed, drain the queue without writing
+                if (!m_failed
+                        && uring.Submit(data, bytes, fileOffset, firstTag + writes.size()))
+                {
+                    writes.push_back({ bytes, false });
+                }
+                else
+                {
+                    SetWriteError(bytes, 0);
+                    m_writtenBytes += bytes;
+                }
+                fileOffset += bytes;
+                segment.offset += bytes;
+                segment.bytes -= bytes;
+            }
+            if (flushed)
+                break;
+            if (uring.InFlight() == 0)
+                continue;
+
+            const bool reapOk = uring.Reap(1, [&](uint64_t tag, int32_t res) {
+                Write& write = writes[(size_t)(tag - firstTag)];
+                write.done = true;
+                if (res != (int32_t)write.bytes)
+                    SetWriteError(write.bytes, (res > 0) ? (uns32)res : 0);
+            });
+            if (!reapOk)
+            {
+                // Writes in flight are lost, consider them done
+                SetWriteError(writes.front().bytes, 0);
+                for (const Write& write : writes)
+                    m_writtenBytes += write.bytes;
+                firstTag += writes.size();
+                writes.clear();
+                uring.Close();
+                continue;
+            }
+
+            while (!writes.empty() && writes.front().done)
+            {
+                m_writtenBytes += writes.front().bytes;
+                writes.pop_front();
+                firstTag++;
+            }
+        }
+    }
+#endif
+
+    FileHandle m_file{ cInvalidFileHandle };
+    uint64_t m_dataOffset{ 0 }; // File offset of the first segment
+    std::thread m_thread{};
+    mutable std::mutex m_mutex{}; // Guards the queue, stop flag and error
+    std::condition_variable m_cond{};
+    std::deque<StreamSegment> m_queue{};
+    bool m_stop{ false };
+    std::string m_error{};
+    std::atomic<bool> m_failed{ false };
+    std::atomic<uint64_t> m_writtenBytes{ 0 };
+    std::atomic<uint64_t> m_queueFull{ 0 };
+    std::atomic<const char*> m_backend{ NULL };
+#ifdef PYVCAM_HAS_IO_URING
+    std::unique_ptr<IoUringWriter> m_uring{};
+#endif
+};
+
+#endif // PYVCAM_STREAM_WRITER_H
@@ -0,0 +1,113 @@
+#ifndef PYVCAM_TASK_THREAD_H
+#define PYVCAM_TASK_THREAD_H
+
+// System
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <system_error>
+#include <thread>
+
+/**
+ * Thread running a task whenever signaled, for work the PVCAM callback must
+ * not do itself. Signaling never waits for the task, signals arriving before
+ * the task got to run are merged into one run.
+ */
+class TaskThread
+{
+public:
+    TaskThread() = default;
+    TaskThread(const TaskThread&) = delete;
+    TaskThread& operator=(const TaskThread&) = delete;
+
+    ~TaskThread()
+    {
+        Stop();
+    }
+
+    /** Starts the thread running given task, replaces the task of previous start. */
+    bool Start(std::function<void()> task)
+    {
+        Stop();
+
+        m_task = std::move(task);
+        m_signaled = false;
+        m_busy = false;
+        m_stop = false;
+        try
+        {
+            m_thread = std::thread(&TaskThread::Run, this);
+        }
+        catch (const std::system_error& /*ex*/)
+        {
+            m_task = nullptr;
+            return false;
+        }
+        return true;
+    }
+
+    /** Lets the task run once more, returns false if the thread is not running. */
+    bool Signal()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_thread.joinable() || m_stop)
+                return false;
+            m_signaled = true;
+        }
+        m_cond.notify_all();
+        return true;
+    }
+
+    /** Drops a pending signal and waits for the running task to finish. */
+    void Cancel()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_signaled = false;
+        m_cond.wait(lock, [this]() { return !m_busy; });
+    }
+
+    /** Cancels the task and waits for the thread to exit. */
+    void Stop()
+    {
+        if (!m_thread.joinable())
+            return;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_signaled = false;
+            m_stop = true;
+        }
+        m_cond.notify_all();
+        m_thread.join();
+        m_task = nullptr;
+    }
+
+private:
+    void Run()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        for (;;)
+        {
+            m_cond.wait(lock, [this]() { return m_signaled || m_stop; });
+            if (m_stop)
+                return;
+            m_signaled = false;
+            m_busy = true;
+            lock.unlock();
+            m_task();
+            lock.lock();
+            m_busy = false;
+            m_cond.notify_all(); // Wakeup Cancel
+        }
+    }
+
+    std::function<void()> m_task{};
+    std::thread m_thread{};
+    std::mutex m_mutex{}; // Guards the flags, never held while the task runs
+    std::condition_variable m_cond{};
+    bool m_signaled{ false };
+    bool m_busy{ false };
+    bool m_stop{ false };
+};
+
+#endif // PYVCAM_TASK_THREAD_H
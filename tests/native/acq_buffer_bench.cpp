@@ -0,0 +1,146 @@
+// Benchmark of AcqBuffer allocation policies used by the pvc module.
+//
+// A fake PVCAM driver copies frames into the acquisition buffer one after
+// another, like the DMA does. The copy time of every frame is measured during
+// the first lap, when pages of a lazily allocated buffer are faulted in, and
+// during the second lap for reference. The allocation time is reported too,
+// because pre-faulting moves the cost of page faults to the setup.
+// Policies not supported by the system are reported as the fallback in use,
+// explicit huge pages need a pool reserved e.g. via /proc/sys/vm/nr_hugepages
+// and mlock may need raised RLIMIT_MEMLOCK.
+//
+// Build and run from the repository root, e.g. on Linux:
+//   g++ -std=c++14 -O2 -Isrc/pyvcam tests/native/acq_buffer_bench.cpp -o acq_buffer_bench
+//   ./acq_buffer_bench [buffer_mib] [frame_kib]
+
+// Local
+#include "acq_buffer.h"
+
+// System
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+static const char* const HUGE_PAGES_NAMES[] = { "none", "transparent", "2m", "1g" };
+static const char* const PREFAULT_NAMES[] = { "none", "populate", "touch" };
+
+struct LapResult
+{
+    double meanUs{ 0 };
+    double p99Us{ 0 };
+    double maxUs{ 0 };
+};
+
+static LapResult RunLap(AcqBuffer& buffer, const std::vector<uint8_t>& frame)
+{
+    const size_t frameBytes = frame.size();
+    const size_t frameCount = buffer.size / frameBytes;
+
+    std::vector<double> times;
+    times.reserve(frameCount);
+    for (size_t n = 0; n < frameCount; n++)
+    {
+        uint8_t* dst = static_cast<uint8_t*>(buffer.data) + n * frameBytes;
+        const auto start = Clock::now();
+        memcpy(dst, frame.data(), frameBytes);
+        const auto end = Clock::now();
+        times.push_back(std::chrono::duration<double, std::micro>(end - start).count());
+    }
+
+    LapResult result;
+    for (const double t : times)
+        result.meanUs += t;
+    result.meanUs /= times.size();
+    std::sort(times.begin(), times.end());
+    result.p99Us = times[std::min(times.size() - 1, times.size() * 99 / 100)];
+    result.maxUs = times.back();
+    return result;
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t bufferMiB = (argc > 1) ? (size_t)atol(argv[1]) : 512;
+    const size_t frameKiB = (argc > 2) ? (size_t)atol(argv[2]) : 8192;
+    const size_t frameBytes = frameKiB * 1024;
+    const size_t frameCount = bufferMiB * 1024 * 1024 / frameBytes;
+    if (frameCount < 2)
+    {
+        fprintf(stderr, "The buffer must hold at least two frames\n");
+        return 1;
+    }
+
+    std::vector<uint8_t> frame(frameBytes);
+    for (size_t n = 0; n < frameBytes; n++)
+        frame[n] = (uint8_t)n;
+
+    printf("Buffer %zu frames, %zu KiB each\n\n", frameCount, frameKiB);
+    printf("%-28s %-28s %10s | %27s | %27s\n", "requested", "effective", "alloc ms",
+            "lap 1 mean/p99/max us", "lap 2 mean/p99/max us");
+
+    const AcqBufferHugePages hugePagesList[] = {
+        AcqBufferHugePages::None,
+        AcqBufferHugePages::Transparent,
+        AcqBufferHugePages::Explicit2M,
+        AcqBufferHugePages::Explicit1G,
+    };
+    const AcqBufferPrefault prefaultList[] = {
+        AcqBufferPrefault::None,
+        AcqBufferPrefault::Populate,
+        AcqBufferPrefault::Touch,
+    };
+
+    for (const AcqBufferHugePages hugePages : hugePagesList)
+    {
+        for (const AcqBufferPrefault prefault : prefaultList)
+        {
+            for (const bool lock : { false, true })
+            {
+                AcqBufferPolicy policy;
+                policy.hugePages = hugePages;
+                policy.prefault = prefault;
+                policy.lock = lock;
+
+                const auto allocStart = Clock::now();
+                AcqBuffer* buffer;
+                try
+                {
+                    buffer = new AcqBuffer(frameCount * frameBytes, policy);
+                }
+                catch (const std::bad_alloc& /*ex*/)
+                {
+                    printf("%s/%s/%s: allocation failed\n", HUGE_PAGES_NAMES[(int)hugePages],
+                            PREFAULT_NAMES[(int)prefault], (lock) ? "mlock" : "-");
+                    continue;
+                }
+                const double allocMs = std::chrono::duration<double, std::milli>(
+                        Clock::now() - allocStart).count();
+
+                const LapResult lap1 = RunLap(*buffer, frame);
+                const LapResult lap2 = RunLap(*buffer, frame);
+
+                char requested[64];
+                char effective[64];
+                snprintf(requested, sizeof(requested), "%s/%s/%s",
+                        HUGE_PAGES_NAMES[(int)policy.hugePages],
+                        PREFAULT_NAMES[(int)policy.prefault], (policy.lock) ? "mlock" : "-");
+                snprintf(effective, sizeof(effective), "%s/%s/%s",
+                        HUGE_PAGES_NAMES[(int)buffer->effective.hugePages],
+                        PREFAULT_NAMES[(int)buffer->effective.prefault],
+                        (buffer->effective.lock) ? "mlock" : "-");
+                printf("%-28s %-28s %10.1f | %8.1f %8.1f %9.1f | %8.1f %8.1f %9.1f\n",
+                        requested, effective, allocMs,
+                        lap1.meanUs, lap1.p99Us, lap1.maxUs,
+                        lap2.meanUs, lap2.p99Us, lap2.maxUs);
+
+                delete buffer;
+            }
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,173 @@
+// Verification and benchmark of bit-pack unpacking used by the pvc module.
+//
+// Random pixels are packed with every PL_IMAGE_COMPRESSION_BITPACK* mode and
+// unpacked by the scalar reference and by every SIMD kernel the CPU supports.
+// The results are compared with the original pixels for many pixel counts to
+// cover the scalar tails too. Then a whole frame is unpacked repeatedly and
+// the throughput of each kernel is reported relative to the scalar reference.
+//
+// Build and run from the repository root, e.g. on Linux:
+//   g++ -std=c++14 -O2 -Isrc/pyvcam tests/native/bitpack_bench.cpp -o bitpack_bench
+//   ./bitpack_bench [width] [height]
+
+// Local
+#include "bitpack.h"
+
+// System
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+static const unsigned BITS_LIST[] = { 9, 10, 11, 12, 13, 14, 15, 17, 18 };
+
+static const char* IsaName(BitUnpackIsa isa)
+{
+    switch (isa)
+    {
+    case BitUnpackIsa::Scalar: return "scalar";
+    case BitUnpackIsa::Sse41: return "sse4.1";
+    case BitUnpackIsa::Avx2: return "avx2";
+    case BitUnpackIsa::Neon: return "neon";
+    }
+    return "?";
+}
+
+static std::vector<BitUnpackIsa> GetSupportedIsas()
+{
+    std::vector<BitUnpackIsa> isas{ BitUnpackIsa::Scalar };
+    switch (BitUnpackGetIsa())
+    {
+    case BitUnpackIsa::Avx2:
+        isas.push_back(BitUnpackIsa::Sse41);
+        isas.push_back(BitUnpackIsa::Avx2);
+        break;
+    case BitUnpackIsa::Sse41:
+    case BitUnpackIsa::Neon:
+        isas.push_back(BitUnpackGetIsa());
+        break;
+    default:
+        break;
+    }
+    return isas;
+}
+
+/** Packs pixels bit by bit, independently of the unpacking code. */
+static std::vector<uint8_t> Pack(const std::vector<uint32_t>& pixels, unsigned bits)
+{
+    std::vector<uint8_t> packed(BitPackPackedBytes(pixels.size(), bits), 0);
+    size_t bit = 0;
+    for (const uint32_t pixel : pixels)
+    {
+        for (unsigned b = 0; b < bits; b++, bit++)
+        {
+            if (pixel & (1u << b))
+                packed[bit / 8] |= (uint8_t)(1u << (bit % 8));
+        }
+    }
+    return packed;
+}
+
+template<typename T>
+static bool Verify(BitUnpackIsa isa, unsigned bits, std::mt19937& rng)
+{
+    std::uniform_int_distribution<uint32_t> dist(0, (1u << bits) - 1);
+    for (size_t count = 0; count <= 300; count++)
+    {
+        std::vector<uint32_t> pixels(count);
+        for (uint32_t& pixel : pixels)
+            pixel = dist(rng);
+        const std::vector<uint8_t> packed = Pack(pixels, bits);
+
+        // Guard values behind the output catch writes past the end
+        std::vector<T> unpacked(count + 16, (T)0xA5A5A5A5);
+        BitUnpackWithIsa(isa, packed.data(), count, bits, unpacked.data());
+        for (size_t n = 0; n < count + 16; n++)
+        {
+            const T expected = (n < count) ? (T)pixels[n] : (T)0xA5A5A5A5;
+            if (unpacked[n] != expected)
+            {
+                printf("%s %u-bit: mismatch at pixel %zu of %zu\n",
+                        IsaName(isa), bits, n, count);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+template<typename T>
+static double Measure(BitUnpackIsa isa, unsigned bits, const std::vector<uint8_t>& packed,
+        size_t count, std::vector<T>& unpacked, int repeats)
+{
+    double bestUs = 1e30;
+    for (int r = 0; r < repeats; r++)
+    {
+        const auto start = Clock::now();
+        BitUnpackWithIsa(isa, packed.data(), count, bits, unpacked.data());
+        const auto end = Clock::now();
+        bestUs = (std::min)(bestUs,
+                std::chrono::duration<double, std::micro>(end - start).count());
+    }
+    return bestUs;
+}
+
+int main(int argc, char* argv[])
+{
+    const size_t width = (argc > 1) ? (size_t)atol(argv[1]) : 2048;
+    const size_t height = (argc > 2) ? (size_t)atol(argv[2]) : 2048;
+    const size_t count = width * height;
+    constexpr int REPEATS = 20;
+
+    const std::vector<BitUnpackIsa> isas = GetSupportedIsas();
+    std::mt19937 rng(1);
+
+    bool ok = true;
+    for (const BitUnpackIsa isa : isas)
+    {
+        for (const unsigned bits : BITS_LIST)
+        {
+            ok &= (bits <= 16)
+                ? Verify<uint16_t>(isa, bits, rng)
+                : Verify<uint32_t>(isa, bits, rng);
+        }
+    }
+    printf("Verification %s\n\n", (ok) ? "passed" : "FAILED");
+
+    printf("Frame %zux%zu, best of %d runs\n\n", width, height, REPEATS);
+    printf("%-5s", "bits");
+    for (const BitUnpackIsa isa : isas)
+        printf(" | %-10s %7s %7s", IsaName(isa), "MPix/s", "speedup");
+    printf("\n");
+
+    for (const unsigned bits : BITS_LIST)
+    {
+        std::vector<uint32_t> pixels(count);
+        std::uniform_int_distribution<uint32_t> dist(0, (1u << bits) - 1);
+        for (uint32_t& pixel : pixels)
+            pixel = dist(rng);
+        const std::vector<uint8_t> packed = Pack(pixels, bits);
+        std::vector<uint16_t> unpacked16(count);
+        std::vector<uint32_t> unpacked32(count);
+
+        printf("%-5u", bits);
+        double scalarUs = 0;
+        for (const BitUnpackIsa isa : isas)
+        {
+            const double us = (bits <= 16)
+                ? Measure(isa, bits, packed, count, unpacked16, REPEATS)
+                : Measure(isa, bits, packed, count, unpacked32, REPEATS);
+            if (isa == BitUnpackIsa::Scalar)
+                scalarUs = us;
+            printf(" | %8.1fus %7.0f %6.2fx", us, count / us, scalarUs / us);
+        }
+        printf("\n");
+    }
+
+    return (ok) ? 0 : 1;
+}
@@ -0,0 +1,333 @@
+// Stress test of the EOF callback of the pvc module and its FrameRing.
+//
+// A fake PVCAM driver thread fills a circular acquisition buffer and invokes
+// the module's NewFrameHandler for a camera stand-in, with fake PVCAM functions
+// returning the latest frame. A consumer thread mimics get_frame: it waits on
+// the condition variable, pops under the mutex and then spends a few
+// microseconds outside of the lock like the Python object creation does.
+// The same scenario runs also with the legacy std::queue guarded by the mutex
+// that get_frame kept locked while building Python objects, for comparison.
+//
+// Build and run from the repository root, e.g. on Linux:
+//   g++ -std=c++14 -O2 -pthread -Ipvcam-sdk/linux/include -Isrc/pyvcam
+//       tests/native/frame_ring_stress.cpp -o frame_ring_stress
+//   ./frame_ring_stress [events_per_second] [duration_s]
+
+// PVCAM
+#include <master.h>
+#include <pvcam.h>
+
+// Local
+#include "frame_handler.h"
+#include "frame_ring.h"
+#include "frame_slots.h"
+#include "task_thread.h"
+
+// System
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+static constexpr uns32 BUFFER_FRAME_COUNT = 64;
+static constexpr uns32 FRAME_BYTES = 64;
+static constexpr auto CONSUMER_WORK = std::chrono::microseconds(3);
+static constexpr int16 HCAM = 3;
+
+struct Stats
+{
+    std::vector<uint32_t> latenciesNs{};
+    uint64_t produced{ 0 };
+    uint64_t consumed{ 0 };
+    uint64_t dropped{ 0 };
+    bool ordered{ true };
+};
+
+static void SpinFor(std::chrono::nanoseconds duration)
+{
+    const auto end = Clock::now() + duration;
+    while (Clock::now() < end)
+    {
+    }
+}
+
+/**
+ * Camera stand-in with the members NewFrameHandler uses, the same types as
+ * Camera in pvcmodule.cpp has. Live mode without pinning or streaming.
+ */
+struct FakeCamera
+{
+    std::mutex m_mutex{};
+    std::chrono::time_point<std::chrono::high_resolution_clock> m_fpsLastTime{
+        std::chrono::high_resolution_clock::now() };
+    std::atomic<double> m_fps{ 0.0 };
+    uns32 m_fpsFrameCnt{ 0 };
+    bool m_isSequence{ false };
+    uns32 m_seqTotal{ 0 };
+    uns32 m_seqSetupFrames{ 0 };
+    uns32 m_seqFrameBase{ 0 };
+    std::atomic<bool> m_seqRearm{ false };
+    std::chrono::high_resolution_clock::time_point m_seqLastEofTime{};
+    TaskThread m_seqRearmThread{};
+    std::chrono::high_resolution_clock::time_point m_seqSegmentEofTime{};
+    std::condition_variable m_acqCond{};
+    std::atomic<uns32> m_acqWaiters{ 0 };
+    FrameRing m_acqQueue{};
+    std::atomic<uns32> m_acqFrameCnt{ 0 };
+    std::string m_acqCbError{};
+    std::shared_ptr<FrameSlots> m_frameSlots{ std::make_shared<FrameSlots>() };
+    std::atomic<uint64_t> m_statQueueDropped{ 0 };
+    std::atomic<uint64_t> m_statFrameNrGaps{ 0 };
+    std::atomic<uint64_t> m_statFramesLost{ 0 };
+    std::atomic<uint64_t> m_statMaxQueueDepth{ 0 };
+    std::atomic<uint64_t> m_statCbErrors{ 0 };
+    std::atomic<uint64_t> m_statCycleTimeMaxUs{ 0 };
+    std::atomic<uint64_t> m_statCycleTimeTotalUs{ 0 };
+    uns32 m_lastFrameNr{ 0 };
+
+    bool StreamFrameToDisk(const Frame& /*frame*/, std::string& /*error*/)
+    {
+        return true; // Not streaming
+    }
+};
+
+// Frame the fake driver reports as the latest one, set before the callback
+static Frame g_latestFrame{};
+
+extern "C" rs_bool PV_DECL pl_exp_get_latest_frame_ex(int16 hcam, void** frame,
+        FRAME_INFO* frame_info)
+{
+    if (hcam != HCAM)
+        return PV_FAIL;
+    *frame = g_latestFrame.address;
+    frame_info->hCam = hcam;
+    frame_info->FrameNr = (int32)g_latestFrame.nr;
+    frame_info->TimeStamp = g_latestFrame.timeStamp;
+    frame_info->TimeStampBOF = g_latestFrame.timeStampBof;
+    return PV_OK;
+}
+
+// Called only by the frame slots, which are disabled without pinning
+extern "C" rs_bool PV_DECL pl_exp_get_oldest_frame_ex(int16 /*hcam*/, void** /*frame*/,
+        FRAME_INFO* /*frame_info*/)
+{
+    return PV_FAIL;
+}
+
+extern "C" rs_bool PV_DECL pl_exp_unlock_oldest_frame(int16 /*hcam*/)
+{
+    return PV_FAIL;
+}
+
+extern "C" int16 PV_DECL pl_error_code(void)
+{
+    return 0;
+}
+
+extern "C" rs_bool PV_DECL pl_error_message(int16 /*err_code*/, char* msg)
+{
+    msg[0] = '\0';
+    return PV_OK;
+}
+
+/** Fake PVCAM: calls the EOF handler for every frame at given rate. */
+template<typename Handler>
+static void FakeDriver(double eventsPerSec, double durationSec, uint8_t* buffer,
+        std::vector<uint32_t>& latenciesNs, Handler handler)
+{
+    const auto period = std::chrono::nanoseconds((int64_t)(1e9 / eventsPerSec));
+    const auto start = Clock::now();
+    const auto end = start + std::chrono::nanoseconds((int64_t)(durationSec * 1e9));
+    auto next = start;
+    uns32 frameNr = 0;
+    while (next < end)
+    {
+        while (Clock::now() < next)
+        {
+        }
+        next += period;
+
+        Frame frame;
+        frame.address = buffer + (size_t)(frameNr % BUFFER_FRAME_COUNT) * FRAME_BYTES;
+        frame.nr = ++frameNr;
+        frame.count = frameNr;
+
+        const auto t0 = Clock::now();
+        handler(frame);
+        const auto t1 = Clock::now();
+        latenciesNs.push_back((uint32_t)
+                std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count());
+    }
+}
+
+static Stats RunFrameRing(double eventsPerSec, double durationSec, uint8_t* buffer)
+{
+    FakeCamera cam;
+    cam.m_acqQueue.Reset(BUFFER_FRAME_COUNT);
+    std::atomic<bool> done{ false };
+
+    Stats stats;
+    std::thread consumer([&]() {
+        uns32 lastNr = 0;
+        std::unique_lock<std::mutex> lock(cam.m_mutex);
+        for (;;)
+        {
+            // Same waiting as PopQueuedFrameNoGil in pvcmodule.cpp
+            Frame frame;
+            bool popped;
+            cam.m_acqWaiters++;
+            while (!(popped = cam.m_acqQueue.PopOldest(frame)) && !done)
+                cam.m_acqCond.wait_for(lock, std::chrono::milliseconds(10));
+            cam.m_acqWaiters--;
+            if (!popped)
+                break;
+            lock.unlock();
+            if (frame.nr <= lastNr)
+                stats.ordered = false;
+            lastNr = frame.nr;
+            stats.consumed++;
+            SpinFor(CONSUMER_WORK); // Python objects creation
+            lock.lock();
+        }
+    });
+
+    FakeDriver(eventsPerSec, durationSec, buffer, stats.latenciesNs,
+        [&](const Frame& frame) {
+            g_latestFrame = frame;
+            FRAME_INFO fi{};
+            fi.hCam = HCAM;
+            fi.FrameNr = (int32)frame.nr;
+            NewFrameHandler<FakeCamera>(&fi, &cam);
+        });
+
+    {
+        std::lock_guard<std::mutex> lock(cam.m_mutex);
+        done = true;
+    }
+    cam.m_acqCond.notify_all();
+    consumer.join();
+
+    stats.produced = stats.latenciesNs.size();
+    stats.dropped = cam.m_statQueueDropped;
+    if (cam.m_statCbErrors > 0 || cam.m_statFramesLost > 0)
+    {
+        printf("FrameRing    FAILED: callback errors or frames lost\n");
+        stats.ordered = false;
+    }
+    return stats;
+}
+
+static Stats RunLegacyQueue(double eventsPerSec, double durationSec, uint8_t* buffer)
+{
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::queue<Frame> queue;
+    bool done = false;
+
+    Stats stats;
+    std::thread consumer([&]() {
+        uns32 lastNr = 0;
+        std::unique_lock<std::mutex> lock(mutex);
+        for (;;)
+        {
+            cond.wait_for(lock, std::chrono::milliseconds(10),
+                    [&]() { return !queue.empty() || done; });
+            if (queue.empty())
+            {
+                if (done)
+                    break;
+                continue;
+            }
+            const Frame frame = queue.front();
+            queue.pop();
+            if (frame.nr <= lastNr)
+                stats.ordered = false;
+            lastNr = frame.nr;
+            stats.consumed++;
+            SpinFor(CONSUMER_WORK); // Python objects creation with the lock held
+        }
+    });
+
+    FakeDriver(eventsPerSec, durationSec, buffer, stats.latenciesNs,
+        [&](const Frame& frame) {
+            std::lock_guard<std::mutex> lock(mutex);
+            while (queue.size() >= BUFFER_FRAME_COUNT)
+            {
+                queue.pop();
+                stats.dropped++;
+            }
+            queue.push(frame);
+            cond.notify_all();
+        });
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        done = true;
+    }
+    cond.notify_all();
+    consumer.join();
+
+    stats.produced = stats.latenciesNs.size();
+    return stats;
+}
+
+static uint32_t Percentile(std::vector<uint32_t> values, double pct)
+{
+    if (values.empty())
+        return 0;
+    const size_t index = (size_t)(pct / 100.0 * (double)(values.size() - 1));
+    std::nth_element(values.begin(), values.begin() + index, values.end());
+    return values[index];
+}
+
+static bool Report(const char* name, const Stats& stats, double durationSec)
+{
+    printf("%-12s events: %llu (%.0f/s), consumed: %llu, dropped: %llu\n", name,
+            (unsigned long long)stats.produced, stats.produced / durationSec,
+            (unsigned long long)stats.consumed, (unsigned long long)stats.dropped);
+    printf("%-12s enqueue latency p50: %u ns, p99: %u ns, p99.9: %u ns, max: %u ns\n", name,
+            Percentile(stats.latenciesNs, 50.0),
+            Percentile(stats.latenciesNs, 99.0),
+            Percentile(stats.latenciesNs, 99.9),
+            Percentile(stats.latenciesNs, 100.0));
+
+    bool ok = true;
+    if (stats.consumed + stats.dropped != stats.produced)
+    {
+        printf("%-12s FAILED: consumed + dropped != events\n", name);
+        ok = false;
+    }
+    if (!stats.ordered)
+    {
+        printf("%-12s FAILED: frames consumed out of order\n", name);
+        ok = false;
+    }
+    return ok;
+}
+
+int main(int argc, char* argv[])
+{
+    const double eventsPerSec = (argc > 1) ? atof(argv[1]) : 200000.0;
+    const double durationSec = (argc > 2) ? atof(argv[2]) : 2.0;
+
+    std::vector<uint8_t> buffer((size_t)BUFFER_FRAME_COUNT * FRAME_BYTES);
+
+    const Stats ringStats = RunFrameRing(eventsPerSec, durationSec, buffer.data());
+    const Stats legacyStats = RunLegacyQueue(eventsPerSec, durationSec, buffer.data());
+
+    bool ok = Report("FrameRing", ringStats, durationSec);
+    ok = Report("std::queue", legacyStats, durationSec) && ok;
+
+    return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
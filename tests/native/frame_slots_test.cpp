@@ -0,0 +1,307 @@
+// Test of the FrameSlots pinning used by the pvc module in live mode.
+//
+// A fake PVCAM driver in CIRC_NO_OVERWRITE mode writes frames into the next
+// slot of the circular buffer if PVCAM has it unlocked, otherwise it discards
+// the frame. Every frame is filled with its frame count, so the test can tell
+// whether a pinned frame stayed intact. Checked scenarios:
+//  - a short pin keeps the frame in its slot,
+//  - a pin held for long without exports gets copied out by the worker thread
+//    instead of stalling the acquisition,
+//  - an exported frame stays in its slot over laps, PVCAM discards new frames
+//    meanwhile and they are counted, the frame is copied out once the export
+//    is released while the pin is still held,
+//  - pins released after the camera was closed never call PVCAM.
+//
+// Build and run from the repository root, e.g. on Linux:
+//   g++ -std=c++14 -O2 -pthread -Ipvcam-sdk/linux/include -Isrc/pyvcam
+//       tests/native/frame_slots_test.cpp -o frame_slots_test
+//   ./frame_slots_test
+
+// PVCAM
+#include <master.h>
+#include <pvcam.h>
+
+// Local
+#include "frame_slots.h"
+
+// System
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+static constexpr int16 HCAM = 7;
+static constexpr uns32 SLOT_COUNT = 8;
+static constexpr uns32 FRAME_BYTES = 256;
+
+/**
+ * Fake PVCAM acquisition, the exported functions below operate on it. These
+ * are called also by the worker thread of FrameSlots.
+ */
+struct FakeDriver
+{
+    std::mutex mutex{};
+    std::vector<uint8_t> buffer = std::vector<uint8_t>(SLOT_COUNT * FRAME_BYTES);
+    std::vector<bool> locked = std::vector<bool>(SLOT_COUNT, false);
+    std::deque<uns32> lockedOrder{};
+    uns32 nextSlot{ 0 };
+    uns32 frameCount{ 0 }; // Also the frame number, counts discarded frames too
+    uns32 callbackCount{ 0 };
+    uint64_t discarded{ 0 };
+    uint64_t calls{ 0 }; // Calls of exported PVCAM functions
+
+    void Clear()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        std::fill(buffer.begin(), buffer.end(), (uint8_t)0);
+        std::fill(locked.begin(), locked.end(), false);
+        lockedOrder.clear();
+        nextSlot = 0;
+        frameCount = 0;
+        callbackCount = 0;
+        discarded = 0;
+        calls = 0;
+    }
+
+    uint8_t* Slot(uns32 slot)
+    {
+        return buffer.data() + (size_t)slot * FRAME_BYTES;
+    }
+
+    /** Acquires one frame, returns false if there was no free slot. */
+    bool Acquire(FrameSlots& slots)
+    {
+        uns32 slot;
+        uns32 frameNr;
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            frameNr = ++frameCount;
+            if (locked[nextSlot])
+            {
+                discarded++;
+                return false;
+            }
+            slot = nextSlot;
+            memset(Slot(slot), (int)(frameNr & 0xFF), FRAME_BYTES);
+            locked[slot] = true;
+            lockedOrder.push_back(slot);
+            nextSlot = (nextSlot + 1) % SLOT_COUNT;
+        }
+        // The callback, without the driver lock
+        return slots.OnNewFrame(Slot(slot), ++callbackCount, frameNr);
+    }
+
+    uint64_t GetDiscarded()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return discarded;
+    }
+
+    uint64_t GetCalls()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return calls;
+    }
+};
+
+static FakeDriver g_driver;
+
+extern "C" rs_bool PV_DECL pl_exp_get_oldest_frame_ex(int16 hcam, void** frame,
+        FRAME_INFO* frame_info)
+{
+    std::lock_guard<std::mutex> lock(g_driver.mutex);
+    g_driver.calls++;
+    if (hcam != HCAM || g_driver.lockedOrder.empty())
+        return PV_FAIL;
+    *frame = g_driver.Slot(g_driver.lockedOrder.front());
+    (void)frame_info;
+    return PV_OK;
+}
+
+extern "C" rs_bool PV_DECL pl_exp_unlock_oldest_frame(int16 hcam)
+{
+    std::lock_guard<std::mutex> lock(g_driver.mutex);
+    g_driver.calls++;
+    if (hcam != HCAM || g_driver.lockedOrder.empty())
+        return PV_FAIL;
+    g_driver.locked[g_driver.lockedOrder.front()] = false;
+    g_driver.lockedOrder.pop_front();
+    return PV_OK;
+}
+
+static bool g_ok = true;
+
+static void Check(bool condition, const char* what)
+{
+    if (!condition)
+    {
+        printf("FAILED: %s\n", what);
+        g_ok = false;
+    }
+}
+
+static bool IsFilledWith(const void* data, uint8_t value)
+{
+    const auto* bytes = static_cast<const uint8_t*>(data);
+    for (uns32 n = 0; n < FRAME_BYTES; n++)
+        if (bytes[n] != value)
+            return false;
+    return true;
+}
+
+/** Waits until the worker thread copied out given number of frames in total. */
+static bool WaitForForcedCopies(FrameSlots& slots, uint64_t count)
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (slots.GetStats().forcedCopies < count)
+    {
+        if (std::chrono::steady_clock::now() > deadline)
+            return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+static std::shared_ptr<FrameSlots> Setup()
+{
+    g_driver.Clear();
+    auto slots = std::make_shared<FrameSlots>();
+    slots->Reset(HCAM, g_driver.buffer.data(), FRAME_BYTES, SLOT_COUNT, true);
+    return slots;
+}
+
+static void TestShortPin()
+{
+    auto slots = Setup();
+    Check(slots->GetMaxLocked() == SLOT_COUNT - FRAME_SLOTS_SPARE, "max. locked slots");
+    g_driver.Acquire(*slots);
+    void* address = g_driver.Slot(0);
+    std::shared_ptr<FrameSlotPin> pin = slots->Pin(address, 1);
+    Check(pin != nullptr, "short pin: frame pinned");
+    Check(slots->Pin(address, 1) == pin, "short pin: pin shared");
+    Check(!slots->Pin(address, 2), "short pin: wrong frame count rejected");
+
+    // Fill the slots up to the limit, the pinned frame stays in place
+    for (uns32 n = 1; n < slots->GetMaxLocked(); n++)
+        Check(g_driver.Acquire(*slots), "short pin: frame acquired");
+    Check(pin->Resolve(address) == address, "short pin: frame not copied");
+    Check(IsFilledWith(address, 1), "short pin: frame intact");
+    Check(slots->GetStats().forcedCopies == 0, "short pin: no forced copy");
+    Check(slots->GetStats().pinnedSlots == 1, "short pin: one slot pinned");
+
+    // Takes a spare slot
+    Check(g_driver.Acquire(*slots), "short pin: spare slot taken");
+    pin.reset();
+    const FrameSlots::Stats stats = slots->GetStats();
+    Check(stats.pinnedSlots == 0, "short pin: slot released");
+    Check(stats.lockedSlots == slots->GetMaxLocked(), "short pin: excess frames unlocked");
+    Check(!slots->HasPins(), "short pin: no live pins");
+    Check(stats.unlockErrors == 0, "short pin: no unlock errors");
+    slots->Close();
+}
+
+static void TestLongPin()
+{
+    auto slots = Setup();
+    g_driver.Acquire(*slots);
+    void* address = g_driver.Slot(0);
+    std::shared_ptr<FrameSlotPin> pin = slots->Pin(address, 1);
+    Check(pin != nullptr, "long pin: frame pinned");
+
+    // Up to the first spare slot, the worker thread copies the frame out then
+    for (uns32 n = 1; n <= slots->GetMaxLocked(); n++)
+        g_driver.Acquire(*slots);
+    Check(WaitForForcedCopies(*slots, 1), "long pin: frame copied out");
+
+    // Several laps over the buffer, the pinned frame must not stall them
+    for (uns32 n = 0; n < 3 * SLOT_COUNT; n++)
+        g_driver.Acquire(*slots);
+    Check(g_driver.GetDiscarded() == 0, "long pin: no frames discarded");
+    Check(slots->GetStats().forcedCopies == 1, "long pin: one forced copy");
+    Check(pin->Resolve(address) != address, "long pin: pointer resolved to copy");
+    Check(IsFilledWith(pin->Resolve(address), 1), "long pin: copy intact");
+    Check(!IsFilledWith(address, 1), "long pin: slot reused");
+    Check(!slots->Pin(address, 1), "long pin: frame copied out can't be pinned again");
+
+    // Exports taken after the copy use it
+    {
+        const FrameSlotExport frameExport(pin);
+        Check(frameExport.Resolve(address) == pin->Resolve(address), "long pin: export of copy");
+    }
+
+    pin.reset();
+    const FrameSlots::Stats stats = slots->GetStats();
+    Check(stats.pinnedSlots == 0, "long pin: no slots pinned");
+    Check(!slots->HasPins(), "long pin: no live pins");
+    Check(stats.unlockErrors == 0, "long pin: no unlock errors");
+    slots->Close();
+}
+
+static void TestExportedPin()
+{
+    auto slots = Setup();
+    g_driver.Acquire(*slots);
+    void* address = g_driver.Slot(0);
+    std::shared_ptr<FrameSlotPin> pin = slots->Pin(address, 1);
+    Check(pin != nullptr, "export: frame pinned");
+    auto frameExport = std::make_shared<FrameSlotExport>(pin);
+    const void* data = frameExport->Resolve(address);
+    Check(data == address, "export: pointer to the slot");
+
+    // A full lap and more, the exported frame is never copied out or overwritten
+    for (uns32 n = 1; n < 2 * SLOT_COUNT; n++)
+        g_driver.Acquire(*slots);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20)); // Worker must not copy
+    Check(slots->GetStats().forcedCopies == 0, "export: no forced copy");
+    Check(pin->Resolve(address) == address, "export: frame stays in its slot");
+    Check(IsFilledWith(data, 1), "export: frame intact");
+    const uint64_t discarded = g_driver.GetDiscarded();
+    Check(discarded == SLOT_COUNT, "export: frames discarded with all slots locked");
+
+    // With the pin still held, the frame is copied out once the export is gone
+    frameExport.reset();
+    Check(WaitForForcedCopies(*slots, 1), "export: copied out after release");
+    Check(IsFilledWith(pin->Resolve(address), 1), "export: copy intact");
+    Check(g_driver.Acquire(*slots), "export: acquisition goes on");
+    Check(slots->GetStats().droppedFrames == discarded, "export: dropped frames counted");
+
+    pin.reset();
+    Check(slots->GetStats().unlockErrors == 0, "export: no unlock errors");
+    Check(!slots->HasPins(), "export: no live pins");
+    slots->Close();
+}
+
+static void TestPinAfterClose()
+{
+    auto slots = Setup();
+    g_driver.Acquire(*slots);
+    std::shared_ptr<FrameSlotPin> pin = slots->Pin(g_driver.Slot(0), 1);
+    Check(pin != nullptr, "close: frame pinned");
+    for (uns32 n = 1; n < SLOT_COUNT - 1; n++)
+        g_driver.Acquire(*slots);
+    auto frameExport = std::make_shared<FrameSlotExport>(pin); // Kept from copying out
+
+    slots->Close();
+    const uint64_t calls = g_driver.GetCalls();
+    frameExport.reset();
+    pin.reset(); // Would unlock the excess frames if the camera was open
+    Check(g_driver.GetCalls() == calls, "close: no PVCAM calls after close");
+    Check(!slots->HasPins(), "close: no live pins");
+    Check(!slots->Pin(g_driver.Slot(1), 2), "close: no pins after close");
+}
+
+int main()
+{
+    TestShortPin();
+    TestLongPin();
+    TestExportedPin();
+    TestPinAfterClose();
+    printf("%s\n", g_ok ? "All tests passed" : "Some tests FAILED");
+    return g_ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,215 @@
+// Test of the io_uring stream-to-disk backend used by the pvc module on Linux.
+//
+// IoUringWriter is checked directly first. Writes are submitted up to the ring
+// depth at file offsets out of order, each must complete once with its tag
+// and land at its offset. Then StreamWriter streams segments larger than one
+// io_uring write and non-contiguous in the buffer, the file must hold them back
+// to back from the data offset and all bytes must be accounted. Finally writes
+// to a read-only file must be reported as failed while the queue still drains.
+//
+// If the kernel or seccomp doesn't allow io_uring, the IoUringWriter checks are
+// skipped and the StreamWriter checks run with its fallback backend.
+//
+// Build and run from the repository root on Linux:
+//   g++ -std=c++14 -O2 -pthread -Ipvcam-sdk/linux/include -Isrc/pyvcam
+//       tests/native/io_uring_writer_test.cpp -o io_uring_writer_test
+//   ./io_uring_writer_test
+
+// PVCAM
+#include <master.h>
+
+// Local
+#include "acq_buffer.h"
+#include "io_uring_writer.h"
+#include "stream_writer.h"
+
+// System
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <fcntl.h> // open
+#include <unistd.h> // pread, lseek, close, unlink
+
+static constexpr uns32 PAGE_BYTES = (uns32)ALIGNMENT_BOUNDARY;
+// Segments span several io_uring writes
+static constexpr uns32 SEGMENT_BYTES = STREAM_URING_CHUNK + STREAM_URING_CHUNK / 2;
+static constexpr uns32 SEGMENT_COUNT = 6;
+// Every other segment, so no segment is contiguous with the previous one
+static constexpr uns32 BUFFER_BYTES = 2 * SEGMENT_COUNT * SEGMENT_BYTES;
+static constexpr uint64_t DATA_OFFSET = PAGE_BYTES; // Room for a file header
+
+static bool g_ok = true;
+
+static void Check(bool condition, const char* what)
+{
+    if (!condition)
+    {
+        printf("FAILED: %s\n", what);
+        g_ok = false;
+    }
+}
+
+/** Fills every page with a value unique within 256 pages. */
+static std::shared_ptr<AcqBuffer> NewFilledBuffer()
+{
+    auto acqBuffer = std::make_shared<AcqBuffer>((size_t)BUFFER_BYTES);
+    auto* bytes = static_cast<uint8_t*>(acqBuffer->data);
+    for (uns32 page = 0; page < BUFFER_BYTES / PAGE_BYTES; page++)
+        memset(bytes + (size_t)page * PAGE_BYTES, (int)(page & 0xFF), PAGE_BYTES);
+    return acqBuffer;
+}
+
+/** Creates an empty temporary file, returns its path. */
+static std::string NewTempFile()
+{
+    char path[] = "/tmp/io_uring_writer_test_XXXXXX";
+    const int fd = mkstemp(path);
+    if (fd < 0)
+        return std::string();
+    close(fd);
+    return path;
+}
+
+static bool FileHolds(int fd, uint64_t fileOffset, const void* data, size_t bytes)
+{
+    std::vector<uint8_t> read(bytes);
+    if (pread(fd, read.data(), bytes, (off_t)fileOffset) != (ssize_t)bytes)
+        return false;
+    return memcmp(read.data(), data, bytes) == 0;
+}
+
+#ifdef PYVCAM_HAS_IO_URING
+static void TestIoUringWriter()
+{
+    const std::string path = NewTempFile();
+    const int fd = open(path.c_str(), O_RDWR);
+    Check(fd >= 0, "uring: file opened");
+    if (fd < 0)
+        return;
+    auto acqBuffer = NewFilledBuffer();
+    const auto* bytes = static_cast<const uint8_t*>(acqBuffer->data);
+
+    IoUringWriter uring;
+    if (!uring.Open(fd, acqBuffer->data, acqBuffer->paddedSize, STREAM_URING_DEPTH))
+    {
+        printf("io_uring not available, IoUringWriter checks skipped\n");
+        close(fd);
+        unlink(path.c_str());
+        return;
+    }
+    printf("io_uring available, buffer %sregistered\n",
+            (uring.IsBufferRegistered()) ? "" : "not ");
+    Check(uring.Depth() >= STREAM_URING_DEPTH, "uring: depth");
+
+    // Page n of the buffer goes to page (depth - 1 - n) of the file
+    const unsigned depth = uring.Depth();
+    for (unsigned n = 0; n < depth; n++)
+    {
+        Check(uring.Submit(bytes + (size_t)n * PAGE_BYTES, PAGE_BYTES,
+                    (uint64_t)(depth - 1 - n) * PAGE_BYTES, 100 + n),
+                "uring: write submitted");
+    }
+    Check(uring.InFlight() == depth, "uring: all writes in flight");
+    Check(!uring.Submit(bytes, PAGE_BYTES, 0, 0), "uring: no submit beyond depth");
+
+    std::vector<unsigned> completions(depth, 0);
+    bool resultsOk = true;
+    Check(uring.Reap(depth, [&](uint64_t tag, int32_t res) {
+        if (tag >= 100 && tag < 100 + depth)
+            completions[tag - 100]++;
+        resultsOk &= res == (int32_t)PAGE_BYTES;
+    }), "uring: writes reaped");
+    Check(uring.InFlight() == 0, "uring: nothing in flight");
+    Check(resultsOk, "uring: all bytes written");
+    bool tagsOk = true;
+    bool dataOk = true;
+    for (unsigned n = 0; n < depth; n++)
+    {
+        tagsOk &= completions[n] == 1;
+        dataOk &= FileHolds(fd, (uint64_t)(depth - 1 - n) * PAGE_BYTES,
+                bytes + (size_t)n * PAGE_BYTES, PAGE_BYTES);
+    }
+    Check(tagsOk, "uring: every tag completed once");
+    Check(dataOk, "uring: data at their offsets");
+
+    uring.Close();
+    close(fd);
+    unlink(path.c_str());
+}
+#endif
+
+static void TestStreamWriter()
+{
+    const std::string path = NewTempFile();
+    const int fd = open(path.c_str(), O_RDWR);
+    Check(fd >= 0, "stream: file opened");
+    if (fd < 0)
+        return;
+    auto acqBuffer = NewFilledBuffer();
+    const auto* bytes = static_cast<const uint8_t*>(acqBuffer->data);
+
+    // The synchronous backend writes at the file position
+    lseek(fd, (off_t)DATA_OFFSET, SEEK_SET);
+    StreamWriter writer;
+    Check(writer.Start(fd, acqBuffer, DATA_OFFSET, true), "stream: writer started");
+    printf("StreamWriter backend: %s\n", writer.GetBackend());
+    for (uns32 n = 0; n < SEGMENT_COUNT; n++)
+        writer.Queue({ 2 * n * SEGMENT_BYTES, SEGMENT_BYTES });
+    writer.Stop();
+
+    Check(!writer.HasFailed(), "stream: no write error");
+    Check(writer.GetWrittenBytes() == (uint64_t)SEGMENT_COUNT * SEGMENT_BYTES,
+            "stream: all bytes accounted");
+    bool dataOk = true;
+    for (uns32 n = 0; n < SEGMENT_COUNT; n++)
+    {
+        dataOk &= FileHolds(fd, DATA_OFFSET + (uint64_t)n * SEGMENT_BYTES,
+                bytes + (size_t)2 * n * SEGMENT_BYTES, SEGMENT_BYTES);
+    }
+    Check(dataOk, "stream: segments back to back from the data offset");
+
+    close(fd);
+    unlink(path.c_str());
+}
+
+static void TestStreamWriterError()
+{
+    const std::string path = NewTempFile();
+    const int fd = open(path.c_str(), O_RDONLY); // Every write fails with EBADF
+    Check(fd >= 0, "stream error: file opened");
+    if (fd < 0)
+        return;
+    auto acqBuffer = NewFilledBuffer();
+
+    StreamWriter writer;
+    Check(writer.Start(fd, acqBuffer, 0, true), "stream error: writer started");
+    for (uns32 n = 0; n < SEGMENT_COUNT; n++)
+        writer.Queue({ 2 * n * SEGMENT_BYTES, SEGMENT_BYTES });
+    writer.Stop();
+
+    Check(writer.HasFailed(), "stream error: failure reported");
+    Check(!writer.GetError().empty(), "stream error: message set");
+    Check(writer.GetWrittenBytes() == (uint64_t)SEGMENT_COUNT * SEGMENT_BYTES,
+            "stream error: queue drained");
+
+    close(fd);
+    unlink(path.c_str());
+}
+
+int main()
+{
+#ifdef PYVCAM_HAS_IO_URING
+    TestIoUringWriter();
+#else
+    printf("Built without io_uring, IoUringWriter checks skipped\n");
+#endif
+    TestStreamWriter();
+    TestStreamWriterError();
+    printf("%s\n", g_ok ? "All tests passed" : "Some tests FAILED");
+    return g_ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
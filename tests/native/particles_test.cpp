@@ -0,0 +1,230 @@
+// Test of the particle decoding used by the pvc module for frame metadata in
+// centroids modes.
+//
+// A fake pl_md_read_extended decodes extended metadata of a ROI from a simple
+// synthetic layout, a tag byte followed by its value of the size given in the
+// tag info, like the real format does. Values are stored unaligned. Checked:
+//  - particle tags land in their columns in the row of their ROI,
+//  - 8, 16, 32 and 64-bit integer values are converted to 32 bits,
+//  - unknown tags are ignored and non-integer particle tags leave the ROI invalid,
+//  - ROIs without extended metadata stay zero and invalid,
+//  - a PVCAM failure is reported.
+//
+// Build and run from the repository root, e.g. on Linux:
+//   g++ -std=c++14 -O2 -pthread -Ipvcam-sdk/linux/include -Isrc/pyvcam
+//       tests/native/particles_test.cpp -o particles_test
+//   ./particles_test
+
+// PVCAM
+#include <master.h>
+#include <pvcam.h>
+
+// Local
+#include "particles.h"
+
+// System
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+// Stands for a tag added by newer PVCAM, the only one in range of the enum
+static constexpr uns8 TAG_UNKNOWN = PL_MD_EXT_TAG_MAX;
+static constexpr uns8 TAG_INVALID = 0xFF; // Makes the fake decoding fail
+
+static md_ext_item_info g_idInfo{ PL_MD_EXT_TAG_PARTICLE_ID, TYPE_UNS32, 4, "ID" };
+static md_ext_item_info g_m0Info{ PL_MD_EXT_TAG_PARTICLE_M0, TYPE_UNS64, 8, "M0" };
+static md_ext_item_info g_m2Info{ PL_MD_EXT_TAG_PARTICLE_M2, TYPE_UNS16, 2, "M2" };
+static md_ext_item_info g_unknownInfo{ PL_MD_EXT_TAG_MAX, TYPE_UNS8, 1, "Unknown" };
+
+static bool g_ok = true;
+
+static void Check(bool condition, const char* what)
+{
+    if (!condition)
+    {
+        printf("FAILED: %s\n", what);
+        g_ok = false;
+    }
+}
+
+static const md_ext_item_info* FindTagInfo(uns8 tag)
+{
+    switch (tag)
+    {
+    case PL_MD_EXT_TAG_PARTICLE_ID: return &g_idInfo;
+    case PL_MD_EXT_TAG_PARTICLE_M0: return &g_m0Info;
+    case PL_MD_EXT_TAG_PARTICLE_M2: return &g_m2Info;
+    case TAG_UNKNOWN: return &g_unknownInfo;
+    default: return nullptr;
+    }
+}
+
+extern "C" rs_bool PV_DECL pl_md_read_extended(md_ext_item_collection* pOutput,
+        void* pExtMdPtr, uns32 extMdSize)
+{
+    auto* bytes = static_cast<uns8*>(pExtMdPtr);
+    pOutput->count = 0;
+    uns32 pos = 0;
+    while (pos < extMdSize)
+    {
+        const md_ext_item_info* info = FindTagInfo(bytes[pos]);
+        if (!info || pos + 1 + info->size > extMdSize
+                || pOutput->count == PL_MD_EXT_TAGS_MAX_SUPPORTED)
+            return PV_FAIL;
+        pOutput->list[pOutput->count].tagInfo = info;
+        pOutput->list[pOutput->count].value = bytes + pos + 1;
+        pOutput->count++;
+        pos += 1 + info->size;
+    }
+    return PV_OK;
+}
+
+/** Extended metadata of one ROI in the fake layout. */
+struct ExtMd
+{
+    std::vector<uns8> bytes;
+
+    ExtMd& Add(uns8 tag, uint64_t value, uns16 size)
+    {
+        bytes.push_back(tag);
+        for (uns16 n = 0; n < size; n++)
+            bytes.push_back((uns8)(value >> (8 * n))); // Little-endian
+        return *this;
+    }
+};
+
+/** Decoded frame with ROIs pointing to given extended metadata, empty for none. */
+struct FakeFrame
+{
+    md_frame_header header{};
+    std::vector<md_frame_roi> rois;
+    md_frame frame{};
+
+    explicit FakeFrame(std::vector<ExtMd>& extMds)
+        : rois(extMds.size())
+    {
+        for (size_t i = 0; i < extMds.size(); i++)
+        {
+            rois[i] = md_frame_roi{};
+            if (!extMds[i].bytes.empty())
+            {
+                rois[i].extMdData = extMds[i].bytes.data();
+                rois[i].extMdDataSize = (uns16)extMds[i].bytes.size();
+            }
+        }
+        header.roiCount = (uns16)rois.size();
+        frame.header = &header;
+        frame.roiArray = rois.data();
+        frame.roiCapacity = (uns16)rois.size();
+        frame.roiCount = (uns16)rois.size();
+    }
+};
+
+/** Columns with a row per ROI, zeroed as the module does. */
+struct Columns
+{
+    std::vector<uns32> ids, m0, m2;
+    std::vector<uns8> valid;
+    ParticleColumns columns;
+
+    explicit Columns(size_t rows)
+        : ids(rows, 0), m0(rows, 0), m2(rows, 0), valid(rows, 0)
+    {
+        columns.ids = ids.data();
+        columns.m0 = m0.data();
+        columns.m2 = m2.data();
+        columns.valid = valid.data();
+    }
+};
+
+static void TestDecode()
+{
+    std::vector<ExtMd> extMds(4);
+    extMds[0].Add(PL_MD_EXT_TAG_PARTICLE_ID, 7, 4)
+        .Add(PL_MD_EXT_TAG_PARTICLE_M0, 0x123456789ULL, 8) // Truncated to 32 bits
+        .Add(PL_MD_EXT_TAG_PARTICLE_M2, 0xBEEF, 2);
+    // extMds[1] stays empty, a ROI without extended metadata
+    extMds[2].Add(TAG_UNKNOWN, 0xAA, 1) // Shifts the next values off alignment
+        .Add(PL_MD_EXT_TAG_PARTICLE_M2, 3, 2)
+        .Add(PL_MD_EXT_TAG_PARTICLE_ID, 0xFFFFFFFF, 4);
+    extMds[3].Add(TAG_UNKNOWN, 1, 1);
+    FakeFrame frame(extMds);
+    Columns columns(extMds.size());
+
+    Check(HasParticleExtMd(&frame.frame), "decode: extended metadata found");
+    Check(DecodeParticles(&frame.frame, columns.columns), "decode: success");
+
+    Check(columns.ids[0] == 7 && columns.m0[0] == 0x23456789 && columns.m2[0] == 0xBEEF,
+            "decode: all tags of first ROI");
+    Check(columns.valid[0] != 0, "decode: first ROI valid");
+    Check(columns.ids[1] == 0 && columns.m0[1] == 0 && columns.m2[1] == 0
+            && columns.valid[1] == 0, "decode: ROI without extended metadata");
+    Check(columns.ids[2] == 0xFFFFFFFF && columns.m0[2] == 0 && columns.m2[2] == 3,
+            "decode: unaligned values after unknown tag");
+    Check(columns.valid[2] != 0, "decode: third ROI valid");
+    Check(columns.valid[3] == 0, "decode: ROI with unknown tag only invalid");
+}
+
+static void TestTypes()
+{
+    const struct { uns16 type; uns16 size; uint64_t value; uns32 expected; } cases[] = {
+        { TYPE_UNS8, 1, 0xAB, 0xAB },
+        { TYPE_INT16, 2, 0x8001, 0x8001 },
+        { TYPE_ENUM, 4, 0x01020304, 0x01020304 },
+        { TYPE_INT64, 8, 0xFFFFFFFF00000005ULL, 5 },
+    };
+    bool typesOk = true;
+    for (const auto& c : cases)
+    {
+        g_idInfo.type = c.type;
+        g_idInfo.size = c.size;
+        std::vector<ExtMd> extMds(1);
+        extMds[0].Add(PL_MD_EXT_TAG_PARTICLE_ID, c.value, c.size);
+        FakeFrame frame(extMds);
+        Columns columns(1);
+        typesOk &= DecodeParticles(&frame.frame, columns.columns)
+            && columns.ids[0] == c.expected && columns.valid[0] != 0;
+    }
+    Check(typesOk, "types: integers converted to 32 bits");
+
+    g_idInfo.type = TYPE_FLT64;
+    g_idInfo.size = 8;
+    std::vector<ExtMd> extMds(1);
+    extMds[0].Add(PL_MD_EXT_TAG_PARTICLE_ID, 1, 8);
+    FakeFrame frame(extMds);
+    Columns columns(1);
+    Check(DecodeParticles(&frame.frame, columns.columns), "types: float tag decoded");
+    Check(columns.ids[0] == 0 && columns.valid[0] == 0, "types: float tag ignored");
+
+    g_idInfo.type = TYPE_UNS32;
+    g_idInfo.size = 4;
+}
+
+static void TestNoExtMd()
+{
+    std::vector<ExtMd> extMds(3);
+    FakeFrame frame(extMds);
+    Check(!HasParticleExtMd(&frame.frame), "no ext md: none found");
+}
+
+static void TestFailure()
+{
+    std::vector<ExtMd> extMds(2);
+    extMds[0].Add(PL_MD_EXT_TAG_PARTICLE_ID, 1, 4);
+    extMds[1].Add(TAG_INVALID, 0, 0);
+    FakeFrame frame(extMds);
+    Columns columns(extMds.size());
+    Check(!DecodeParticles(&frame.frame, columns.columns), "failure: reported");
+}
+
+int main()
+{
+    TestDecode();
+    TestTypes();
+    TestNoExtMd();
+    TestFailure();
+    printf("%s\n", g_ok ? "All tests passed" : "Some tests FAILED");
+    return g_ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
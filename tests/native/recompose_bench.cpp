@@ -0,0 +1,241 @@
+// Verification and benchmark of multi-ROI frame recomposition used by the pvc module.
+//
+// Centroid-like ROIs are placed at random positions of a sensor-sized canvas,
+// some of them overlapping each other or the canvas border. The parallel
+// recomposition is compared with a naive serial reference for raw pixels and
+// for bit-packed pixels. Then the time of one serial band over the whole canvas
+// is compared with the recomposition using 2, 4 and 8 threads and with the
+// thread count chosen by RecomposeFrame, for the given canvas and for smaller
+// ones down to 256x256. The speedup tells whether RECOMPOSE_MIN_BAND_BYTES
+// still fits the machine.
+//
+// Build and run from the repository root, e.g. on Linux:
+//   g++ -std=c++14 -O2 -pthread -Isrc/pyvcam tests/native/recompose_bench.cpp -o recompose_bench
+//   ./recompose_bench [width] [height] [roi_count] [roi_size]
+
+// Local
+#include "recompose.h"
+
+// System
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+
+using Clock = std::chrono::steady_clock;
+
+struct TestFrame
+{
+    std::vector<std::vector<uint8_t>> roiData;
+    std::vector<std::vector<uint16_t>> roiPixels; // Unpacked, for the reference
+    std::vector<RecomposeRoi> rois;
+};
+
+/** Packs pixels bit by bit, independently of the unpacking code. */
+static std::vector<uint8_t> Pack(const std::vector<uint16_t>& pixels, unsigned bits)
+{
+    std::vector<uint8_t> packed(BitPackPackedBytes(pixels.size(), bits), 0);
+    size_t bit = 0;
+    for (const uint16_t pixel : pixels)
+    {
+        for (unsigned b = 0; b < bits; b++, bit++)
+        {
+            if (pixel & (1u << b))
+                packed[bit / 8] |= (uint8_t)(1u << (bit % 8));
+        }
+    }
+    return packed;
+}
+
+static TestFrame MakeFrame(uint32_t width, uint32_t height, size_t roiCount,
+        uint32_t roiSize, unsigned bits, std::mt19937& rng)
+{
+    TestFrame frame;
+    std::uniform_int_distribution<uint32_t> xDist(0, width - 1);
+    std::uniform_int_distribution<uint32_t> yDist(0, height - 1);
+    std::uniform_int_distribution<uint32_t> sizeDist(1, roiSize);
+    std::uniform_int_distribution<uint32_t> pixelDist(0, (1u << ((bits) ? bits : 16)) - 1);
+    for (size_t n = 0; n < roiCount; n++)
+    {
+        RecomposeRoi roi;
+        roi.width = sizeDist(rng);
+        roi.height = sizeDist(rng);
+        // Some ROIs reach over the right or bottom border
+        roi.x = xDist(rng);
+        roi.y = yDist(rng);
+        std::vector<uint16_t> pixels((size_t)roi.width * roi.height);
+        for (uint16_t& pixel : pixels)
+            pixel = (uint16_t)pixelDist(rng);
+        if (bits)
+        {
+            frame.roiData.push_back(Pack(pixels, bits));
+        }
+        else
+        {
+            const auto* bytes = reinterpret_cast<const uint8_t*>(pixels.data());
+            frame.roiData.emplace_back(bytes, bytes + pixels.size() * sizeof(uint16_t));
+        }
+        frame.roiPixels.push_back(pixels);
+        frame.rois.push_back(roi);
+    }
+    for (size_t n = 0; n < roiCount; n++)
+    {
+        frame.rois[n].data = frame.roiData[n].data();
+        frame.rois[n].dataBytes = frame.roiData[n].size();
+    }
+    return frame;
+}
+
+static std::vector<uint16_t> Reference(const TestFrame& frame, uint32_t width,
+        uint32_t height, uint16_t fill)
+{
+    std::vector<uint16_t> canvas((size_t)width * height, fill);
+    for (size_t n = 0; n < frame.rois.size(); n++)
+    {
+        const RecomposeRoi& roi = frame.rois[n];
+        for (uint32_t y = 0; y < roi.height; y++)
+        {
+            for (uint32_t x = 0; x < roi.width; x++)
+            {
+                if (roi.x + x < width && roi.y + y < height)
+                {
+                    canvas[(size_t)(roi.y + y) * width + roi.x + x] =
+                        frame.roiPixels[n][(size_t)y * roi.width + x];
+                }
+            }
+        }
+    }
+    return canvas;
+}
+
+static RecomposeCanvas MakeCanvas(std::vector<uint16_t>& data, uint32_t width,
+        uint32_t height)
+{
+    RecomposeCanvas canvas;
+    canvas.data = data.data();
+    canvas.width = width;
+    canvas.height = height;
+    canvas.pixelBytes = sizeof(uint16_t);
+    canvas.rowStride = width * sizeof(uint16_t);
+    return canvas;
+}
+
+static bool Verify(uint32_t width, uint32_t height, size_t roiCount, uint32_t roiSize,
+        unsigned bits, std::mt19937& rng)
+{
+    const TestFrame frame = MakeFrame(width, height, roiCount, roiSize, bits, rng);
+    const uint16_t fill = 0xBEEF & ((1u << ((bits) ? bits : 16)) - 1);
+    for (const RecomposeRoi& roi : frame.rois)
+    {
+        if (!RecomposeRoiIsValid(roi, sizeof(uint16_t), bits))
+        {
+            printf("%u-bit: ROI data reported too small\n", bits);
+            return false;
+        }
+    }
+
+    const std::vector<uint16_t> expected = Reference(frame, width, height, fill);
+    auto Check = [&](const std::vector<uint16_t>& data, const char* name) {
+        for (size_t n = 0; n < data.size(); n++)
+        {
+            if (data[n] != expected[n])
+            {
+                printf("%s %u-bit %ux%u: mismatch at pixel %zu\n",
+                        name, bits, width, height, n);
+                return false;
+            }
+        }
+        return true;
+    };
+
+    std::vector<uint16_t> data((size_t)width * height, 0);
+    RecomposeFrame(MakeCanvas(data, width, height), frame.rois, bits, &fill);
+    if (!Check(data, "frame"))
+        return false;
+
+    // Band boundaries are covered also on machines with one CPU
+    constexpr uint32_t BANDS = 7;
+    std::fill(data.begin(), data.end(), (uint16_t)0);
+    const uint32_t bandRows = (height + BANDS - 1) / BANDS;
+    for (uint32_t y0 = 0; y0 < height; y0 += bandRows)
+    {
+        RecomposeBand(MakeCanvas(data, width, height), frame.rois, bits, &fill, y0,
+                (std::min)(y0 + bandRows, height));
+    }
+    return Check(data, "bands");
+}
+
+int main(int argc, char* argv[])
+{
+    const uint32_t width = (argc > 1) ? (uint32_t)atol(argv[1]) : 3200;
+    const uint32_t height = (argc > 2) ? (uint32_t)atol(argv[2]) : 3200;
+    const size_t roiCount = (argc > 3) ? (size_t)atol(argv[3]) : 512;
+    const uint32_t roiSize = (argc > 4) ? (uint32_t)atol(argv[4]) : 32;
+    constexpr int REPEATS = 20;
+
+    std::mt19937 rng(1);
+
+    bool ok = true;
+    for (const unsigned bits : { 0u, 10u, 12u })
+    {
+        ok &= Verify(61, 37, 40, 9, bits, rng); // Single thread
+        ok &= Verify(2048, 1024, roiCount, roiSize, bits, rng); // Multiple bands
+    }
+    printf("Verification %s\n\n", (ok) ? "passed" : "FAILED");
+
+    printf("%u CPUs, %zu ROIs per %ux%u canvas up to %ux%u, best of %d runs\n\n",
+            std::thread::hardware_concurrency(), roiCount, width, height, roiSize, roiSize,
+            REPEATS);
+    printf("%-7s %-11s %9s %15s %15s %15s %15s\n",
+            "pixels", "canvas", "serial", "2 threads", "4 threads", "8 threads", "auto");
+    constexpr unsigned THREAD_COUNTS[] = { 2, 4, 8 };
+    for (uint32_t scale = 1; width / scale >= 256 && height / scale >= 256; scale *= 2)
+    {
+        const uint32_t w = width / scale;
+        const uint32_t h = height / scale;
+        // Same ROI density for all sizes
+        const size_t count = (std::max)(roiCount / scale / scale, (size_t)1);
+        for (const unsigned bits : { 0u, 12u })
+        {
+            const TestFrame frame = MakeFrame(w, h, count, roiSize, bits, rng);
+            std::vector<uint16_t> data((size_t)w * h);
+            const RecomposeCanvas canvas = MakeCanvas(data, w, h);
+            const uint16_t fill = 0;
+
+            auto Measure = [&](unsigned threadCount) {
+                double bestUs = 1e30;
+                for (int r = 0; r < REPEATS; r++)
+                {
+                    const auto start = Clock::now();
+                    if (threadCount == 0)
+                        RecomposeFrame(canvas, frame.rois, bits, &fill);
+                    else
+                        RecomposeFrame(canvas, frame.rois, bits, &fill, threadCount);
+                    const auto end = Clock::now();
+                    bestUs = (std::min)(bestUs,
+                            std::chrono::duration<double, std::micro>(end - start).count());
+                }
+                return bestUs;
+            };
+
+            char size[32];
+            snprintf(size, sizeof(size), "%ux%u", w, h);
+            const double serialUs = Measure(1);
+            printf("%-7s %-11s %7.0fus", (bits) ? "12-bit" : "raw", size, serialUs);
+            for (const unsigned threadCount : THREAD_COUNTS)
+            {
+                const double us = Measure(threadCount);
+                printf(" %7.0fus %5.2fx", us, serialUs / us);
+            }
+            const double autoUs = Measure(0);
+            printf(" %7.0fus %5.2fx (%u)\n", autoUs, serialUs / autoUs,
+                    (std::max)(RecomposeThreadCount(canvas), 1u));
+        }
+    }
+
+    return (ok) ? 0 : 1;
+}
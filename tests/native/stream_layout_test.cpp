@@ -0,0 +1,209 @@
+// Test of the StreamFileLayout used by the pvc module to stream frames to disk.
+//
+// A fake acquisition fills frames into the buffer the way PVCAM does, each
+// frame with a byte unique to it. The segments returned by the layout are
+// "written" to an in-memory file right away, back to back from the data
+// offset, like the writer thread does. Then every index entry must point to
+// the data of its frame. Checked acquisitions:
+//  - a sequence filling its buffer once, stored without any padding, with
+//    exactly one index entry per frame,
+//  - a circular buffer over several laps, each lap padded to the same size,
+//  - a long sequence acquired in segments, the last one shorter,
+//  - a circular buffer with a frame not reported by the callback.
+//
+// Build and run from the repository root, e.g. on Linux:
+//   g++ -std=c++14 -O2 -pthread -Ipvcam-sdk/linux/include -Isrc/pyvcam
+//       tests/native/stream_layout_test.cpp -o stream_layout_test
+//   ./stream_layout_test
+
+// PVCAM
+#include <master.h>
+
+// Local
+#include "acq_buffer.h"
+#include "stream_file.h"
+
+// System
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+static constexpr uns32 PAGE_BYTES = (uns32)ALIGNMENT_BOUNDARY;
+// Not a multiple of the page, frames straddle page boundaries
+static constexpr uns32 FRAME_BYTES = 2 * PAGE_BYTES + 100;
+static constexpr uint64_t DATA_OFFSET = PAGE_BYTES; // Room for a file header
+
+static bool g_ok = true;
+
+static void Check(bool condition, const char* what)
+{
+    if (!condition)
+    {
+        printf("FAILED: %s\n", what);
+        g_ok = false;
+    }
+}
+
+static uint8_t FrameByte(uns32 frameNr)
+{
+    return (uint8_t)(frameNr * 7 + 1);
+}
+
+/** Fake acquisition streamed to an in-memory file. */
+struct FakeStream
+{
+    std::vector<uint8_t> buffer;
+    uns32 bufferFrames;
+    std::vector<uint8_t> file = std::vector<uint8_t>(DATA_OFFSET, 0);
+    StreamFileLayout layout{};
+
+    FakeStream(uns32 bufferFrames, bool bufferReused)
+        : buffer(AcqBuffer::PaddedSize((size_t)bufferFrames * FRAME_BYTES), 0),
+        bufferFrames(bufferFrames)
+    {
+        const size_t bufferBytes = (size_t)bufferFrames * FRAME_BYTES;
+        layout.Reset(DATA_OFFSET, (uns32)bufferBytes,
+                (uns32)AcqBuffer::PaddedSize(bufferBytes), FRAME_BYTES, bufferReused, 16);
+    }
+
+    void Write(const StreamSegment& segment)
+    {
+        Check(segment.offset % PAGE_BYTES == 0, "segment offset aligned");
+        Check(segment.bytes % PAGE_BYTES == 0, "segment size aligned");
+        Check(segment.offset + segment.bytes <= buffer.size(), "segment within buffer");
+        file.insert(file.end(), buffer.begin() + segment.offset,
+                buffer.begin() + segment.offset + segment.bytes);
+    }
+
+    /** PVCAM fills frame into given slot, the callback reports it if asked. */
+    void Acquire(uns32 frameNr, uns32 slot, bool report = true)
+    {
+        memset(buffer.data() + (size_t)slot * FRAME_BYTES, FrameByte(frameNr), FRAME_BYTES);
+        if (!report)
+            return;
+        uns32 availableBytes;
+        Write(layout.AddFrame(slot * FRAME_BYTES, frameNr, (long64)frameNr * 10,
+                    availableBytes));
+        Check(availableBytes >= FRAME_BYTES, "available bytes include the frame");
+    }
+
+    void Finish()
+    {
+        const StreamSegment segment = layout.GetFinalSegment();
+        if (segment.bytes > 0)
+            Write(segment);
+    }
+
+    /** Returns true if the frame data are found where the index entry points to. */
+    bool HoldsFrame(const StreamFileIndexEntry& entry) const
+    {
+        if (entry.offset + FRAME_BYTES > file.size())
+            return false;
+        for (uns32 n = 0; n < FRAME_BYTES; n++)
+            if (file[entry.offset + n] != FrameByte(entry.frameNr))
+                return false;
+        return true;
+    }
+
+    bool HoldsAllFrames() const
+    {
+        for (const StreamFileIndexEntry& entry : layout.GetIndex())
+            if (!HoldsFrame(entry))
+                return false;
+        return true;
+    }
+};
+
+static void TestSequence()
+{
+    constexpr uns32 FRAMES = 10;
+    FakeStream stream(FRAMES, false);
+    for (uns32 n = 0; n < FRAMES; n++)
+        stream.Acquire(n + 1, n);
+    stream.Finish();
+
+    const auto& index = stream.layout.GetIndex();
+    Check(index.size() == FRAMES, "sequence: one entry per frame");
+    bool backToBack = true;
+    bool metaOk = true;
+    for (uns32 n = 0; n < index.size(); n++)
+    {
+        backToBack &= index[n].offset == DATA_OFFSET + (uint64_t)n * FRAME_BYTES;
+        metaOk &= index[n].frameNr == n + 1 && index[n].timeStamp == (long64)(n + 1) * 10
+            && index[n].flags == 0;
+    }
+    Check(backToBack, "sequence: frames back to back without padding");
+    Check(metaOk, "sequence: frame numbers and timestamps");
+    const size_t dataBytes = ((size_t)FRAMES * FRAME_BYTES + PAGE_BYTES - 1)
+        / PAGE_BYTES * PAGE_BYTES;
+    Check(stream.file.size() == DATA_OFFSET + dataBytes,
+            "sequence: data end at the page after the last frame");
+    Check(stream.HoldsAllFrames(), "sequence: frame data intact");
+}
+
+static void TestCircular()
+{
+    constexpr uns32 SLOTS = 5;
+    constexpr uns32 LAPS = 4;
+    FakeStream stream(SLOTS, true);
+    for (uns32 n = 0; n < SLOTS * LAPS; n++)
+        stream.Acquire(n + 1, n % SLOTS);
+    stream.Finish();
+
+    const auto& index = stream.layout.GetIndex();
+    const uint64_t lapBytes = AcqBuffer::PaddedSize((size_t)SLOTS * FRAME_BYTES);
+    Check(index.size() == SLOTS * LAPS, "circular: one entry per frame");
+    bool lapsOk = true;
+    for (uns32 n = 0; n < index.size(); n++)
+    {
+        lapsOk &= index[n].offset
+            == DATA_OFFSET + (n / SLOTS) * lapBytes + (uint64_t)(n % SLOTS) * FRAME_BYTES;
+    }
+    Check(lapsOk, "circular: laps padded to the same size");
+    Check(stream.file.size() == DATA_OFFSET + LAPS * lapBytes, "circular: whole laps written");
+    Check(stream.HoldsAllFrames(), "circular: frame data intact");
+
+    stream.layout.MarkLastOverwritten();
+    Check(stream.layout.GetIndex().back().flags == STREAM_FRAME_FLAG_OVERWRITTEN,
+            "circular: overwritten flag set");
+}
+
+static void TestSegmentedSequence()
+{
+    constexpr uns32 SEGMENT_FRAMES = 4;
+    constexpr uns32 TOTAL = 3 * SEGMENT_FRAMES + 2; // The last segment is shorter
+    FakeStream stream(SEGMENT_FRAMES, true);
+    for (uns32 n = 0; n < TOTAL; n++)
+        stream.Acquire(n + 1, n % SEGMENT_FRAMES);
+    stream.Finish();
+
+    Check(stream.layout.GetIndex().size() == TOTAL, "segments: one entry per frame");
+    Check(stream.HoldsAllFrames(), "segments: frame data intact");
+}
+
+static void TestMissedCallback()
+{
+    constexpr uns32 SLOTS = 6;
+    constexpr uns32 LAPS = 3;
+    constexpr uns32 MISSED = 8; // Second lap, not first slot
+    FakeStream stream(SLOTS, true);
+    for (uns32 n = 0; n < SLOTS * LAPS; n++)
+        stream.Acquire(n + 1, n % SLOTS, n != MISSED);
+    stream.Finish();
+
+    Check(stream.layout.GetIndex().size() == SLOTS * LAPS - 1,
+            "missed: frame not reported has no entry");
+    Check(stream.HoldsAllFrames(), "missed: other frames intact");
+}
+
+int main()
+{
+    TestSequence();
+    TestCircular();
+    TestSegmentedSequence();
+    TestMissedCallback();
+    printf("%s\n", g_ok ? "All tests passed" : "Some tests FAILED");
+    return g_ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,172 @@
+// Test of the StreamWriter used by the pvc module to stream frames to disk.
+//
+// A pipe stands in for a slow disk, nothing reads from it until the writer
+// queue is full. Segments are handed over with TryQueue like the EOF callback
+// does, those rejected are kept and handed over later in order. Checked are
+// that TryQueue never waits, the backpressure counter matches the rejections,
+// the data arrive complete and in order, the written bytes are accounted and
+// that a failed write is reported while the queue still drains.
+//
+// Build and run from the repository root on Linux:
+//   g++ -std=c++14 -O2 -pthread -Ipvcam-sdk/linux/include -Isrc/pyvcam
+//       tests/native/stream_writer_test.cpp -o stream_writer_test
+//   ./stream_writer_test
+
+// PVCAM
+#include <master.h>
+
+// Local
+#include "acq_buffer.h"
+#include "stream_writer.h"
+
+// System
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <unistd.h> // pipe, read, close
+
+using Clock = std::chrono::steady_clock;
+
+static constexpr uns32 PAGE_BYTES = (uns32)ALIGNMENT_BOUNDARY;
+static constexpr uns32 SEGMENT_COUNT = 256;
+// Every other page, so no segment is contiguous with the previous one
+static constexpr uns32 BUFFER_PAGES = 2 * SEGMENT_COUNT;
+static constexpr auto MAX_TRY_QUEUE_TIME = std::chrono::milliseconds(20);
+
+static bool g_ok = true;
+
+static void Check(bool condition, const char* what)
+{
+    if (!condition)
+    {
+        printf("FAILED: %s\n", what);
+        g_ok = false;
+    }
+}
+
+static std::shared_ptr<AcqBuffer> NewFilledBuffer()
+{
+    auto acqBuffer = std::make_shared<AcqBuffer>((size_t)BUFFER_PAGES * PAGE_BYTES);
+    auto* bytes = static_cast<uint8_t*>(acqBuffer->data);
+    for (uns32 page = 0; page < BUFFER_PAGES; page++)
+        memset(bytes + (size_t)page * PAGE_BYTES, (int)(page & 0xFF), PAGE_BYTES);
+    return acqBuffer;
+}
+
+static StreamSegment GetSegment(uns32 n)
+{
+    return { 2 * n * PAGE_BYTES, PAGE_BYTES };
+}
+
+static void TestBackpressure()
+{
+    int fds[2];
+    if (pipe(fds) != 0)
+    {
+        Check(false, "backpressure: pipe created");
+        return;
+    }
+    auto acqBuffer = NewFilledBuffer();
+    StreamWriter writer;
+    Check(writer.Start(fds[1], acqBuffer, 0, false), "backpressure: writer started");
+    Check(strcmp(writer.GetBackend(), "write") == 0, "backpressure: write backend");
+
+    // Nothing reads the pipe, the writer gets stuck and the queue fills up
+    std::deque<StreamSegment> pending;
+    uint64_t rejected = 0;
+    auto maxTryQueueTime = Clock::duration::zero();
+    for (uns32 n = 0; n < SEGMENT_COUNT; n++)
+    {
+        pending.push_back(GetSegment(n));
+        while (!pending.empty())
+        {
+            const auto start = Clock::now();
+            const bool queued = writer.TryQueue(pending.front());
+            maxTryQueueTime = (std::max)(maxTryQueueTime, Clock::now() - start);
+            if (!queued)
+            {
+                rejected++;
+                break;
+            }
+            pending.pop_front();
+        }
+    }
+    Check(rejected > 0, "backpressure: queue got full");
+    Check(writer.GetQueueFullCount() == rejected, "backpressure: rejections counted");
+    Check(maxTryQueueTime < MAX_TRY_QUEUE_TIME, "backpressure: TryQueue never waits");
+    Check(writer.GetWrittenBytes() < (uint64_t)SEGMENT_COUNT * PAGE_BYTES,
+            "backpressure: stuck writer reports only written bytes");
+
+    // The disk catches up
+    std::vector<uint8_t> received;
+    std::thread reader([&received, fd = fds[0]]() {
+        uint8_t chunk[PAGE_BYTES];
+        ssize_t res;
+        while ((res = read(fd, chunk, sizeof(chunk))) > 0)
+            received.insert(received.end(), chunk, chunk + res);
+    });
+    for (const StreamSegment& segment : pending)
+        writer.Queue(segment);
+    writer.Stop();
+    close(fds[1]);
+    reader.join();
+    close(fds[0]);
+
+    Check(!writer.HasFailed(), "backpressure: no write error");
+    Check(writer.GetWrittenBytes() == (uint64_t)SEGMENT_COUNT * PAGE_BYTES,
+            "backpressure: all bytes accounted");
+    bool inOrder = received.size() == (size_t)SEGMENT_COUNT * PAGE_BYTES;
+    for (uns32 n = 0; inOrder && n < SEGMENT_COUNT; n++)
+    {
+        const uint8_t expected = (uint8_t)((2 * n) & 0xFF);
+        for (uns32 i = 0; i < PAGE_BYTES; i++)
+        {
+            if (received[(size_t)n * PAGE_BYTES + i] != expected)
+            {
+                inOrder = false;
+                break;
+            }
+        }
+    }
+    Check(inOrder, "backpressure: data complete and in order");
+}
+
+static void TestWriteError()
+{
+    int fds[2];
+    if (pipe(fds) != 0)
+    {
+        Check(false, "write error: pipe created");
+        return;
+    }
+    close(fds[0]); // Every write fails with EPIPE
+    auto acqBuffer = NewFilledBuffer();
+    StreamWriter writer;
+    Check(writer.Start(fds[1], acqBuffer, 0, false), "write error: writer started");
+    for (uns32 n = 0; n < SEGMENT_COUNT; n++)
+        writer.Queue(GetSegment(n));
+    writer.Stop();
+    close(fds[1]);
+
+    Check(writer.HasFailed(), "write error: failure reported");
+    Check(!writer.GetError().empty(), "write error: message set");
+    Check(writer.GetWrittenBytes() == (uint64_t)SEGMENT_COUNT * PAGE_BYTES,
+            "write error: queue drained");
+}
+
+int main()
+{
+    signal(SIGPIPE, SIG_IGN); // Let write fail with EPIPE instead
+    TestBackpressure();
+    TestWriteError();
+    printf("%s\n", g_ok ? "All tests passed" : "Some tests FAILED");
+    return g_ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,110 @@
+// Test of the TaskThread used by the pvc module to start sequence segments
+// outside of the PVCAM callback.
+//
+// The task stands in for a slow segment start. Checked are that signaling
+// never waits for the task, signals arriving before the task got to run are
+// merged into one run, Cancel waits for the running task and drops a pending
+// signal, and a stopped thread ignores signals.
+//
+// Build and run from the repository root, e.g. on Linux:
+//   g++ -std=c++14 -O2 -pthread -Isrc/pyvcam
+//       tests/native/task_thread_test.cpp -o task_thread_test
+//   ./task_thread_test
+
+// Local
+#include "task_thread.h"
+
+// System
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+using Clock = std::chrono::steady_clock;
+
+static constexpr auto TASK_TIME = std::chrono::milliseconds(50);
+static constexpr auto MAX_SIGNAL_TIME = std::chrono::milliseconds(20);
+
+static bool g_ok = true;
+
+static void Check(bool condition, const char* what)
+{
+    if (!condition)
+    {
+        printf("FAILED: %s\n", what);
+        g_ok = false;
+    }
+}
+
+static void WaitFor(const std::atomic<int>& value, int expected)
+{
+    const auto deadline = Clock::now() + std::chrono::seconds(5);
+    while (value.load() < expected && Clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+}
+
+static void TestSignal()
+{
+    std::atomic<int> started{ 0 };
+    std::atomic<int> finished{ 0 };
+    TaskThread thread;
+    Check(thread.Start([&]() {
+        started++;
+        std::this_thread::sleep_for(TASK_TIME);
+        finished++;
+    }), "signal: thread started");
+
+    Check(thread.Signal(), "signal: first signal accepted");
+    WaitFor(started, 1);
+
+    // The task runs, signals must not wait for it and get merged
+    auto maxSignalTime = Clock::duration::zero();
+    for (int n = 0; n < 100; n++)
+    {
+        const auto start = Clock::now();
+        thread.Signal();
+        maxSignalTime = (std::max)(maxSignalTime, Clock::now() - start);
+    }
+    Check(maxSignalTime < MAX_SIGNAL_TIME, "signal: never waits for the task");
+    WaitFor(finished, 2);
+    std::this_thread::sleep_for(2 * TASK_TIME);
+    Check(finished == 2, "signal: pending signals merged into one run");
+
+    thread.Stop();
+    Check(!thread.Signal(), "signal: stopped thread ignores signals");
+}
+
+static void TestCancel()
+{
+    std::atomic<int> started{ 0 };
+    std::atomic<int> finished{ 0 };
+    TaskThread thread;
+    Check(thread.Start([&]() {
+        started++;
+        std::this_thread::sleep_for(TASK_TIME);
+        finished++;
+    }), "cancel: thread started");
+
+    thread.Signal();
+    WaitFor(started, 1);
+    thread.Signal(); // Pending while the task runs
+    thread.Cancel();
+    Check(finished == 1, "cancel: waits for the running task");
+    std::this_thread::sleep_for(2 * TASK_TIME);
+    Check(started == 1, "cancel: pending signal dropped");
+
+    // The thread keeps running for next acquisition
+    Check(thread.Signal(), "cancel: signal accepted after cancel");
+    WaitFor(finished, 2);
+    Check(finished == 2, "cancel: task runs again");
+}
+
+int main()
+{
+    TestSignal();
+    TestCancel();
+    printf("%s\n", g_ok ? "All tests passed" : "Some tests FAILED");
+    return g_ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
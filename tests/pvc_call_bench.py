@@ -0,0 +1,64 @@
+"""Micro-benchmark of per-call overhead of the hot pvc module functions.
+
+Calls the pvc functions directly, without the Camera wrappers, in a tight loop
+and prints the best average time per call out of several rounds.
+The parameter type is read from the parameter cache, thus the get_param
+timing is dominated by argument conversion and the result construction.
+get_frame peeks at the latest frame of a running live acquisition with zero
+timeout, so it never waits for the camera.
+
+Run from the repository root with the package installed and a camera connected:
+  python tests/pvc_call_bench.py [calls_per_round]
+"""
+import sys
+import time
+
+from pyvcam import pvc
+from pyvcam.camera import Camera
+from pyvcam import constants as const
+
+ROUNDS = 5
+
+
+def bench(name, func, calls):
+    best_ns = None
+    for _ in range(ROUNDS):
+        start = time.perf_counter_ns()
+        for _ in range(calls):
+            func()
+        elapsed_ns = time.perf_counter_ns() - start
+        best_ns = elapsed_ns if best_ns is None else min(best_ns, elapsed_ns)
+    print(f'{name:<40} {best_ns / calls:10.1f} ns/call')
+
+
+def main():
+    calls = int(sys.argv[1]) if len(sys.argv) > 1 else 100000
+
+    pvc.init_pvcam()
+    cam = next(Camera.detect_camera())
+    cam.open()
+    try:
+        handle = cam.handle
+        exp_res = const.PARAM_EXP_RES
+
+        bench('get_param(ATTR_TYPE)',
+              lambda: pvc.get_param(handle, exp_res, const.ATTR_TYPE), calls)
+        bench('get_param(ATTR_CURRENT)',
+              lambda: pvc.get_param(handle, exp_res, const.ATTR_CURRENT), calls)
+
+        cam.start_live(exp_time=1)
+        try:
+            cam.poll_frame(timeout_ms=5000)  # Wait for the first frame
+            bench('check_frame_status()',
+                  lambda: pvc.check_frame_status(handle), calls)
+            bench('get_frame(timeoutMs=0, latest)',
+                  lambda: pvc.get_frame(handle, 0, False), calls)
+        finally:
+            cam.finish()
+    finally:
+        cam.close()
+        pvc.uninit_pvcam()
+
+
+if __name__ == '__main__':
+    main()
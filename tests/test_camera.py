@@ -1,5 +1,8 @@
+import threading
+import time
 import unittest
 
+import numpy as np
 from pyvcam import pvc
 from pyvcam.camera import Camera
 from pyvcam import constants as const
@@ -593,6 +596,311 @@ class CameraConstructionTests(unittest.TestCase):
             self.assertEqual(new_value, cur_value)
             self.assertEqual(new_value, self.test_cam.smart_stream_exp_params)
 
+    def test_get_acq_stats(self):
+        self.test_cam.open()
+        self.test_cam.start_live(exp_time=1, buffer_frame_count=4)
+        self.test_cam.poll_frame()
+        stats = self.test_cam.acq_stats
+        self.test_cam.finish()
+        self.assertGreaterEqual(stats['frames_received'], 1)
+        self.assertEqual(stats['queue_capacity'], 4)
+        self.assertLessEqual(stats['max_queue_depth'], stats['queue_capacity'])
+        self.assertEqual(stats['seq_rearm_count'], 0)
+
+    def test_poll_frames(self):
+        self.test_cam.open()
+        num_frames = 4
+        self.test_cam.start_seq(exp_time=1, num_frames=num_frames)
+        frames = {'frame_count': []}
+        received = 0
+        while received < num_frames:
+            frames, _ = self.test_cam.poll_frames(num_frames, timeout_ms=5000)
+            received += len(frames['frame_count'])
+        self.test_cam.finish()
+        self.assertEqual(received, num_frames)
+        pixel_data = frames['pixel_data']
+        self.assertEqual(pixel_data.ndim, 3)
+        self.assertEqual(len(pixel_data), len(frames['frame_nr']))
+        self.assertEqual(len(pixel_data), len(frames['timestamp']))
+
+    def test_pixel_type_from_setup(self):
+        self.test_cam.open()
+        self.test_cam.start_live(exp_time=1, buffer_frame_count=8)
+        try:
+            frame, _, _ = self.test_cam.poll_frame(timeout_ms=5000)
+            pixel_data = frame['pixel_data']
+            dtype = (pixel_data[0] if isinstance(pixel_data, list) else pixel_data).dtype
+            view, _, _ = self.test_cam.poll_frame_view(timeout_ms=5000)
+            self.assertEqual(view.buffers[0].dtype, dtype)
+            frames, _ = self.test_cam.poll_frames(1, timeout_ms=5000)
+            self.assertEqual(frames['pixel_data'].dtype, dtype)
+        finally:
+            self.test_cam.finish()
+        stack = self.test_cam.get_sequence(2, exp_time=1, timeout_ms=5000)
+        self.assertEqual(stack.dtype, dtype)
+
+    def test_get_sequence(self):
+        self.test_cam.open()
+        num_frames = 4
+        stack = self.test_cam.get_sequence(num_frames, exp_time=1, timeout_ms=5000)
+        self.assertEqual(stack.ndim, 3)
+        self.assertEqual(len(stack), num_frames)
+        self.assertEqual(self.test_cam.acq_stats['frames_received'], num_frames)
+        out = np.empty_like(stack)
+        stack = self.test_cam.get_sequence(num_frames, exp_time=1, timeout_ms=5000,
+                                           out=out)
+        self.assertIs(stack, out)
+        with self.assertRaises(ValueError):
+            self.test_cam.get_sequence(num_frames + 1, exp_time=1, out=out)
+
+    def test_get_vtm_sequence(self):
+        self.test_cam.open()
+        if const.VARIABLE_TIMED_MODE not in self.test_cam.exp_modes.values():
+            self.skipTest('Variable Timed Mode not supported')
+        self.test_cam.exp_mode = const.VARIABLE_TIMED_MODE
+        num_frames = 6
+        stack = self.test_cam.get_vtm_sequence([1, 2, 3], const.EXP_RES_ONE_MILLISEC,
+                                               num_frames, timeout_ms=5000)
+        self.assertEqual(len(stack), num_frames)
+        stats = self.test_cam.acq_stats
+        self.assertEqual(stats['frames_received'], num_frames)
+        self.assertEqual(stats['seq_rearm_count'], num_frames - 1)
+
+    def test_concurrent_get_frame_set_param(self):
+        self.test_cam.open()
+        frames_per_thread = 50
+        errors = []
+        stop = threading.Event()
+
+        def poll_frames():
+            try:
+                for _ in range(frames_per_thread):
+                    self.test_cam.poll_frame(timeout_ms=5000)
+            except Exception as ex:
+                errors.append(ex)
+
+        def set_params():
+            try:
+                while not stop.is_set():
+                    gain = self.test_cam.get_param(const.PARAM_GAIN_INDEX)
+                    self.test_cam.set_param(const.PARAM_GAIN_INDEX, gain)
+            except Exception as ex:
+                errors.append(ex)
+
+        pollers = [threading.Thread(target=poll_frames) for _ in range(3)]
+        setters = [threading.Thread(target=set_params) for _ in range(2)]
+        self.test_cam.start_live(exp_time=1)
+        try:
+            for thread in pollers + setters:
+                thread.start()
+            for thread in pollers:
+                thread.join()
+        finally:
+            stop.set()
+            for thread in setters:
+                thread.join()
+            self.test_cam.finish()
+        self.assertEqual(errors, [])
+
+    def test_poll_frame_view(self):
+        self.test_cam.open()
+        self.test_cam.metadata_enabled = True
+        self.test_cam.start_seq(exp_time=1, num_frames=1)
+        try:
+            view, _, frame_count = self.test_cam.poll_frame_view(timeout_ms=5000)
+        finally:
+            self.test_cam.finish()
+            self.test_cam.metadata_enabled = False
+        self.assertEqual(view.frame_count, frame_count)
+        self.assertFalse(view.metadata_decoded)
+        frame_header = view.frame_header
+        self.assertTrue(view.metadata_decoded)
+        self.assertIs(view.frame_header, frame_header)
+        self.assertEqual(len(view.pixel_data), len(view.roi_headers))
+
+    def test_poll_frame_no_copy_pinned(self):
+        self.test_cam.open()
+        self.test_cam.start_live(exp_time=1, buffer_frame_count=8, pin_frames=True)
+        try:
+            frame, _, _ = self.test_cam.poll_frame(timeout_ms=5000, copyData=False)
+            stats = self.test_cam.acq_stats
+            self.assertEqual(stats['pinned_frames'], 1)
+            self.assertEqual(stats['pinned_slots'], 1)
+            self.assertEqual(stats['forced_copies'], 0)
+            del frame
+            self.assertEqual(self.test_cam.acq_stats['pinned_slots'], 0)
+        finally:
+            self.test_cam.finish()
+
+    def test_poll_frame_view_pinned(self):
+        self.test_cam.open()
+        self.test_cam.start_live(exp_time=1, buffer_frame_count=8, pin_frames=True)
+        try:
+            view, _, _ = self.test_cam.poll_frame_view(timeout_ms=5000, pin=True)
+            self.assertTrue(view.pinned)
+            buf = view.buffers[0]
+            arr = np.asarray(buf)
+            self.assertEqual(arr.shape, buf.shape)
+            self.assertEqual(arr.dtype, buf.dtype)
+            self.assertEqual(memoryview(buf).nbytes, buf.nbytes)
+            self.assertEqual(buf.__dlpack_device__(), (1, 0))
+            self.assertTrue(np.array_equal(np.from_dlpack(buf), arr))
+            snapshot = arr.copy()
+            del view, arr
+            # Let the acquisition lap the buffer, the pinned frame gets copied out
+            # and must stay intact when exported again
+            for _ in range(16):
+                self.test_cam.poll_frame_view(timeout_ms=5000)
+            self.assertGreaterEqual(self.test_cam.acq_stats['forced_copies'], 1)
+            self.assertTrue(np.array_equal(np.asarray(buf), snapshot))
+        finally:
+            self.test_cam.finish()
+
+    def test_exported_frame_stays_in_slot(self):
+        self.test_cam.open()
+        self.test_cam.start_live(exp_time=1, buffer_frame_count=8, pin_frames=True)
+        try:
+            view, _, _ = self.test_cam.poll_frame_view(timeout_ms=5000, pin=True)
+            buf = view.buffers[0]
+            arr = np.asarray(buf)
+            snapshot = arr.copy()
+            del view
+            # Long enough for a full lap, the exported frame can't be copied out
+            # and PVCAM discards new frames once all slots are locked
+            time.sleep(0.5)
+            self.assertEqual(self.test_cam.acq_stats['forced_copies'], 0)
+            self.assertTrue(np.array_equal(arr, snapshot))
+            del arr, buf
+            time.sleep(0.5)
+            stats = self.test_cam.acq_stats
+            self.assertEqual(stats['pinned_slots'], 0)
+            self.assertGreater(stats['pin_dropped_frames'], 0)
+        finally:
+            self.test_cam.finish()
+
+    def test_pin_frames_needs_spare_slot(self):
+        self.test_cam.open()
+        with self.assertRaises(ValueError):
+            self.test_cam.start_live(exp_time=1, buffer_frame_count=1, pin_frames=True)
+
+    def test_recompose(self):
+        self.test_cam.open()
+        width, height = self.test_cam.sensor_size
+        self.test_cam.set_roi(0, 0, width // 2, height // 2)
+        self.test_cam.recompose = {'fill': 7}
+        self.test_cam.start_seq(exp_time=1, num_frames=1)
+        try:
+            frame, _, _ = self.test_cam.poll_frame(timeout_ms=5000)
+        finally:
+            self.test_cam.finish()
+            self.test_cam.recompose = None
+        canvas = frame['pixel_data']
+        self.assertEqual(canvas.shape, (height, width))
+        self.assertTrue((canvas[height // 2:, :] == 7).all())
+        self.assertTrue((canvas[:, width // 2:] == 7).all())
+        with self.assertRaises(ValueError):
+            self.test_cam.recompose = {'invalid': 0}
+
+    def test_param_cache(self):
+        self.test_cam.open()
+        self.assertFalse(self.test_cam.param_cache_enabled)
+        self.test_cam.param_cache_enabled = True
+        self.test_cam.get_param(const.PARAM_GAIN_INDEX, const.ATTR_MAX)
+        self.test_cam.get_param(const.PARAM_GAIN_INDEX, const.ATTR_MAX)
+        stats = self.test_cam.param_cache_stats
+        self.assertGreater(stats['hits'], 0)
+        self.test_cam.readout_port = self.test_cam.readout_port
+        self.assertEqual(self.test_cam.param_cache_stats['invalidations'],
+                         stats['invalidations'] + 1)
+        self.test_cam.param_cache_enabled = False
+        self.assertEqual(self.test_cam.param_cache_stats['entries'], 0)
+
+    def test_discover_capabilities(self):
+        self.test_cam.open()
+        port = self.test_cam.readout_port
+        capabilities = pvc.discover_capabilities(self.test_cam.handle)
+        self.assertEqual(capabilities['port_speed_gain_table'],
+                         self.test_cam.port_speed_gain_table)
+        self.assertEqual(capabilities['post_processing_table'],
+                         self.test_cam.post_processing_table)
+        self.assertEqual(self.test_cam.readout_port, port)
+
+    def test_get_params(self):
+        self.test_cam.open()
+        values = self.test_cam.get_params([(const.PARAM_SPDTAB_INDEX, const.ATTR_CURRENT),
+                                           (const.PARAM_SPDTAB_INDEX, const.ATTR_COUNT),
+                                           (0x7FFFFFFF, const.ATTR_CURRENT)])
+        self.assertEqual(values[0], self.test_cam.speed)
+        self.assertEqual(values[1],
+                         self.test_cam.get_param(const.PARAM_SPDTAB_INDEX, const.ATTR_COUNT))
+        self.assertIsInstance(values[2], Exception)
+
+    def test_batch_params(self):
+        self.test_cam.open()
+        speed = self.test_cam.speed
+        unknown_id = (const.TYPE_INT32 << 24) | 0xFFFF
+        with self.assertRaises(AttributeError):
+            with self.test_cam.batch_params() as results:
+                self.test_cam.speed = 0
+                self.test_cam.set_param(unknown_id, 0)
+                self.test_cam.speed = speed  # Moves the speed after unknown_id
+                self.assertEqual(list(results), [])  # Not set yet
+        self.assertEqual(list(results), [unknown_id, const.PARAM_SPDTAB_INDEX])
+        self.assertIsNone(results[const.PARAM_SPDTAB_INDEX])
+        self.assertIsInstance(results[unknown_id], AttributeError)
+
+    def test_acq_buffer_policy(self):
+        self.test_cam.open()
+        self.test_cam.acq_buffer_policy = {'prefault': 'touch'}
+        self.test_cam.start_seq(exp_time=1, num_frames=1)
+        self.test_cam.poll_frame()
+        policy = self.test_cam.acq_buffer_policy
+        self.test_cam.finish()
+        self.assertEqual(policy['prefault'], 'touch')
+        self.assertEqual(policy['buffer']['prefault'], 'touch')
+        with self.assertRaises(ValueError):
+            self.test_cam.acq_buffer_policy = {'hugepages': 'invalid'}
+
+    def test_acq_buffer_pool_reuse(self):
+        self.test_cam.open()
+        self.test_cam.start_seq(exp_time=1, num_frames=2)
+        self.test_cam.finish()
+        self.test_cam.reset_rois()
+        self.test_cam.set_roi(0, 0, 16, 16)
+        self.test_cam.start_seq(exp_time=1, num_frames=2)  # First buffer goes to pool
+        self.test_cam.finish()
+        self.test_cam.reset_rois()
+        hits = pvc.get_acq_buffer_pool_stats()['hits']
+        self.test_cam.start_seq(exp_time=1, num_frames=2)
+        self.test_cam.finish()
+        self.assertEqual(pvc.get_acq_buffer_pool_stats()['hits'], hits + 1)
+
+    def test_metadata_format(self):
+        self.test_cam.open()
+        self.assertEqual(self.test_cam.metadata_format, 'dict')
+        self.test_cam.metadata_format = 'numpy'
+        self.assertEqual(self.test_cam.metadata_format, 'numpy')
+        with self.assertRaises(ValueError):
+            self.test_cam.metadata_format = 'invalid'
+
+    def test_unpack_bits(self):
+        # 40 pixels cover both the SIMD kernels and the scalar tail
+        for bits in (9, 10, 11, 12, 13, 14, 15, 17, 18):
+            pixels = [(n * 2654435761) % (1 << bits) for n in range(40)]
+            packed = sum(p << (n * bits) for n, p in enumerate(pixels))
+            data = packed.to_bytes((len(pixels) * bits + 7) // 8, 'little')
+            unpacked = pvc.unpack_bits(data, bits, len(pixels))
+            self.assertEqual(unpacked.itemsize, 2 if bits <= 16 else 4)
+            self.assertEqual(unpacked.tolist(), pixels)
+        with self.assertRaises(NotImplementedError):
+            pvc.unpack_bits(bytes(2), 16, 1)
+        with self.assertRaises(RuntimeError):
+            pvc.unpack_bits(bytes(2), 12, 2)
+
+    def test_get_acq_stats_no_open_fail(self):
+        with self.assertRaises(KeyError):
+            _ = self.test_cam.acq_stats
+
 
 def main():
     unittest.main()
@@ -0,0 +1,144 @@
+import os
+import struct
+import tempfile
+import unittest
+
+import numpy as np
+from pyvcam import StreamFile
+
+
+PAGE_BYTES = 4096
+
+
+def pack_bits(pixels, bits):
+    """Packs pixels bit by bit, independently of the unpacking code."""
+    packed = bytearray((len(pixels) * bits + 7) // 8)
+    bit = 0
+    for pixel in pixels:
+        for b in range(bits):
+            if int(pixel) & (1 << b):
+                packed[bit // 8] |= 1 << (bit % 8)
+            bit += 1
+    return bytes(packed)
+
+
+def metadata_headers(data_size):
+    """Returns PVCAM metadata frame and ROI headers without extended metadata."""
+    frame_header = bytearray(StreamFile._MD_FRAME_HEADER_SIZE)
+    frame_header[StreamFile._MD_VERSION_OFFSET] = 3
+    roi_header = bytearray(StreamFile._MD_ROI_HEADER_SIZE)
+    struct.pack_into('<I', roi_header, StreamFile._MD_ROI_DATA_SIZE_OFFSET, data_size)
+    return bytes(frame_header + roi_header)
+
+
+class StreamFileTests(unittest.TestCase):
+    """Reads files written here with a synthetic header, no camera needed."""
+
+    WIDTH = 8
+    HEIGHT = 6
+
+    def setUp(self):
+        self.rng = np.random.default_rng(1)
+        fd, self.path = tempfile.mkstemp(suffix='.pvcstream')
+        os.close(fd)
+
+    def tearDown(self):
+        os.remove(self.path)
+
+    def write_file(self, frames, frame_bytes, dtype=b'<u2', bit_depth=16,
+                   metadata_enabled=False, image_compression=0, flags=None,
+                   finalized=True, magic=StreamFile.MAGIC):
+        """Writes frames back to back after one header page, the index trails them."""
+        roi = struct.pack('<6H', 0, self.WIDTH - 1, 1, 0, self.HEIGHT - 1, 1)
+        data = b''.join(frame.ljust(frame_bytes, b'\0') for frame in frames)
+        data_bytes = (len(data) + PAGE_BYTES - 1) // PAGE_BYTES * PAGE_BYTES
+        index_offset = PAGE_BYTES + data_bytes
+        flags = flags or [0] * len(frames)
+        index = b''.join(
+            struct.pack('<QIIq', PAGE_BYTES + n * frame_bytes, 100 + n, flags[n], 1000 * n)
+            for n in range(len(frames)))
+        header = struct.pack(
+            '<8sIIIIQQQQ8sHBBI', magic, 1, PAGE_BYTES, frame_bytes, len(frames),
+            len(data), data_bytes, index_offset if finalized else 0, len(frames),
+            dtype, bit_depth, metadata_enabled, image_compression, 1) + roi
+        with open(self.path, 'wb') as f:
+            f.write(header.ljust(PAGE_BYTES, b'\0'))
+            f.write(data.ljust(data_bytes, b'\0'))
+            f.write(index)
+
+    def random_frames(self, count, high=1 << 16):
+        return [self.rng.integers(0, high, (self.HEIGHT, self.WIDTH)).astype('<u2')
+                for _ in range(count)]
+
+    def test_raw_frames(self):
+        frames = self.random_frames(5)
+        # Odd frame size, frames are stored at any offset
+        frame_bytes = frames[0].nbytes + 6
+        self.write_file([f.tobytes() for f in frames], frame_bytes,
+                        flags=[0, 0, 1, 0, 0])
+        with StreamFile(self.path) as stream:
+            self.assertEqual(len(stream), 5)
+            self.assertEqual(stream.dtype, np.dtype('<u2'))
+            self.assertEqual(stream.frame_bytes, frame_bytes)
+            self.assertFalse(stream.metadata_enabled)
+            self.assertEqual(stream.rois, [{'s1': 0, 's2': self.WIDTH - 1, 'sbin': 1,
+                                            'p1': 0, 'p2': self.HEIGHT - 1, 'pbin': 1}])
+            self.assertEqual(list(stream.frame_nr), [100, 101, 102, 103, 104])
+            self.assertEqual(list(stream.timestamp), [0, 1000, 2000, 3000, 4000])
+            self.assertEqual(list(stream.overwritten), [False, False, True, False, False])
+            for n, frame in enumerate(stream):
+                self.assertTrue(np.array_equal(frame, frames[n]))
+            self.assertTrue(np.array_equal(stream[-1], frames[-1]))
+            self.assertEqual(len(stream.raw(1)), frame_bytes)
+
+    def test_metadata_frames(self):
+        frames = self.random_frames(3)
+        headers = metadata_headers(frames[0].nbytes)
+        self.write_file([headers + f.tobytes() for f in frames],
+                        len(headers) + frames[0].nbytes, metadata_enabled=True)
+        with StreamFile(self.path) as stream:
+            self.assertTrue(stream.metadata_enabled)
+            for n in range(len(frames)):
+                self.assertTrue(np.array_equal(stream[n], frames[n]))
+
+    def test_metadata_unexpected_roi_size(self):
+        frames = self.random_frames(1)
+        headers = metadata_headers(frames[0].nbytes - 2)
+        self.write_file([headers + frames[0].tobytes()], len(headers) + frames[0].nbytes,
+                        metadata_enabled=True)
+        with StreamFile(self.path) as stream:
+            with self.assertRaises(ValueError):
+                stream[0]
+
+    def test_bit_packed_frames(self):
+        bits = 12
+        frames = self.random_frames(3, 1 << bits)
+        packed = [pack_bits(f.ravel(), bits) for f in frames]
+        self.write_file(packed, len(packed[0]), bit_depth=bits, image_compression=bits)
+        with StreamFile(self.path) as stream:
+            self.assertEqual(stream.image_compression, bits)
+            for n in range(len(frames)):
+                frame = stream[n]
+                self.assertEqual(frame.shape, (self.HEIGHT, self.WIDTH))
+                self.assertTrue(np.array_equal(frame, frames[n]))
+
+    def test_not_finalized(self):
+        self.write_file([f.tobytes() for f in self.random_frames(2)], 96, finalized=False)
+        with self.assertRaises(ValueError):
+            StreamFile(self.path)
+
+    def test_invalid_signature(self):
+        self.write_file([f.tobytes() for f in self.random_frames(2)], 96, magic=b'NOTSTRM\0')
+        with self.assertRaises(ValueError):
+            StreamFile(self.path)
+
+    def test_truncated_index(self):
+        self.write_file([f.tobytes() for f in self.random_frames(4)], 96)
+        with open(self.path, 'r+b') as f:
+            f.truncate(os.path.getsize(self.path) - 1)
+        with self.assertRaises(ValueError):
+            StreamFile(self.path)
+
+
+if __name__ == '__main__':
+    unittest.main()